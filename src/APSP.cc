@@ -28,14 +28,16 @@ APSP::APSP() {
 }
 
 APSP::APSP(const APSP& src) :
-  std::vector<std::vector<Int> >(src) {
+  m_Cells(src.m_Cells),
+  m_vTrail(src.m_vTrail),
+  m_vSaved(src.m_vSaved),
+  m_vMarks(src.m_vMarks) {
 }
 
 APSP::~APSP() {
 }
 
 void APSP::initialize(size_t nRectangles) {
-  clear();
 
   /**
    * @TODO We can probably just avoid using infinity and set the
@@ -44,34 +46,39 @@ void APSP::initialize(size_t nRectangles) {
    * of negative values anyway.
    */
 
-  resize(nRectangles,
-	 std::vector<Int>(nRectangles, 
-			  std::numeric_limits<Int>::max()));
+  m_Cells.initialize(nRectangles, MinPlus::infinity());
   for(size_t i = 0; i < nRectangles; ++i)
-    (*this)[i][i] = 0;
+    m_Cells[i][i] = 0;
+  m_vTrail.clear();
+  m_vSaved.clear();
+  m_vMarks.clear();
 }
 
 void APSP::floydWarshall() {
   for(size_t k = 0; k < size(); ++k)
-    for(size_t i = 0; i < size(); ++i)
-      for(size_t j = 0; j < size(); ++j)
-	if(operator[](i)[k] < std::numeric_limits<Int>::max() &&
-	   operator[](k)[j] < std::numeric_limits<Int>::max())
-	  operator[](i)[j] =
-	    std::min(operator[](i)[j],
-		     operator[](i)[k] +
-		     operator[](k)[j]);
+    floydWarshall(k);
 }
 
 void APSP::floydWarshall(size_t k) {
-  for(size_t i = 0; i < size(); ++i)
-    for(size_t j = 0; j < size(); ++j)
-      if(operator[](i)[k] < std::numeric_limits<Int>::max() &&
-	 operator[](k)[j] < std::numeric_limits<Int>::max())
-	operator[](i)[j] =
-	  std::min(operator[](i)[j],
-		   operator[](i)[k] +
-		   operator[](k)[j]);
+  if(m_vMarks.empty()) {
+    m_Cells.floydWarshall(k);
+    return;
+  }
+  for(size_t i = 0; i < size(); ++i) {
+    Int nIK = operator[](i)[k];
+    if(!MinPlus::infinite(nIK))
+      relax(i, nIK, operator[](k));
+  }
+}
+
+void APSP::relax(size_t i, Int a, const Int* q) {
+  if(!m_vMarks.empty()) {
+    if(!MinPlus::improves(operator[](i), q, size(), a))
+      return;
+    m_vTrail.push_back(i);
+    m_vSaved.insert(m_vSaved.end(), operator[](i), operator[](i) + size());
+  }
+  m_Cells.relax(i, a, q);
 }
 
 bool APSP::negativeCycles() const {
@@ -81,62 +88,96 @@ bool APSP::negativeCycles() const {
   return(false);
 }
 
-void APSP::update(const Rectangle* r1,
+bool APSP::update(const Rectangle* r1,
 		  const Rectangle* r2, Int n) {
-  (*this)[r1->m_nID][r2->m_nID] =
-    std::min((*this)[r1->m_nID][r2->m_nID], n);
+  size_t u = r1->m_nID, v = r2->m_nID;
+  if(n >= operator[](u)[v])
+    return(true);
+
+  /**
+   * The matrix already holds shortest paths, so the new edge closes
+   * a negative cycle exactly when the path back from v to u is
+   * shorter than -n.
+   */
+
+  Int nVU = operator[](v)[u];
+  if(!MinPlus::infinite(nVU) && nVU + n < 0)
+    return(false);
+
+  /**
+   * Every path that improves must use the new edge, so d(i, j) is
+   * relaxed with d(i, u) + n + d(v, j). Neither of those two terms
+   * changes along the way, because that would need a negative cycle.
+   */
+
+  const Int* pV = operator[](v);
+  for(size_t i = 0; i < size(); ++i) {
+    Int nIU = operator[](i)[u];
+    if(!MinPlus::infinite(nIU))
+      relax(i, nIU + n, pV);
+  }
+  return(true);
 }
 
-void APSP::assign(const MetaVarDesc* pDesc, int nValue) {
+void APSP::mark() {
+  m_vMarks.push_back(m_vTrail.size());
+}
+
+void APSP::undo() {
+  size_t nMark = m_vMarks.back();
+  m_vMarks.pop_back();
+  while(m_vTrail.size() > nMark) {
+    std::copy(m_vSaved.end() - size(), m_vSaved.end(),
+	      operator[](m_vTrail.back()));
+    m_vSaved.resize(m_vSaved.size() - size());
+    m_vTrail.pop_back();
+  }
+}
+
+bool APSP::assign(const MetaVarDesc* pDesc, int nValue) {
   switch(nValue) {
   case MetaDomain::ABOVE:
-    update(pDesc->m_pRect1, pDesc->m_pRect2,
-	   - (Int) pDesc->m_pRect2->m_nHeight);
-    break;
+    return(update(pDesc->m_pRect1, pDesc->m_pRect2,
+		  - (Int) pDesc->m_pRect2->m_nHeight));
   case MetaDomain::RIGHTOF:
-    update(pDesc->m_pRect1, pDesc->m_pRect2,
-	   - (Int) pDesc->m_pRect2->m_nWidth);
-    break;
+    return(update(pDesc->m_pRect1, pDesc->m_pRect2,
+		  - (Int) pDesc->m_pRect2->m_nWidth));
   case MetaDomain::BELOW:
-    update(pDesc->m_pRect2, pDesc->m_pRect1,
-	   - (Int) pDesc->m_pRect1->m_nHeight);
-    break;
+    return(update(pDesc->m_pRect2, pDesc->m_pRect1,
+		  - (Int) pDesc->m_pRect1->m_nHeight));
   case MetaDomain::LEFTOF:
-    update(pDesc->m_pRect2, pDesc->m_pRect1,
-	   - (Int) pDesc->m_pRect1->m_nWidth);
-    break;
+    return(update(pDesc->m_pRect2, pDesc->m_pRect1,
+		  - (Int) pDesc->m_pRect1->m_nWidth));
   default:
     std::cout << "Oops, did you really mean to assign UNASSIGNED to the APSP matrix?"
 	      << std::endl;
     exit(0);
     break;
   };
+  return(false);
 }
 
-void APSP::negate(const MetaVarDesc* pDesc, int nValue) {
+bool APSP::negate(const MetaVarDesc* pDesc, int nValue) {
   switch(nValue) {
   case MetaDomain::ABOVE:
-    update(pDesc->m_pRect2, pDesc->m_pRect1,
-	   (Int) pDesc->m_pRect1->m_nHeight - 1);
-    break;
+    return(update(pDesc->m_pRect2, pDesc->m_pRect1,
+		  (Int) pDesc->m_pRect1->m_nHeight - 1));
   case MetaDomain::RIGHTOF:
-    update(pDesc->m_pRect2, pDesc->m_pRect1,
-	   (Int) pDesc->m_pRect1->m_nWidth - 1);
-    break;
+    return(update(pDesc->m_pRect2, pDesc->m_pRect1,
+		  (Int) pDesc->m_pRect1->m_nWidth - 1));
   case MetaDomain::BELOW:
-    update(pDesc->m_pRect1, pDesc->m_pRect2,
-	   (Int) pDesc->m_pRect2->m_nHeight - 1);
-    break;
+    return(update(pDesc->m_pRect1, pDesc->m_pRect2,
+		  (Int) pDesc->m_pRect2->m_nHeight - 1));
   case MetaDomain::LEFTOF: // Assert 1 right or on the same level as 2.
-    update(pDesc->m_pRect1, pDesc->m_pRect2,
-	   (Int) pDesc->m_pRect2->m_nWidth - 1);
-    break;
+    return(update(pDesc->m_pRect1, pDesc->m_pRect2,
+		  (Int) pDesc->m_pRect2->m_nWidth - 1));
   default:
     std::cout << "Oops, did you really mean to assign UNASSIGNED to the APSP matrix?"
 	      << std::endl;
     exit(0);
     break;
   };
+  return(false);
 }
 
 Int APSP::minWidth(const MetaVarDesc* pDesc) const {
@@ -180,7 +221,7 @@ std::ostream& operator<<(std::ostream& os, const APSP& rhs) {
   os << std::endl;
   for(size_t i = 0; i < rhs.size(); ++i) {
     os << std::setw(2) << i;
-    for(size_t j = 0; j < rhs[i].size(); ++j) {
+    for(size_t j = 0; j < rhs.size(); ++j) {
       if(rhs[i][j] == std::numeric_limits<Int>::max())
 	os << std::setw(v[j] + 1) << "inf";
       else
@@ -205,9 +246,9 @@ void APSP::columnWidths(std::vector<size_t>& v) const {
   v.clear();
   if(empty())
     return;
-  v.resize(front().size(), 0);
+  v.resize(size(), 0);
   for(size_t i = 0; i < size(); ++i)
-    for(size_t j = 0; j < operator[](i).size(); ++j)
+    for(size_t j = 0; j < size(); ++j)
       v[j] = std::max(v[j], width(operator[](i)[j]));
 }
 
@@ -20,6 +20,7 @@
 
 #include <iostream>
 #include <vector>
+#include "DistanceMatrix.h"
 #include "Integer.h"
 #include "MetaDomain.h"
 
@@ -27,7 +28,16 @@ class APSP;
 class MetaVarDesc;
 class Rectangle;
 
-class APSP : public std::vector<std::vector<Int> >{
+/**
+ * All pairs shortest paths matrix over the difference constraints
+ * between rectangle coordinates, stored in a DistanceMatrix.
+ * Assertions are propagated incrementally so the matrix always holds
+ * the shortest paths of the constraints asserted so far. Before a row
+ * is relaxed it is copied onto a trail so that the search can undo
+ * back to a mark instead of copying the matrix.
+ */
+
+class APSP {
   friend std::ostream& operator<<(std::ostream& os, const APSP& rhs);
 
  public:
@@ -35,8 +45,15 @@ class APSP : public std::vector<std::vector<Int> >{
   APSP(const APSP& src);
   virtual ~APSP();
   void initialize(size_t nRectangles);
-  void assign(const MetaVarDesc* pDesc, int nValue);
-  void negate(const MetaVarDesc* pDesc, int nValue);
+
+  /**
+   * Assert the disjunct or its negation. These return false if doing
+   * so creates a negative cycle, in which case the matrix is left
+   * unchanged.
+   */
+
+  bool assign(const MetaVarDesc* pDesc, int nValue);
+  bool negate(const MetaVarDesc* pDesc, int nValue);
   Int minWidth(const MetaVarDesc* pDesc) const;
   Int minHeight(const MetaVarDesc* pDesc) const;
 
@@ -60,10 +77,63 @@ class APSP : public std::vector<std::vector<Int> >{
    */
 
   bool negativeCycles() const;
-  void update(const Rectangle* r1, const Rectangle* r2, Int n);
+
+  /**
+   * Tightens the edge from r1 to r2 to at most n and updates all
+   * shortest paths through it in n^2 time.
+   *
+   * @return false if the edge would create a negative cycle.
+   */
+
+  bool update(const Rectangle* r1, const Rectangle* r2, Int n);
+
+  /**
+   * Marks the current state of the matrix, to which undo() will
+   * return. Cells changed while no mark is active are not recorded.
+   */
+
+  void mark();
+  void undo();
+
+  Int* operator[](size_t i) {
+    return(m_Cells[i]);
+  }
+
+  const Int* operator[](size_t i) const {
+    return(m_Cells[i]);
+  }
+
+  size_t size() const {
+    return(m_Cells.size());
+  }
+
+  bool empty() const {
+    return(m_Cells.empty());
+  }
+
   size_t width(const Int& n) const;
   void columnWidths(std::vector<size_t>& v) const;
   void print() const;
+
+ private:
+
+  /**
+   * Relaxes row i through the pivot distance a and the pivot row q,
+   * saving the row on the trail first if it is about to change.
+   */
+
+  void relax(size_t i, Int a, const Int* q);
+
+  DistanceMatrix<Int> m_Cells;
+
+  /**
+   * The trail holds the index of each saved row, and the saved cells
+   * are stored back to back in m_vSaved. A mark is a trail length.
+   */
+
+  std::vector<size_t> m_vTrail;
+  std::vector<Int> m_vSaved;
+  std::vector<size_t> m_vMarks;
 };
 
 std::ostream& operator<<(std::ostream& os, const APSP& rhs);
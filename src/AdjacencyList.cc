@@ -0,0 +1,91 @@
+/**
+ * Copyright (C) 2011 Eric Huang
+ *
+ * This file is part of rectpack.
+ *
+ * rectpack is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * rectpack is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with rectpack. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AdjacencyList.h"
+#include <vector>
+
+AdjacencyList::AdjacencyList() {
+}
+
+AdjacencyList::~AdjacencyList() {
+}
+
+void AdjacencyList::initialize(size_t n) {
+  m_Graph = Graph(n);
+}
+
+size_t AdjacencyList::size() const {
+  return(boost::num_vertices(m_Graph));
+}
+
+size_t AdjacencyList::addVertex() {
+  return(boost::add_vertex(m_Graph));
+}
+
+bool AdjacencyList::edge(size_t u, size_t v) const {
+  return(boost::edge(u, v, m_Graph).second);
+}
+
+void AdjacencyList::addEdge(size_t u, size_t v) {
+  if(u != v && !edge(u, v))
+    boost::add_edge(u, v, m_Graph);
+}
+
+void AdjacencyList::removeEdge(size_t u, size_t v) {
+  boost::remove_edge(u, v, m_Graph);
+}
+
+void AdjacencyList::clearVertex(size_t u) {
+  boost::clear_vertex(u, m_Graph);
+}
+
+size_t AdjacencyList::degree(size_t u) const {
+  return(boost::out_degree(u, m_Graph));
+}
+
+size_t AdjacencyList::first(size_t u) const {
+  boost::graph_traits<Graph>::adjacency_iterator vi, vi_end;
+  size_t nBest(size());
+  for(boost::tie(vi, vi_end) = boost::adjacent_vertices(u, m_Graph);
+      vi != vi_end; ++vi)
+    if(*vi < nBest)
+      nBest = *vi;
+  return(nBest);
+}
+
+size_t AdjacencyList::next(size_t u, size_t v) const {
+  boost::graph_traits<Graph>::adjacency_iterator vi, vi_end;
+  size_t nBest(size());
+  for(boost::tie(vi, vi_end) = boost::adjacent_vertices(u, m_Graph);
+      vi != vi_end; ++vi)
+    if(*vi > v && *vi < nBest)
+      nBest = *vi;
+  return(nBest);
+}
+
+void AdjacencyList::merge(size_t nOld, size_t nNew) {
+  std::vector<size_t> v;
+  boost::graph_traits<Graph>::adjacency_iterator vi, vi_end;
+  for(boost::tie(vi, vi_end) = boost::adjacent_vertices(nOld, m_Graph);
+      vi != vi_end; ++vi)
+    v.push_back(*vi);
+  boost::clear_vertex(nOld, m_Graph);
+  for(std::vector<size_t>::const_iterator i = v.begin(); i != v.end(); ++i)
+    addEdge(*i, nNew);
+}
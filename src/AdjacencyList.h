@@ -0,0 +1,56 @@
+/**
+ * Copyright (C) 2011 Eric Huang
+ *
+ * This file is part of rectpack.
+ *
+ * rectpack is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * rectpack is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with rectpack. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ADJACENCYLIST_H
+#define ADJACENCYLIST_H
+
+#include <boost/graph/adjacency_list.hpp>
+#include <cstddef>
+
+/**
+ * The same interface as AdjacencyMatrix on top of the Boost Graph
+ * Library adjacency list that the Perfect packer used originally. It
+ * is selected by building with DEFINES=-DADJACENCYLIST, and exists so
+ * that the two representations can be compared on the same search
+ * (neighbours are visited in increasing order by both).
+ */
+
+class AdjacencyList {
+ public:
+  AdjacencyList();
+  ~AdjacencyList();
+  void initialize(size_t n);
+  size_t size() const;
+  size_t addVertex();
+  bool edge(size_t u, size_t v) const;
+  void addEdge(size_t u, size_t v);
+  void removeEdge(size_t u, size_t v);
+  void clearVertex(size_t u);
+  size_t degree(size_t u) const;
+  size_t first(size_t u) const;
+  size_t next(size_t u, size_t v) const;
+  void merge(size_t nOld, size_t nNew);
+
+ private:
+  typedef boost::adjacency_list<boost::listS, boost::vecS,
+				boost::undirectedS> Graph;
+  Graph m_Graph;
+};
+
+#endif // ADJACENCYLIST_H
@@ -0,0 +1,140 @@
+/**
+ * Copyright (C) 2011 Eric Huang
+ *
+ * This file is part of rectpack.
+ *
+ * rectpack is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * rectpack is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with rectpack. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AdjacencyMatrix.h"
+#include <algorithm>
+
+AdjacencyMatrix::AdjacencyMatrix() :
+  m_nSize(0),
+  m_nWords(0) {
+}
+
+AdjacencyMatrix::~AdjacencyMatrix() {
+}
+
+void AdjacencyMatrix::initialize(size_t n) {
+  m_nSize = 0;
+  if(n > m_nWords * 64) {
+    m_nWords = (n + 63) / 64;
+    m_vBits.resize(m_nWords * m_nWords * 64);
+  }
+  std::fill(m_vBits.begin(), m_vBits.end(), 0);
+  m_nSize = n;
+}
+
+size_t AdjacencyMatrix::size() const {
+  return(m_nSize);
+}
+
+size_t AdjacencyMatrix::addVertex() {
+  if(m_nSize == m_nWords * 64)
+    reserve(std::max((size_t) 128, m_nSize * 2));
+  return(m_nSize++);
+}
+
+UInt* AdjacencyMatrix::row(size_t u) {
+  return(&m_vBits[u * m_nWords]);
+}
+
+const UInt* AdjacencyMatrix::row(size_t u) const {
+  return(&m_vBits[u * m_nWords]);
+}
+
+void AdjacencyMatrix::set(size_t u, size_t v) {
+  row(u)[v >> 6] |= (UInt) 1 << (v & 63);
+}
+
+void AdjacencyMatrix::reset(size_t u, size_t v) {
+  row(u)[v >> 6] &= ~((UInt) 1 << (v & 63));
+}
+
+bool AdjacencyMatrix::edge(size_t u, size_t v) const {
+  return((row(u)[v >> 6] >> (v & 63)) & 1);
+}
+
+void AdjacencyMatrix::addEdge(size_t u, size_t v) {
+  if(u == v) return;
+  set(u, v);
+  set(v, u);
+}
+
+void AdjacencyMatrix::removeEdge(size_t u, size_t v) {
+  reset(u, v);
+  reset(v, u);
+}
+
+void AdjacencyMatrix::clearVertex(size_t u) {
+  for(size_t v = first(u); v < m_nSize; v = next(u, v))
+    reset(v, u);
+  std::fill(row(u), row(u) + m_nWords, 0);
+}
+
+size_t AdjacencyMatrix::degree(size_t u) const {
+  size_t n(0);
+  const UInt* p = row(u);
+  for(size_t i = 0; i < m_nWords; ++i)
+    n += __builtin_popcountll(p[i]);
+  return(n);
+}
+
+size_t AdjacencyMatrix::first(size_t u) const {
+  const UInt* p = row(u);
+  for(size_t i = 0; i < m_nWords; ++i)
+    if(p[i])
+      return((i << 6) + __builtin_ctzll(p[i]));
+  return(m_nSize);
+}
+
+size_t AdjacencyMatrix::next(size_t u, size_t v) const {
+  ++v;
+  if(v >= m_nSize) return(m_nSize);
+  const UInt* p = row(u);
+  size_t i = v >> 6;
+  UInt w = p[i] & (~(UInt) 0 << (v & 63));
+  while(!w) {
+    if(++i == m_nWords) return(m_nSize);
+    w = p[i];
+  }
+  return((i << 6) + __builtin_ctzll(w));
+}
+
+void AdjacencyMatrix::merge(size_t nOld, size_t nNew) {
+  UInt* pOld = row(nOld);
+  UInt* pNew = row(nNew);
+  for(size_t i = 0; i < m_nWords; ++i)
+    pNew[i] |= pOld[i];
+  reset(nNew, nNew);
+  reset(nNew, nOld);
+  for(size_t v = first(nOld); v < m_nSize; v = next(nOld, v)) {
+    reset(v, nOld);
+    if(v != nNew)
+      set(v, nNew);
+  }
+  std::fill(pOld, pOld + m_nWords, 0);
+}
+
+void AdjacencyMatrix::reserve(size_t n) {
+  size_t nWords = (n + 63) / 64;
+  if(nWords <= m_nWords) return;
+  std::vector<UInt> v(nWords * nWords * 64, 0);
+  for(size_t u = 0; u < m_nSize; ++u)
+    std::copy(row(u), row(u) + m_nWords, &v[u * nWords]);
+  m_vBits.swap(v);
+  m_nWords = nWords;
+}
@@ -0,0 +1,103 @@
+/**
+ * Copyright (C) 2011 Eric Huang
+ *
+ * This file is part of rectpack.
+ *
+ * rectpack is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * rectpack is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with rectpack. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ADJACENCYMATRIX_H
+#define ADJACENCYMATRIX_H
+
+#include "Integer.h"
+#include <cstddef>
+#include <vector>
+
+/**
+ * An undirected graph over the components of the Perfect packer,
+ * stored as a dense symmetric bit matrix. Each vertex owns a row of
+ * 64-bit words, so edge queries are a single bit test, neighbours are
+ * enumerated a word at a time in increasing order, and merging one
+ * vertex into another is a row OR followed by a column fix-up for the
+ * neighbours of the old vertex. Self-loops are never stored.
+ *
+ * To enumerate every edge once, iterate over each vertex u and its
+ * neighbours after u:
+ *
+ *   for(UInt u = 0; u < g.size(); ++u)
+ *     for(UInt v = g.next(u, u); v < g.size(); v = g.next(u, v))
+ */
+
+class AdjacencyMatrix {
+ public:
+  AdjacencyMatrix();
+  ~AdjacencyMatrix();
+
+  /**
+   * Resets the graph to n vertices and no edges.
+   */
+
+  void initialize(size_t n);
+  size_t size() const;
+  size_t addVertex();
+  bool edge(size_t u, size_t v) const;
+  void addEdge(size_t u, size_t v);
+  void removeEdge(size_t u, size_t v);
+
+  /**
+   * Removes all edges incident to u.
+   */
+
+  void clearVertex(size_t u);
+  size_t degree(size_t u) const;
+
+  /**
+   * Returns the smallest neighbour of u, or size() if u is isolated.
+   */
+
+  size_t first(size_t u) const;
+
+  /**
+   * Returns the smallest neighbour of u that is strictly greater than
+   * v, or size() if there is none.
+   */
+
+  size_t next(size_t u, size_t v) const;
+
+  /**
+   * Makes every neighbour of nOld (other than nNew) adjacent to nNew,
+   * and then removes all edges incident to nOld.
+   */
+
+  void merge(size_t nOld, size_t nNew);
+
+ private:
+  UInt* row(size_t u);
+  const UInt* row(size_t u) const;
+  void set(size_t u, size_t v);
+  void reset(size_t u, size_t v);
+
+  /**
+   * Grows the number of words per row so that at least n vertices
+   * fit, preserving the current edges.
+   */
+
+  void reserve(size_t n);
+
+  size_t m_nSize;
+  size_t m_nWords;
+  std::vector<UInt> m_vBits;
+};
+
+#endif // ADJACENCYMATRIX_H
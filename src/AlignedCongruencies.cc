@@ -40,7 +40,7 @@ initialize(const AlignedComponentPtrs& aligned) {
     k->second.clear();
     for(std::set<Component*>::const_iterator j = i->second.begin();
 	j != i->second.end(); ++j)
-      k->second[(*j)->m_Dims].insert(*j);
+      k->second.insert(*j);
   }
 }
 
@@ -56,7 +56,7 @@ initialize(const AlignedComponents& aligned,
     k->second.clear();
     for(std::set<UInt>::const_iterator j = i->second.begin();
 	j != i->second.end(); ++j)
-      k->second[vComponents[*j]->m_Dims].insert(vComponents[*j]);
+      k->second.insert(vComponents[*j]);
   }
 }
 
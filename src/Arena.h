@@ -0,0 +1,94 @@
+/**
+ * Copyright (C) 2011 Eric Huang
+ *
+ * This file is part of rectpack.
+ *
+ * rectpack is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * rectpack is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with rectpack. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * A bump allocator for objects that are created and released in
+ * stack order during the search. Objects are carved out of
+ * fixed-size blocks that are never returned to the heap until the
+ * arena itself is destroyed, so releasing the most recent object is
+ * a matter of moving the top pointer. A recycled object is brought back to its initial state
+ * by calling its reset() function, which must leave any internal
+ * capacity in place so that reuse does not touch the heap either.
+ */
+
+template <typename T> class Arena;
+
+template <typename T>
+class Arena {
+
+ public:
+  Arena() :
+    m_nSize(0) {
+  }
+
+  ~Arena() {
+    for(typename std::vector<T*>::iterator i = m_vBlocks.begin();
+	i != m_vBlocks.end(); ++i)
+      delete[] *i;
+  }
+
+  /**
+   * Returns an object in its initial state.
+   */
+
+  T* allocate() {
+    if(m_nSize == m_vBlocks.size() * s_nBlock)
+      m_vBlocks.push_back(new T[s_nBlock]);
+    T* p = m_vBlocks[m_nSize / s_nBlock] + (m_nSize % s_nBlock);
+    ++m_nSize;
+    p->reset();
+    return(p);
+  }
+
+  /**
+   * Releases the most recently allocated object.
+   */
+
+  void pop() {
+    --m_nSize;
+  }
+
+  void clear() {
+    m_nSize = 0;
+  }
+
+  size_t size() const {
+    return(m_nSize);
+  }
+
+  size_t capacity() const {
+    return(m_vBlocks.size() * s_nBlock);
+  }
+
+ private:
+  Arena(const Arena&);
+  const Arena& operator=(const Arena&);
+
+  static const size_t s_nBlock = 256;
+  std::vector<T*> m_vBlocks;
+  size_t m_nSize;
+};
+
+#endif // ARENA_H
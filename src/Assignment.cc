@@ -33,3 +33,9 @@ Assignment::Assignment(Component* pComponent) :
 
 Assignment::~Assignment() {
 }
+
+void Assignment::reset(Component* pComponent) {
+  m_pComponent = pComponent;
+  m_vErased.clear();
+  m_vInserted.clear();
+}
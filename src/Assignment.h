@@ -30,6 +30,13 @@ class Assignment {
   Assignment();
   Assignment(Component* pComponent);
   ~Assignment();
+
+  /**
+   * Reuses this assignment for the given component, keeping the
+   * capacity of the corner arrays.
+   */
+
+  void reset(Component* pComponent);
   std::vector<EmptyCorner> m_vErased;
   std::vector<EmptyCorner> m_vInserted;
   Component* m_pComponent;
@@ -0,0 +1,73 @@
+/**
+ * Copyright (C) 2011 Eric Huang
+ *
+ * This file is part of rectpack.
+ *
+ * rectpack is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * rectpack is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with rectpack. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AssignmentStack.h"
+
+AssignmentStack::AssignmentStack() :
+  m_nSize(0) {
+}
+
+AssignmentStack::~AssignmentStack() {
+}
+
+void AssignmentStack::clear() {
+  m_nSize = 0;
+}
+
+void AssignmentStack::reserve(size_t n) {
+  m_vSlots.reserve(n);
+}
+
+bool AssignmentStack::empty() const {
+  return(m_nSize == 0);
+}
+
+size_t AssignmentStack::size() const {
+  return(m_nSize);
+}
+
+void AssignmentStack::push_back(Component* c) {
+  if(m_nSize == m_vSlots.size())
+    m_vSlots.push_back(Assignment());
+  m_vSlots[m_nSize++].reset(c);
+}
+
+void AssignmentStack::pop_back() {
+  --m_nSize;
+}
+
+Assignment& AssignmentStack::back() {
+  return(m_vSlots[m_nSize - 1]);
+}
+
+const Assignment& AssignmentStack::back() const {
+  return(m_vSlots[m_nSize - 1]);
+}
+
+const Assignment& AssignmentStack::operator[](size_t n) const {
+  return(m_vSlots[n]);
+}
+
+AssignmentStack::const_iterator AssignmentStack::begin() const {
+  return(m_vSlots.begin());
+}
+
+AssignmentStack::const_iterator AssignmentStack::end() const {
+  return(m_vSlots.begin() + m_nSize);
+}
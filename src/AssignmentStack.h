@@ -0,0 +1,66 @@
+/**
+ * Copyright (C) 2011 Eric Huang
+ *
+ * This file is part of rectpack.
+ *
+ * rectpack is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * rectpack is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with rectpack. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ASSIGNMENTSTACK_H
+#define ASSIGNMENTSTACK_H
+
+#include "Assignment.h"
+#include <vector>
+
+class Component;
+
+/**
+ * The undo stack of component assignments used by the Perfect
+ * packer. Popping an assignment does not destroy it: the slot, and
+ * the capacity of its erased and inserted corner arrays, are kept for
+ * the next push at the same depth. After the first descent to a given
+ * depth, pushing and popping assignments is therefore free of heap
+ * traffic.
+ */
+
+class AssignmentStack {
+ public:
+  typedef std::vector<Assignment>::const_iterator const_iterator;
+
+  AssignmentStack();
+  ~AssignmentStack();
+  void clear();
+  void reserve(size_t n);
+  bool empty() const;
+  size_t size() const;
+
+  /**
+   * Pushes a new assignment of the given component, with empty
+   * erased and inserted corner arrays.
+   */
+
+  void push_back(Component* c);
+  void pop_back();
+  Assignment& back();
+  const Assignment& back() const;
+  const Assignment& operator[](size_t n) const;
+  const_iterator begin() const;
+  const_iterator end() const;
+
+ private:
+  std::vector<Assignment> m_vSlots;
+  size_t m_nSize;
+};
+
+#endif // ASSIGNMENTSTACK_H
@@ -18,25 +18,25 @@
  */
 
 #include "BinomialCache.h"
+#include <algorithm>
 
-BinomialCache::BinomialCache() {
+BinomialCache::BinomialCache() :
+  m_nRows(0) {
+  grow(64);
 }
 
 BinomialCache::~BinomialCache() {
 }
 
-size_t BinomialCache::choose(size_t n, size_t k) {
-  iterator i = find(key_type(n, k));
-  if(i == end())
-    i = insert(value_type(key_type(n, k), chooseAux(n, k))).first;
-  return(i->second);
-}
-
-size_t BinomialCache::chooseAux(size_t n, size_t k) {
-  if(k > n) return 0;
-  if(k > n / 2) k = n - k; // faster
-  long double nAccumulator(1);
-  for(size_t i = 1; i <= k; ++i)
-    nAccumulator *= (n - k + i) / i;
-  return((size_t) (nAccumulator + 0.5)); // avoid rounding error
+void BinomialCache::grow(size_t nRows) {
+  nRows = std::max(nRows, 2 * m_nRows);
+  m_vTable.resize(nRows * (nRows + 1) / 2);
+  for(size_t n = m_nRows; n < nRows; ++n) {
+    UInt* pRow = &m_vTable[n * (n + 1) / 2];
+    pRow[0] = pRow[n] = 1;
+    const UInt* pPrev = pRow - n;
+    for(size_t k = 1; k < n; ++k)
+      pRow[k] = pPrev[k - 1] + pPrev[k];
+  }
+  m_nRows = nRows;
 }
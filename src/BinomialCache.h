@@ -20,15 +20,37 @@
 #ifndef BINOMIALCACHE_H
 #define BINOMIALCACHE_H
 
+#include "Integer.h"
 #include <cstddef>
-#include <map>
+#include <vector>
 
-class BinomialCache : public std::map<std::pair<size_t, size_t>, size_t> {
+/**
+ * Binomial coefficients from Pascal's triangle, stored row after row
+ * in one flat array so that row n starts at n * (n + 1) / 2. The
+ * first rows are built up front and more rows are appended the first
+ * time they are asked for. Entries beyond 64 bits wrap around.
+ */
+
+class BinomialCache {
  public:
   BinomialCache();
   ~BinomialCache();
-  size_t choose(size_t n, size_t k);
-  size_t chooseAux(size_t n, size_t k);
+  UInt choose(size_t n, size_t k) {
+    if(k > n) return(0);
+    if(n >= m_nRows) grow(n + 1);
+    return(m_vTable[n * (n + 1) / 2 + k]);
+  }
+
+ private:
+
+  /**
+   * Extends the triangle to at least nRows rows.
+   */
+
+  void grow(size_t nRows);
+
+  size_t m_nRows;
+  std::vector<UInt> m_vTable;
 };
 
 #endif // BINOMIALCACHE_H
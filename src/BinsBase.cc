@@ -19,8 +19,10 @@
 
 #include "BoxDimensions.h"
 #include "BinsBase.h"
+#include "BinsKernel.h"
 #include "Interval.h"
 #include "Parameters.h"
+#include "Probes.h"
 #include "RectPtrArray.h"
 #include <algorithm>
 #include <iomanip>
@@ -196,7 +198,7 @@ void BinsBase::popSimple(Int nSize, const Interval& i) {
     add(j, nSize, m_vWaste);
 }
 
-void BinsBase::decompress(const std::pair<const Rectangle*, Interval>& p) {
+void BinsBase::decompress(const std::pair<UInt, Interval>& p) {
 
   /**
    * Do uncompression. p.second is the old Interval, and
@@ -219,38 +221,41 @@ void BinsBase::decompress(const std::pair<const Rectangle*, Interval>& p) {
    * empty space (since we're reapplying the residue).
    */
 
-  for(Int j = p.second.m_nBegin; j < m_vDomain[p.first->m_nID].m_nBegin; ++j) {
-    add(j + p.first->m_nHeight, p.first->m_nWidth, m_vWaste);
-    m_vWaste[p.first->m_nWidth] -= p.first->m_nWidth; // Residue now consumes empty space.
+  UInt nWidth(m_vColumns.m_vWidth[p.first]);
+  UInt nHeight(m_vColumns.m_vHeight[p.first]);
+  for(Int j = p.second.m_nBegin; j < m_vDomain[p.first].m_nBegin; ++j) {
+    add(j + nHeight, nWidth, m_vWaste);
+    m_vWaste[nWidth] -= nWidth; // Residue now consumes empty space.
   }
-  for(Int j = m_vDomain[p.first->m_nID].m_nEnd; j < p.second.m_nEnd; ++j) {
-    add(j, p.first->m_nWidth, m_vWaste);
-    m_vWaste[p.first->m_nWidth] -= p.first->m_nWidth; // Residue now consumes empty space.
+  for(Int j = m_vDomain[p.first].m_nEnd; j < p.second.m_nEnd; ++j) {
+    add(j, nWidth, m_vWaste);
+    m_vWaste[nWidth] -= nWidth; // Residue now consumes empty space.
   }
 
   /**
    * Reset the domain size.
    */
 
-  m_vDomain[p.first->m_nID] = p.second;
+  m_vDomain[p.first] = p.second;
 }
 
 bool BinsBase::compress(const Rectangle* pJustPlaced, VectorStack<UInt>& v) {
-  m_vRectangles.push_back(pJustPlaced);
+  PROBE(PROBE_COMPRESS);
+  place(pJustPlaced);
   bool bContinue = true;
   while(bContinue) {
     bContinue = false;
-    UInt i(0);
+    size_t i(0);
     while(i < m_vRectangles.size()) {
-      Int nResult(adjustDomain(m_vRectangles[i], m_vDomain[m_vRectangles[i]->m_nID]));
+      UInt n(m_vRectangles[i]);
+      Int nResult(adjustDomain(n, m_vDomain[n]));
       if(nResult == 2) return(false);
       if(nResult == 1) {
 	bContinue = true;
-	if(v[m_vRectangles[i]->m_nID] < (UInt) pJustPlaced->m_nID)
-	  v.update(m_vRectangles[i]->m_nID, (UInt) pJustPlaced->m_nID);
+	if(v[n] < (UInt) pJustPlaced->m_nID)
+	  v.update(n, (UInt) pJustPlaced->m_nID);
       }
-      if(m_vDomain[m_vRectangles[i]->m_nID].m_nWidth ==
-	 (Int) m_vRectangles[i]->m_nHeight)
+      if(m_vDomain[n].m_nWidth == (Int) m_vColumns.m_vHeight[n])
 	m_vRectangles.remove(i);
       else ++i;
     }
@@ -259,17 +264,18 @@ bool BinsBase::compress(const Rectangle* pJustPlaced, VectorStack<UInt>& v) {
 }
 
 bool BinsBase::compress(const Rectangle* pJustPlaced) {
-  m_vRectangles.push_back(pJustPlaced);
+  PROBE(PROBE_COMPRESS);
+  place(pJustPlaced);
   bool bContinue = true;
   while(bContinue) {
     bContinue = false;
-    UInt i(0);
+    size_t i(0);
     while(i < m_vRectangles.size()) {
-      Int nResult(adjustDomain(m_vRectangles[i], m_vDomain[m_vRectangles[i]->m_nID]));
+      UInt n(m_vRectangles[i]);
+      Int nResult(adjustDomain(n, m_vDomain[n]));
       if(nResult == 2) return(false);
       if(nResult == 1) bContinue = true;
-      if(m_vDomain[m_vRectangles[i]->m_nID].m_nWidth ==
-	 (Int) m_vRectangles[i]->m_nHeight)
+      if(m_vDomain[n].m_nWidth == (Int) m_vColumns.m_vHeight[n])
 	m_vRectangles.remove(i);
       else ++i;
     }
@@ -279,19 +285,20 @@ bool BinsBase::compress(const Rectangle* pJustPlaced) {
 
 bool BinsBase::compress(const Rectangle* pJustPlaced,
 			std::deque<const Rectangle*>& v) {
+  PROBE(PROBE_COMPRESS);
   v.clear();
-  m_vRectangles.push_back(pJustPlaced);
+  place(pJustPlaced);
   bool bContinue = true;
   while(bContinue) {
     bContinue = false;
-    UInt i(0);
+    size_t i(0);
     while(i < m_vRectangles.size()) {
-      Int nResult(adjustDomain(m_vRectangles[i], m_vDomain[m_vRectangles[i]->m_nID]));
+      UInt n(m_vRectangles[i]);
+      Int nResult(adjustDomain(n, m_vDomain[n]));
       if(nResult == 2) return(false);
       if(nResult == 1) bContinue = true;
-      if(m_vDomain[m_vRectangles[i]->m_nID].m_nWidth ==
-	 (Int) m_vRectangles[i]->m_nHeight) {
-	v.push_back(m_vRectangles[i]);
+      if(m_vDomain[n].m_nWidth == (Int) m_vColumns.m_vHeight[n]) {
+	v.push_back(m_vColumns.m_vRects[n]);
 	m_vRectangles.remove(i);
       }
       else ++i;
@@ -301,17 +308,18 @@ bool BinsBase::compress(const Rectangle* pJustPlaced,
 }
 
 bool BinsBase::compress(std::deque<const Rectangle*>& v) {
+  PROBE(PROBE_COMPRESS);
   bool bContinue = true;
   while(bContinue) {
     bContinue = false;
-    UInt i(0);
+    size_t i(0);
     while(i < m_vRectangles.size()) {
-      Int nResult(adjustDomain(m_vRectangles[i], m_vDomain[m_vRectangles[i]->m_nID]));
+      UInt n(m_vRectangles[i]);
+      Int nResult(adjustDomain(n, m_vDomain[n]));
       if(nResult == 2) return(false);
       if(nResult == 1) bContinue = true;
-      if(m_vDomain[m_vRectangles[i]->m_nID].m_nWidth ==
-	 (Int) m_vRectangles[i]->m_nHeight) {
-	v.push_back(m_vRectangles[i]);
+      if(m_vDomain[n].m_nWidth == (Int) m_vColumns.m_vHeight[n]) {
+	v.push_back(m_vColumns.m_vRects[n]);
 	m_vRectangles.remove(i);
       }
       else ++i;
@@ -321,16 +329,17 @@ bool BinsBase::compress(std::deque<const Rectangle*>& v) {
 }
 
 bool BinsBase::compress() {
+  PROBE(PROBE_COMPRESS);
   bool bContinue = true;
   while(bContinue) {
     bContinue = false;
-    UInt i(0);
+    size_t i(0);
     while(i < m_vRectangles.size()) {
-      Int nResult(adjustDomain(m_vRectangles[i], m_vDomain[m_vRectangles[i]->m_nID]));
+      UInt n(m_vRectangles[i]);
+      Int nResult(adjustDomain(n, m_vDomain[n]));
       if(nResult == 2) return(false);
       if(nResult == 1) bContinue = true;
-      if(m_vDomain[m_vRectangles[i]->m_nID].m_nWidth ==
-	 (Int) m_vRectangles[i]->m_nHeight)
+      if(m_vDomain[n].m_nWidth == (Int) m_vColumns.m_vHeight[n])
 	m_vRectangles.remove(i);
       else ++i;
     }
@@ -346,39 +355,39 @@ Int BinsBase::domainSize(const Interval& i, UInt d1,
 
 Int BinsBase::domainSize(const Interval& i, UInt d1,
 			 UInt d2, Int& n) const {
-  Int n2;
-  for(n = i.m_nEnd - 1; n >= i.m_nBegin; --n)
-    if(operator[](n) < (Int) d2)
-      break;
-  ++n;
-  for(n2 = i.m_nBegin; n2 < i.m_nEnd; ++n2)
-    if(operator[](n2 + d1) < (Int) d2)
-      break;
+  if(i.m_nEnd <= i.m_nBegin) {
+    n = i.m_nEnd;
+    return(i.m_nBegin - i.m_nEnd + 1);
+  }
+  n = i.m_nBegin + BinsKernel::lastBelow(&operator[](i.m_nBegin),
+					 i.m_nEnd - i.m_nBegin, d2);
+  Int n2 = i.m_nBegin + BinsKernel::firstBelow(&operator[](i.m_nBegin + d1),
+					       i.m_nEnd - i.m_nBegin, d2);
   return(n2 - n + 1);
 }
 
-Int BinsBase::adjustDomain(const Rectangle* r, Interval& iOld) {
+Int BinsBase::adjustDomain(UInt n, Interval& iOld) {
   if(!m_bPropagation) return(0);
   if(iOld.m_nEnd == iOld.m_nBegin) return(0);
 
-  Interval iNew(iOld.m_nEnd - 1, iOld.m_nBegin);
-  while(iNew.m_nBegin >= iOld.m_nBegin)
-    if(operator[](iNew.m_nBegin) < (Int) r->m_nWidth) break;
-    else --iNew.m_nBegin;
-  ++iNew.m_nBegin;
-  while(iNew.m_nEnd < iOld.m_nEnd)
-    if(operator[](iNew.m_nEnd + (Int) r->m_nHeight) < (Int) r->m_nWidth) break;
-    else ++iNew.m_nEnd;
+  UInt nWidth(m_vColumns.m_vWidth[n]), nHeight(m_vColumns.m_vHeight[n]);
+  Interval iNew;
+  iNew.m_nBegin = iOld.m_nBegin +
+    BinsKernel::lastBelow(&operator[](iOld.m_nBegin),
+			  iOld.m_nEnd - iOld.m_nBegin, nWidth);
+  iNew.m_nEnd = iOld.m_nBegin +
+    BinsKernel::firstBelow(&operator[](iOld.m_nBegin + nHeight),
+			   iOld.m_nEnd - iOld.m_nBegin, nWidth);
   if(iNew.m_nBegin > iNew.m_nEnd) return(2);
-  iNew.m_nWidth = r->m_nHeight + iNew.m_nBegin - iNew.m_nEnd;
+  iNew.m_nWidth = nHeight + iNew.m_nBegin - iNew.m_nEnd;
   if(iNew.m_nWidth == iOld.m_nWidth) return(0);
 
   /**
    * Add the new strips and push onto our stack the previous values.
    */
 
-  addStripsy(r, iOld, iNew);
-  m_vStack.push_back(std::pair<const Rectangle*, Interval>(r, iOld));
+  addStripsy(n, iOld, iNew);
+  m_vStack.push_back(std::pair<UInt, Interval>(n, iOld));
   iOld = iNew;
   return(1);
 }
@@ -408,6 +417,7 @@ void BinsBase::clear() {
   m_vWaste.clear();
   m_vDomain.clear();
   m_vRectangles.clear();
+  m_vColumns.clear();
   m_vPlaced.reset();
 #ifdef DEBUG
   m_vDebugStack.clear();
@@ -433,11 +443,12 @@ void BinsBase::resizey(const BoxDimensions& b, const RectPtrArray& v) {
   std::vector<Int>::resize(b.m_nHeight, b.m_nWidth);
   m_vWaste.resize(b.m_nWidth + 1, 0);
   m_vWaste.back() = b.m_nArea;
-  for(RectPtrArray::const_iterator i = v.begin(); i != v.end(); ++i) {
-    if((*i)->m_bRotatable)
-      m_vWaste[(*i)->m_nMinDim] -= (*i)->m_nArea;
+  m_vColumns.initialize(v);
+  for(UInt n = 0; n < m_vColumns.size(); ++n) {
+    if(m_vColumns.m_vRotatable[n])
+      m_vWaste[m_vColumns.m_vMinDim[n]] -= m_vColumns.m_vArea[n];
     else
-      m_vWaste[(*i)->m_nWidth] -= (*i)->m_nArea;
+      m_vWaste[m_vColumns.m_vWidth[n]] -= m_vColumns.m_vArea[n];
   }
   m_vDomain.resize(v.size());
   m_vRectangles.reserve(v.size());
@@ -454,15 +465,13 @@ bool BinsBase::operator==(const BinsBase& rhs) const {
 }
 
 bool BinsBase::canFit(UInt nSize, const Interval& i) const {
-  for(Int j = i.m_nEnd; j < i.m_nEnd + i.m_nWidth; ++j)
-    if(operator[](j) < (Int) nSize) return(false);
-  return(true);
+  if(i.m_nWidth <= 0) return(true);
+  return(BinsKernel::atLeast(&operator[](i.m_nEnd), i.m_nWidth, nSize));
 }
 
 bool BinsBase::canFit(UInt nSize, UInt i, UInt j) const {
-  for(; i < j; ++i)
-    if(operator[](i) < (Int) nSize) return(false);
-  return(true);
+  if(j <= i) return(true);
+  return(BinsKernel::atLeast(&operator[](i), j - i, nSize));
 }
 
 bool BinsBase::canFitx(const Rectangle* r) const {
@@ -476,12 +485,9 @@ bool BinsBase::canFity(const Rectangle* r) const {
 bool BinsBase::canFitStrips(const Rectangle* r) const {
   if(m_bPropagation) return(true);
 
-  for(Int j = r->y; j < r->yi.m_nEnd; ++j)
-    if(operator[](j) < (Int) r->m_nWidth) return(false);
-  for(Int j = r->yi.m_nEnd + r->yi.m_nWidth;
-      j < (Int) (r->yi.m_nEnd + r->m_nWidth); ++j)
-    if(operator[](j) < (Int) r->m_nWidth) return(false);
-  return(true);
+  return(canFit(r->m_nWidth, r->y, r->yi.m_nEnd) &&
+	 canFit(r->m_nWidth, r->yi.m_nEnd + r->yi.m_nWidth,
+		r->yi.m_nEnd + r->m_nWidth));
 }
 
 bool BinsBase::verifyBins(const BoxDimensions& b) const {
@@ -513,8 +519,9 @@ void BinsBase::pushStripsy(const Rectangle* r) {
    * save our stack.
    */
 
+  m_vColumns.update(r);
   m_vRectangles.push();
-  UInt t = m_vRectangles.find(r);
+  size_t t = m_vRectangles.find(r->m_nID);
   if(t < m_vRectangles.size())
     m_vRectangles.remove(t);
   m_vStackSize.push_back(m_vStack.size());
@@ -526,13 +533,13 @@ void BinsBase::pushStripsy(const Rectangle* r) {
    */
 
   Interval i(r->y, r->y, r->m_nHeight);
-  addStripsy(r, m_vDomain[r->m_nID], i);
+  addStripsy(r->m_nID, m_vDomain[r->m_nID], i);
 
   /**
    * Save the old domain value, and assert the new one (single value).
    */
 
-  m_vStack.push_back(std::pair<const Rectangle*, Interval>(r, m_vDomain[r->m_nID]));
+  m_vStack.push_back(std::pair<UInt, Interval>(r->m_nID, m_vDomain[r->m_nID]));
   m_vDomain[r->m_nID] = i;
 }
 
@@ -20,8 +20,10 @@
 #ifndef BINSBASE_H
 #define BINSBASE_H
 
+#include "BinsKernel.h"
 #include "FastRemove.h"
 #include "Integer.h"
+#include "RectColumns.h"
 #include "Rectangle.h"
 #include "VectorStack.h"
 #include "WastedBins.h"
@@ -141,7 +143,7 @@ class BinsBase : public std::vector<Int> {
   bool compress(const Rectangle* pJustPlaced);
   bool compress(const Rectangle* pJustPlaced, VectorStack<UInt>& v);
   bool compress(const Rectangle* pJustPlaced, std::deque<const Rectangle*>& v);
-  void decompress(const std::pair<const Rectangle*, Interval>& p);
+  void decompress(const std::pair<UInt, Interval>& p);
   bool yiValid(const RectPtrArray::iterator iBegin,
 	       const RectPtrArray::const_iterator& iEnd) const;
   bool xiValid(const RectPtrArray::iterator iBegin,
@@ -177,7 +179,7 @@ class BinsBase : public std::vector<Int> {
    * should backtrack due to a conflict in the constraInt propagation.
    */
 
-  Int adjustDomain(const Rectangle* r, Interval& iOld);
+  Int adjustDomain(UInt n, Interval& iOld);
   bool operator==(const BinsBase& rhs) const;
   void print() const;
 
@@ -190,8 +192,15 @@ class BinsBase : public std::vector<Int> {
 
   WastedBins m_vWaste;
   std::vector<Interval> m_vDomain;
-  FastRemove<const Rectangle*> m_vRectangles;
-  std::vector<std::pair<const Rectangle*, Interval> > m_vStack;
+
+  /**
+   * The rectangles whose intervals may still be compressed, and the
+   * previous intervals of compressed rectangles, both by ID. Their
+   * dimensions are read from m_vColumns.
+   */
+
+  FastRemove<UInt> m_vRectangles;
+  std::vector<std::pair<UInt, Interval> > m_vStack;
   std::vector<UInt> m_vStackSize;
 
   /**
@@ -210,6 +219,18 @@ class BinsBase : public std::vector<Int> {
 
   boost::dynamic_bitset<> m_vPlaced;
 
+  /**
+   * Adds a rectangle that has just been placed to the set of
+   * rectangles to compress, refreshing its row of m_vColumns.
+   */
+
+  void place(const Rectangle* r) {
+    m_vColumns.update(r);
+    m_vRectangles.push_back(r->m_nID);
+  }
+
+  RectColumns m_vColumns;
+
  public:
 
   void add(Int j, UInt nSize, std::vector<Int>& v) {
@@ -225,15 +246,15 @@ class BinsBase : public std::vector<Int> {
   }
 
  private:
-  void addStripsy(const Rectangle* r, const Interval& iOld,
-		  const Interval& iNew) {
+  void addStripsy(UInt n, const Interval& iOld, const Interval& iNew) {
+    UInt nWidth(m_vColumns.m_vWidth[n]), nHeight(m_vColumns.m_vHeight[n]);
     for(Int j = iNew.m_nEnd; j < iOld.m_nEnd; ++j) {
-      m_vWaste[r->m_nWidth] += r->m_nWidth; // Add back in the residue.
-      sub(j, r->m_nWidth, m_vWaste);
+      m_vWaste[nWidth] += nWidth; // Add back in the residue.
+      sub(j, nWidth, m_vWaste);
     }
     for(Int j = iOld.m_nBegin; j < iNew.m_nBegin; ++j) {
-      m_vWaste[r->m_nWidth] += r->m_nWidth; // Add back in the residue.
-      sub(j + r->m_nHeight, r->m_nWidth, m_vWaste);
+      m_vWaste[nWidth] += nWidth; // Add back in the residue.
+      sub(j + nHeight, nWidth, m_vWaste);
     }
   }
 
@@ -248,13 +269,11 @@ class BinsBase : public std::vector<Int> {
   };
 
   void pushSimple(UInt i, UInt j, UInt k) {
-    for(UInt l = i; l < j; ++l)
-      operator[](l) += k;
+    if(i < j) BinsKernel::add(&operator[](i), j - i, k);
   };
 
   void popSimple(UInt i, UInt j, UInt k) {
-    for(UInt l = i; l < j; ++l)
-      operator[](l) += k;
+    if(i < j) BinsKernel::add(&operator[](i), j - i, k);
   };
 
   bool m_bPropagation;
@@ -0,0 +1,194 @@
+/**
+ * Copyright (C) 2011 Eric Huang
+ *
+ * This file is part of rectpack.
+ *
+ * rectpack is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * rectpack is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with rectpack. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BinsKernel.h"
+#include <immintrin.h>
+
+/**
+ * Scalar implementations.
+ */
+
+static bool atLeastScalar(const Int* p, size_t n, Int nMin) {
+  for(size_t i = 0; i < n; ++i)
+    if(p[i] < nMin) return(false);
+  return(true);
+}
+
+static size_t firstBelowScalar(const Int* p, size_t n, Int nMin) {
+  for(size_t i = 0; i < n; ++i)
+    if(p[i] < nMin) return(i);
+  return(n);
+}
+
+static size_t lastBelowScalar(const Int* p, size_t n, Int nMin) {
+  while(n > 0)
+    if(p[--n] < nMin) return(n + 1);
+  return(0);
+}
+
+static void addScalar(Int* p, size_t n, Int k) {
+  for(size_t i = 0; i < n; ++i)
+    p[i] += k;
+}
+
+/**
+ * SSE4.2 implementations, two 64-bit lanes at a time (the signed
+ * 64-bit comparison first appeared in SSE4.2).
+ */
+
+__attribute__((target("sse4.2")))
+static bool atLeastSSE(const Int* p, size_t n, Int nMin) {
+  const __m128i vMin = _mm_set1_epi64x(nMin);
+  size_t i = 0;
+  for(; i + 2 <= n; i += 2) {
+    __m128i v = _mm_loadu_si128((const __m128i*) (p + i));
+    if(_mm_movemask_epi8(_mm_cmpgt_epi64(vMin, v))) return(false);
+  }
+  return(atLeastScalar(p + i, n - i, nMin));
+}
+
+__attribute__((target("sse4.2")))
+static size_t firstBelowSSE(const Int* p, size_t n, Int nMin) {
+  const __m128i vMin = _mm_set1_epi64x(nMin);
+  size_t i = 0;
+  for(; i + 2 <= n; i += 2) {
+    __m128i v = _mm_loadu_si128((const __m128i*) (p + i));
+    int nMask = _mm_movemask_pd(_mm_castsi128_pd(_mm_cmpgt_epi64(vMin, v)));
+    if(nMask) return(i + __builtin_ctz(nMask));
+  }
+  return(i + firstBelowScalar(p + i, n - i, nMin));
+}
+
+__attribute__((target("sse4.2")))
+static size_t lastBelowSSE(const Int* p, size_t n, Int nMin) {
+  const __m128i vMin = _mm_set1_epi64x(nMin);
+  while(n >= 2) {
+    n -= 2;
+    __m128i v = _mm_loadu_si128((const __m128i*) (p + n));
+    int nMask = _mm_movemask_pd(_mm_castsi128_pd(_mm_cmpgt_epi64(vMin, v)));
+    if(nMask) return(n + 32 - __builtin_clz(nMask));
+  }
+  return(lastBelowScalar(p, n, nMin));
+}
+
+__attribute__((target("sse4.2")))
+static void addSSE(Int* p, size_t n, Int k) {
+  const __m128i vK = _mm_set1_epi64x(k);
+  size_t i = 0;
+  for(; i + 2 <= n; i += 2) {
+    __m128i v = _mm_loadu_si128((const __m128i*) (p + i));
+    _mm_storeu_si128((__m128i*) (p + i), _mm_add_epi64(v, vK));
+  }
+  addScalar(p + i, n - i, k);
+}
+
+/**
+ * AVX2 implementations, four 64-bit lanes at a time. The tails are
+ * handed to the SSE versions.
+ */
+
+__attribute__((target("avx2")))
+static bool atLeastAVX2(const Int* p, size_t n, Int nMin) {
+  const __m256i vMin = _mm256_set1_epi64x(nMin);
+  size_t i = 0;
+  for(; i + 4 <= n; i += 4) {
+    __m256i v = _mm256_loadu_si256((const __m256i*) (p + i));
+    if(_mm256_movemask_epi8(_mm256_cmpgt_epi64(vMin, v))) return(false);
+  }
+  return(atLeastSSE(p + i, n - i, nMin));
+}
+
+__attribute__((target("avx2")))
+static size_t firstBelowAVX2(const Int* p, size_t n, Int nMin) {
+  const __m256i vMin = _mm256_set1_epi64x(nMin);
+  size_t i = 0;
+  for(; i + 4 <= n; i += 4) {
+    __m256i v = _mm256_loadu_si256((const __m256i*) (p + i));
+    int nMask = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(vMin, v)));
+    if(nMask) return(i + __builtin_ctz(nMask));
+  }
+  return(i + firstBelowSSE(p + i, n - i, nMin));
+}
+
+__attribute__((target("avx2")))
+static size_t lastBelowAVX2(const Int* p, size_t n, Int nMin) {
+  const __m256i vMin = _mm256_set1_epi64x(nMin);
+  while(n >= 4) {
+    n -= 4;
+    __m256i v = _mm256_loadu_si256((const __m256i*) (p + n));
+    int nMask = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(vMin, v)));
+    if(nMask) return(n + 32 - __builtin_clz(nMask));
+  }
+  return(lastBelowSSE(p, n, nMin));
+}
+
+__attribute__((target("avx2")))
+static void addAVX2(Int* p, size_t n, Int k) {
+  const __m256i vK = _mm256_set1_epi64x(k);
+  size_t i = 0;
+  for(; i + 4 <= n; i += 4) {
+    __m256i v = _mm256_loadu_si256((const __m256i*) (p + i));
+    _mm256_storeu_si256((__m256i*) (p + i), _mm256_add_epi64(v, vK));
+  }
+  addSSE(p + i, n - i, k);
+}
+
+bool (*BinsKernel::m_pAtLeast)(const Int*, size_t, Int) = atLeastScalar;
+size_t (*BinsKernel::m_pFirstBelow)(const Int*, size_t, Int) = firstBelowScalar;
+size_t (*BinsKernel::m_pLastBelow)(const Int*, size_t, Int) = lastBelowScalar;
+void (*BinsKernel::m_pAdd)(Int*, size_t, Int) = addScalar;
+const char* BinsKernel::m_pName = "scalar";
+
+/**
+ * Makes sure that we start out with the fastest kernels even if
+ * select() is never called.
+ */
+
+static struct BinsKernelInit {
+  BinsKernelInit() { BinsKernel::select(true); }
+} initBinsKernel;
+
+void BinsKernel::select(bool bVector) {
+  __builtin_cpu_init();
+  if(bVector && sizeof(Int) == 8 && __builtin_cpu_supports("avx2")) {
+    m_pAtLeast = atLeastAVX2;
+    m_pFirstBelow = firstBelowAVX2;
+    m_pLastBelow = lastBelowAVX2;
+    m_pAdd = addAVX2;
+    m_pName = "avx2";
+  }
+  else if(bVector && sizeof(Int) == 8 && __builtin_cpu_supports("sse4.2")) {
+    m_pAtLeast = atLeastSSE;
+    m_pFirstBelow = firstBelowSSE;
+    m_pLastBelow = lastBelowSSE;
+    m_pAdd = addSSE;
+    m_pName = "sse4.2";
+  }
+  else {
+    m_pAtLeast = atLeastScalar;
+    m_pFirstBelow = firstBelowScalar;
+    m_pLastBelow = lastBelowScalar;
+    m_pAdd = addScalar;
+    m_pName = "scalar";
+  }
+}
+
+const char* BinsKernel::name() {
+  return(m_pName);
+}
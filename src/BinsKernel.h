@@ -0,0 +1,87 @@
+/**
+ * Copyright (C) 2011 Eric Huang
+ *
+ * This file is part of rectpack.
+ *
+ * rectpack is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * rectpack is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with rectpack. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BINSKERNEL_H
+#define BINSKERNEL_H
+
+#include "Integer.h"
+#include <cstddef>
+
+/**
+ * Vectorized kernels for the scans and range updates that BinsBase
+ * performs over its array of bin capacities at every node of the
+ * first-dimension search. The implementation is picked at run time
+ * from AVX2, SSE4.2 and plain scalar code, depending on what the
+ * processor supports.
+ */
+
+class BinsKernel {
+ public:
+
+  /**
+   * Picks the fastest implementation available on this processor,
+   * or the scalar one if bVector is false.
+   */
+
+  static void select(bool bVector);
+  static const char* name();
+
+  /**
+   * @return true if all n values starting at p are at least nMin.
+   */
+
+  static bool atLeast(const Int* p, size_t n, Int nMin) {
+    return(m_pAtLeast(p, n, nMin));
+  }
+
+  /**
+   * @return the index of the first of the n values starting at p
+   * that is less than nMin, or n if there is none.
+   */
+
+  static size_t firstBelow(const Int* p, size_t n, Int nMin) {
+    return(m_pFirstBelow(p, n, nMin));
+  }
+
+  /**
+   * @return one past the index of the last of the n values starting
+   * at p that is less than nMin, or 0 if there is none.
+   */
+
+  static size_t lastBelow(const Int* p, size_t n, Int nMin) {
+    return(m_pLastBelow(p, n, nMin));
+  }
+
+  /**
+   * Adds k to each of the n values starting at p.
+   */
+
+  static void add(Int* p, size_t n, Int k) {
+    m_pAdd(p, n, k);
+  }
+
+ private:
+  static bool (*m_pAtLeast)(const Int*, size_t, Int);
+  static size_t (*m_pFirstBelow)(const Int*, size_t, Int);
+  static size_t (*m_pLastBelow)(const Int*, size_t, Int);
+  static void (*m_pAdd)(Int*, size_t, Int);
+  static const char* m_pName;
+};
+
+#endif // BINSKERNEL_H
@@ -0,0 +1,87 @@
+/**
+ * Copyright (C) 2011 Eric Huang
+ *
+ * This file is part of rectpack.
+ *
+ * rectpack is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * rectpack is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with rectpack. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BottomLeftFill.h"
+#include <algorithm>
+
+BottomLeftFill::BottomLeftFill() {
+}
+
+BottomLeftFill::~BottomLeftFill() {
+}
+
+const char* BottomLeftFill::name() const {
+  return("bottom-left-fill");
+}
+
+void BottomLeftFill::pack(UInt nWidth, std::vector<StripItem>& v) {
+  m_vX.assign(1, 0);
+  m_vY.assign(1, 0);
+  for(size_t i = 0; i < v.size(); ++i) {
+    bool bFound(false), bRotated(false);
+    UInt nX(0), nY(0);
+    for(int r = 0; r < (v[i].m_bRotatable ? 2 : 1); ++r) {
+      v[i].m_bRotated = (r == 1);
+      UInt w = v[i].width(), h = v[i].height();
+      if(w > nWidth) continue;
+      bool bPlaced(false);
+      for(std::vector<UInt>::const_iterator y = m_vY.begin();
+	  y != m_vY.end() && !bPlaced; ++y) {
+	if(bFound && *y > nY) break;
+	for(std::vector<UInt>::const_iterator x = m_vX.begin();
+	    x != m_vX.end(); ++x) {
+	  if(*x + w > nWidth) break;
+	  if(bFound && *y == nY && *x >= nX) break;
+	  if(fits(v, i, *x, *y, w, h)) {
+	    bFound = bPlaced = true;
+	    bRotated = v[i].m_bRotated;
+	    nX = *x;
+	    nY = *y;
+	    break;
+	  }
+	}
+      }
+    }
+
+    /**
+     * The topmost candidate row always has room, so every item is
+     * placed somewhere.
+     */
+
+    v[i].m_bRotated = bRotated;
+    v[i].m_nX = nX;
+    v[i].m_nY = nY;
+    insert(m_vX, nX + v[i].width());
+    insert(m_vY, nY + v[i].height());
+  }
+}
+
+bool BottomLeftFill::fits(const std::vector<StripItem>& v, size_t n, UInt x,
+			  UInt y, UInt w, UInt h) const {
+  for(size_t i = 0; i < n; ++i)
+    if(v[i].overlaps(x, y, w, h))
+      return(false);
+  return(true);
+}
+
+void BottomLeftFill::insert(std::vector<UInt>& v, UInt n) {
+  std::vector<UInt>::iterator i = std::lower_bound(v.begin(), v.end(), n);
+  if(i == v.end() || *i != n)
+    v.insert(i, n);
+}
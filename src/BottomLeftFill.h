@@ -0,0 +1,54 @@
+/**
+ * Copyright (C) 2011 Eric Huang
+ *
+ * This file is part of rectpack.
+ *
+ * rectpack is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * rectpack is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with rectpack. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BOTTOMLEFTFILL_H
+#define BOTTOMLEFTFILL_H
+
+#include "StripPacker.h"
+
+/**
+ * Places each item at the lowest, then leftmost, position where it
+ * fits, holes included. Such a position always has its x coordinate
+ * on the strip's left edge or some item's right edge, and its y
+ * coordinate on the floor or some item's top edge, so only those
+ * candidates are tried. The cost grows with the fourth power of the
+ * number of items, so it is meant for small instances.
+ */
+
+class BottomLeftFill : public StripPacker {
+ public:
+  BottomLeftFill();
+  virtual ~BottomLeftFill();
+  virtual const char* name() const;
+  virtual void pack(UInt nWidth, std::vector<StripItem>& v);
+
+ private:
+  bool fits(const std::vector<StripItem>& v, size_t n, UInt x, UInt y,
+	    UInt w, UInt h) const;
+  static void insert(std::vector<UInt>& v, UInt n);
+
+  /**
+   * The sorted candidate coordinates.
+   */
+
+  std::vector<UInt> m_vX;
+  std::vector<UInt> m_vY;
+};
+
+#endif // BOTTOMLEFTFILL_H
@@ -29,6 +29,8 @@
 #include "Parameters.h"
 #include "Placements.h"
 #include "Rational.h"
+#include "SquarePacker.h"
+#include "UpperBound.h"
 #include "WidthHeight.h"
 #include <algorithm>
 #include <assert.h>
@@ -38,6 +40,7 @@
 BoundingBoxes::BoundingBoxes() :
   m_nMinArea(0),
   m_pPacker(NULL),
+  m_nRecalled(0),
   m_bAllIntegralBoxes(false),
   m_bMutexChecking(true),
   m_bConflictLearning(true),
@@ -51,6 +54,8 @@ BoundingBoxes::~BoundingBoxes() {
 
 void BoundingBoxes::initialize(const Parameters* pParams) {
   m_pParams = pParams;
+  m_Heuristic.clear();
+  m_sBounds.clear();
   if(pParams->m_s0.find_first_of('c') < pParams->m_s0.size())
     m_bConflictLearning = false;
   if(pParams->m_s0.find_first_of('i') < pParams->m_s0.size())
@@ -60,7 +65,8 @@ void BoundingBoxes::initialize(const Parameters* pParams) {
   if(pParams->m_s0.find_first_of('w') < pParams->m_s0.size())
     m_bTopLevelWaste = false;
   m_nMinArea = pParams->m_vInstance.m_nTotalArea;
-  if(pParams->m_s0.find_first_of('l') < pParams->m_s0.size())
+  if(pParams->m_s0.find_first_of('l') < pParams->m_s0.size() &&
+     !pParams->m_bSingleRun)
     lowerBoundSolution();
   m_nMaxArea = std::min(pParams->m_vInstance.m_nMax.m_nHeight.get_ui() *
 			pParams->m_vInstance.m_nStacked.m_nWidth.get_ui(),
@@ -99,6 +105,14 @@ void BoundingBoxes::initialize(const Parameters* pParams) {
 			    SubsetSumsSet::HEIGHT);
     }
     
+    /**
+     * Lower the maximum area to the best strip packing found by the
+     * greedy portfolio, unless the user has turned it off.
+     */
+
+    if(pParams->m_s0.find_first_of('h') >= pParams->m_s0.size())
+      upperBoundSolution();
+
     /**
      * We insert into our heap a representative small bounding box for
      * every eligible width. We initialize our pointer to the maximum
@@ -122,14 +136,18 @@ void BoundingBoxes::initialize(const Parameters* pParams) {
    */
 
   m_nPopped = 0;
+  if(!m_pParams->m_sTelemetry.empty())
+    m_Telemetry.open(m_pParams->m_sTelemetry);
+  m_BoxStore.open(m_pParams, m_pPacker->m_vOriginalRects);
   if(!m_pParams->m_bQuiet && m_pParams->m_Log.empty())
     std::cout << "Command line: " << m_pParams->m_sCommand << std::endl
 	      << "Minimum area: " << m_pParams->m_vUnscaled.m_nTotalArea
-	      << std::endl << std::endl;
+	      << std::endl << m_sBounds << std::endl;
 }
 
 bool BoundingBoxes::run() {
   m_sAttempts.clear();
+  m_nRecalled = 0;
   m_Total.clear();
   m_TotalTime.clear();
   m_TotalXTime.clear();
@@ -141,7 +159,8 @@ bool BoundingBoxes::run() {
   size_t nNthBox = m_pParams->m_nNthBox;
   if(!m_pParams->m_Log.empty()) {
     m_pParams->m_Log.print();
-    nNthBox = (size_t) m_pParams->m_Log.m_nBoxes + 1;
+    nNthBox = (size_t) (m_pParams->m_Log.m_nBoxes +
+			m_pParams->m_Log.m_nRecalled) + 1;
   }
 
   HeapBox b;
@@ -165,9 +184,13 @@ bool BoundingBoxes::run() {
     } else ++nIthBox;
 
     /**
-     * Attempt packing.
+     * Attempt packing, unless the box store already knows the
+     * outcome. Recalled boxes still count towards the box numbers of
+     * -B and --extend.
      */
 
+    if(recalled(b)) continue;
+
     printAttempt(b.m_Box);
     bool bResult = m_pPacker->pack(b);
     if(m_bAllIntegralBoxes)
@@ -188,6 +211,7 @@ bool BoundingBoxes::run() {
 		  << "are not included in the totals below, except for"
 		  << " wall-clock time." << std::endl;
       }
+      printHeuristic();
       return(false);
     }
 
@@ -197,6 +221,10 @@ bool BoundingBoxes::run() {
 
     if(!m_pParams->m_bQuiet)
       m_pPacker->printNodes();
+    m_Telemetry.write(b.m_Box, bResult ? "feasible" : "infeasible",
+		      m_pPacker, 0, m_vBoxes.size(), 0);
+    m_BoxStore.record(b.m_Box, bResult, m_pPacker->m_nDeepestConflict,
+		      m_pPacker->m_Nodes, m_pPacker->m_Time);
 
     m_TotalTime += m_pPacker->m_Time;
     m_TotalYTime += m_pPacker->m_YTime;
@@ -234,6 +262,8 @@ bool BoundingBoxes::run() {
       m_nMaxArea = std::min(m_nMaxArea, b.m_Box.m_nArea);
     }
   }
+  if(nSolutions == 0)
+    printHeuristic();
   return(nSolutions > 0);
 }
 
@@ -273,6 +303,10 @@ bool BoundingBoxes::singleRun() {
   printAttempt(hb.m_Box);
   bool bResult = m_pPacker->pack(hb);
   if(bQuit) return(false);
+  m_Telemetry.write(hb.m_Box, bResult ? "feasible" : "infeasible",
+		    m_pPacker, 0, 0, 0);
+  m_BoxStore.record(hb.m_Box, bResult, m_pPacker->m_nDeepestConflict,
+		    m_pPacker->m_Nodes, m_pPacker->m_Time);
   m_TotalTime += m_pPacker->m_Time;
   m_TotalYTime += m_pPacker->m_YTime;
   m_TotalXTime += m_pPacker->m_XTime;
@@ -304,7 +338,45 @@ bool BoundingBoxes::getNext(HeapBox& b) {
   return(true);
 }
 
+bool BoundingBoxes::recalled(const HeapBox& hb) {
+
+  /**
+   * A box that is known to be infeasible needs no attempt, but its
+   * successors must be queued just as if it had been packed. We
+   * pack feasible boxes again, since the store doesn't keep their
+   * solutions.
+   */
+
+  BoxStore::Entry e;
+  if(!m_BoxStore.find(hb.m_Box, e) || e.m_bResult) return(false);
+  ++m_nRecalled;
+  recall(hb, e);
+  return(true);
+}
+
+void BoundingBoxes::recall(const HeapBox& hb, const BoxStore::Entry& e) {
+  printRecalled(hb.m_Box, e);
+  if(m_bAllIntegralBoxes)
+    pushNextInt(hb);
+  else
+    pushNext(hb, e.m_nDeepestConflict);
+}
+
+void BoundingBoxes::printRecalled(const BoxDimensions& b,
+				  const BoxStore::Entry& e) const {
+  if(!m_pParams->m_bQuiet)
+    std::cout << "Recalled " << m_pParams->unscale(b.m_nWidth)
+	      << " X " << m_pParams->unscale(b.m_nHeight)
+	      << " = " << m_pParams->unscale2(b.m_nArea)
+	      << " (infeasible after " << e.m_Nodes.total() << " nodes, "
+	      << e.m_Time.toDouble() << " seconds)" << std::endl;
+}
+
 bool BoundingBoxes::pushNext(const HeapBox& hb) {
+  return(pushNext(hb, m_pPacker->m_nDeepestConflict));
+}
+
+bool BoundingBoxes::pushNext(const HeapBox& hb, UInt nDeepestConflict) {
 
   HeapBox b(hb);
 
@@ -314,10 +386,10 @@ bool BoundingBoxes::pushNext(const HeapBox& hb) {
    */
 
   if(m_bConflictLearning) {
-    const SubsetSums* ss = &m_vHeights[m_pPacker->m_nDeepestConflict];
+    const SubsetSums* ss = &m_vHeights[nDeepestConflict];
     b.m_iHeight = ss->upper_bound(b.m_iHeight->first);
     --b.m_iHeight;
-    b.m_nConflictLearningIndex = m_pPacker->m_nDeepestConflict;
+    b.m_nConflictLearningIndex = nDeepestConflict;
   }
 
   /**
@@ -487,25 +559,23 @@ void BoundingBoxes::enqueueNewWidths(UInt nMinArea) {
      */
 
     if(m_bTopLevelWaste && m_pParams->m_vInstance.m_nBenchmark == 5) {
-      UInt nRectArea = m_nMinArea.get_ui();
-      UInt nRectWidth = m_pPacker->m_vRects.front().m_nMinDim;
-      UInt nWasteWidth = m_iWidth->first - nRectWidth;
-      UInt nWasteArea = nWasteWidth * m_pPacker->m_vRects.front().m_nMaxDim;
-      UInt nConsumedWaste(0);
-      for(RectArray::const_reverse_iterator i = m_pPacker->m_vRects.rbegin();
-	  i != m_pPacker->m_vRects.rend(); ++i)
-	if(nWasteWidth < i->m_nMinDim)
-	  break;
-	else
-	  nConsumedWaste += i->m_nArea;
-      if(nConsumedWaste < nWasteArea)
-	nWasteArea -= nConsumedWaste;
-      else
-	nWasteArea = 0;
-      UInt nBoxAreaRequired = nRectArea + nWasteArea;
-      UInt nHeightRequired = nBoxAreaRequired / m_iWidth->first;
-      if(nBoxAreaRequired % m_iWidth->first)
-	++nHeightRequired;
+      const Rectangle& r = m_pPacker->m_vOriginalRects.front();
+      UInt nWidth = r.rotatable() ? r.m_nMinDim : r.m_nWidth;
+      UInt nHeight = r.rotatable() ? r.m_nMaxDim : r.m_nHeight;
+      UInt nHeightRequired = topLevelWasteHeight(m_iWidth->first, nWidth,
+						 nHeight);
+
+      /**
+       * The strip is only as tall as the rectangle's short side when
+       * it lies on its side, which is the only option for boxes that
+       * are shorter than its long side.
+       */
+
+      if(r.rotatable() && m_iWidth->first >= nHeight)
+	nHeightRequired =
+	  std::min(nHeightRequired,
+		   std::max(topLevelWasteHeight(m_iWidth->first, nHeight,
+						nWidth), nWidth));
       
       while(hb.m_iHeight != m_Heights.end() &&
 	    hb.m_iHeight->first < nHeightRequired)
@@ -537,6 +607,29 @@ void BoundingBoxes::enqueueNewWidths(UInt nMinArea) {
   }
 }
 
+UInt BoundingBoxes::topLevelWasteHeight(UInt nBoxWidth, UInt nRectWidth,
+					UInt nRectHeight) const {
+  UInt nRectArea = m_nMinArea.get_ui();
+  UInt nWasteWidth = nBoxWidth - nRectWidth;
+  UInt nWasteArea = nWasteWidth * nRectHeight;
+  UInt nConsumedWaste(0);
+  for(RectArray::const_reverse_iterator i = m_pPacker->m_vOriginalRects.rbegin();
+      i != m_pPacker->m_vOriginalRects.rend(); ++i)
+    if(nWasteWidth < i->m_nMinDim)
+      break;
+    else
+      nConsumedWaste += i->m_nArea;
+  if(nConsumedWaste < nWasteArea)
+    nWasteArea -= nConsumedWaste;
+  else
+    nWasteArea = 0;
+  UInt nBoxAreaRequired = nRectArea + nWasteArea;
+  UInt nHeightRequired = nBoxAreaRequired / nBoxWidth;
+  if(nBoxAreaRequired % nBoxWidth)
+    ++nHeightRequired;
+  return(nHeightRequired);
+}
+
 void BoundingBoxes::enqueueNewIntWidths(UInt nMinArea) {
 
   /**
@@ -619,75 +712,108 @@ void BoundingBoxes::enqueueNewIntWidths(UInt nMinArea) {
 void BoundingBoxes::lowerBoundSolution() {
 
   /**
-   * Scale the instance to a size to make the last rectangle a 1x1,
-   * then round it down to the nearest integer for a relaxed version.
+   * Solve the coarsest relaxation first. Each is cheap compared to
+   * the instance itself, and the finer ones usually prove more.
    */
 
-  Instance v = m_pParams->m_vInstance;
-  m_nMaxArea = v.m_nStacked.m_nWidth.get_ui() * v.m_nStacked.m_nHeight.get_ui();
-  v[v.size() - 2] = v[v.size() - 1];
-  v[v.size() - 3] = v[v.size() - 1];
-
-  /**
-   * Construct the necessary command line parameters.
-   */
-
-  std::vector<std::string> vs;
-  vs.push_back(m_pParams->m_pArgv[0]);
-  if(v.m_bUnoriented)
-    vs.push_back("-u");
-  vs.push_back("-v");
-  vs.push_back("-0");
-  vs.push_back("l");
-  vs.push_back("-w");
-  vs.push_back("5");
-  vs.push_back("-1");
-  vs.push_back("d");
-  vs.push_back("-b");
-  vs.push_back("0");
-  vs.push_back("-i");
   std::ostringstream oss;
-  oss << v;
-  vs.push_back(oss.str());
+  URational nMaxDim(m_pParams->m_vInstance.m_nMaxDim);
+  for(UInt nResolution = 8; nResolution >= 2; nResolution /= 2) {
+    if(nMaxDim < (URational) (4 * nResolution))
+      continue;
+    URational nBound = relaxedLowerBound(nResolution);
+    oss << "Lower bound area at resolution " << nResolution << ": "
+	<< m_pParams->unscale2(nBound) << std::endl;
+    m_nMinArea = std::max(m_nMinArea, nBound);
+    if(bQuit) break;
+  }
+  m_sBounds += oss.str();
+}
+
+URational BoundingBoxes::relaxedLowerBound(UInt nResolution) const {
+  Parameters params(*m_pParams);
+  if(!params.coarsen(URational(nResolution)))
+    return(URational(0));
+  if(params.m_nWeakening == 6)
+    params.m_nWeakening = 5;
+
+  Packer* pPacker;
+  if(params.m_bKorf)
+    pPacker = new SquarePacker();
+  else
+    pPacker = Packer::create(&params);
+  BoundingBoxes boxes;
+  boxes.initialize(pPacker);
+  pPacker->initialize(&boxes);
+  pPacker->initialize(&params);
+  boxes.initialize(&params);
+  boxes.run();
+  delete pPacker;
 
   /**
-   * Parse the parameters and run the solver.
+   * The attempts are ordered by area, so the first feasible one is
+   * the optimal box of the relaxed problem. Every packing of the
+   * original rectangles into a W X H box coarsens into a packing of
+   * the relaxed rectangles into a floor(W/r) X floor(H/r) box, so
+   * no original box can have less than r^2 times that area.
    */
 
-  Parameters params;
-  params.parseCommand(vs);
-
-  std::cout << "Scaling from " << m_pParams->m_vInstance << std::endl;
-  std::cout << "to " << params.m_vInstance << std::endl;
+  for(std::set<Attempt>::const_iterator i = boxes.m_sAttempts.begin();
+      i != boxes.m_sAttempts.end(); ++i)
+    if(i->m_bResult) {
+      URational nArea(params.unscale2(i->m_Box.m_nArea));
+      nArea *= URational(nResolution * nResolution);
+      return(nArea);
+    }
+  return(URational(0));
+}
 
-  Packer* pPacker = Packer::create(&params);
-  BoundingBoxes* pBoxes = new BoundingBoxes();
-  pBoxes->initialize(pPacker);
-  pPacker->initialize(pBoxes);
-  pPacker->initialize(&params);
-  pBoxes->initialize(&params);
-  pBoxes->run();
+void BoundingBoxes::upperBoundSolution() {
 
   /**
-   * Retrieve the minimum area.
+   * The greedy packers place every rectangle themselves, so they
+   * can't honour rectangles fixed by the instance.
    */
 
-  URational nMinArea(0);
-  for(std::set<Attempt>::const_iterator i = pBoxes->m_sAttempts.begin();
-      i != pBoxes->m_sAttempts.end(); ++i) {
-    if(i->m_bResult) {
-      RDimensions rd(i->m_Box);
-      rd *= params.m_vInstance.m_nScale;
-      nMinArea = rd.m_nArea;
-      std::cout << "Lower bound area is " << nMinArea << std::endl;
-      break;
-    }
+  for(RectArray::const_iterator i = m_pPacker->m_vOriginalRects.begin();
+      i != m_pPacker->m_vOriginalRects.end(); ++i)
+    if(i->fixed())
+      return;
+
+  UpperBound ub;
+  ub.initialize(m_pPacker->m_vOriginalRects);
+  if(!ub.run((size_t) std::max(m_pParams->m_nThreads, 1)))
+    return;
+  ub.get(m_Heuristic);
+  if(!m_Heuristic.verify()) {
+    std::cout << "  Error: Heuristic packing constraints not satisfied."
+	      << std::endl;
+    m_Heuristic.clear();
+    return;
   }
-  delete pPacker;
-  delete pBoxes;
+  m_nMaxArea = std::min(m_nMaxArea, ub.m_nArea);
 
-  m_nMinArea = std::max(m_nMinArea, nMinArea);
+  std::ostringstream oss;
+  oss << "Heuristic upper bound: " << m_pParams->unscale(ub.m_nWidth)
+      << " X " << m_pParams->unscale(ub.m_nHeight)
+      << " = " << m_pParams->unscale2(ub.m_nArea)
+      << " (" << ub.m_sPacker << ", " << ub.m_sOrdering << ")"
+      << std::endl;
+  m_sBounds += oss.str();
 }
 
-void BoundingBoxes::upperBoundSolution() {
+void BoundingBoxes::printHeuristic() const {
+  if(m_Heuristic.empty() || m_pParams->m_bQuiet)
+    return;
+  std::cout << "No solution was found by the search. The best heuristic "
+	    << "packing is:" << std::endl;
+  AsciiGrid ag;
+  Placements v(m_Heuristic);
+  ag.draw(m_pParams, v);
+  ag.print();
+  std::cout << "  Rectangles were placed in these (x,y) locations:"
+	    << std::endl;
+  v *= m_pParams->m_vInstance.m_nScale;
+  v.print();
+  std::cout << std::endl << std::endl;
 }
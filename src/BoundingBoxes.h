@@ -21,12 +21,15 @@
 #define BOUNDINGBOXES_H
 
 #include "Attempt.h"
+#include "BoxStore.h"
 #include "HeapBox.h"
 #include "NodeCount.h"
+#include "Placements.h"
 #include "PriorityQ.h"
 #include "Rational.h"
 #include "SubsetSums.h"
 #include "SubsetSumsSet.h"
+#include "Telemetry.h"
 #include "TimeSpec.h"
 #include <deque>
 #include <set>
@@ -57,6 +60,13 @@ class BoundingBoxes {
   virtual std::string solutions() const;
   UInt attempts() const;
   std::set<Attempt> m_sAttempts;
+
+  /**
+   * The number of boxes skipped because the box store already knew
+   * them to be infeasible.
+   */
+
+  UInt m_nRecalled;
   NodeCount m_Total;
   TimeSpec m_TotalTime;
   TimeSpec m_TotalXTime;
@@ -90,6 +100,17 @@ class BoundingBoxes {
   bool m_bConflictLearning;
   bool m_bTopLevelWaste;
 
+  /**
+   * Solves, in process, the relaxation of our instance in which every
+   * rectangle is divided by the given resolution and rounded down.
+   *
+   * @return a lower bound on the area of any box that can hold the
+   * original instance, on the scale of m_pParams, or 0 if the
+   * relaxation couldn't be solved.
+   */
+
+  URational relaxedLowerBound(UInt nResolution) const;
+
  protected:
   void pop(HeapBox& hb);
 
@@ -112,9 +133,36 @@ class BoundingBoxes {
 
   virtual bool getNext(HeapBox& b);
   virtual bool pushNext(const HeapBox& hb);
+
+  /**
+   * Checks the box store for a box that was popped by getNext. If it
+   * is known to be infeasible, the box is reported by recall, which
+   * also enqueues its successors, and no attempt is needed.
+   *
+   * @return true if the box was recalled as infeasible.
+   */
+
+  bool recalled(const HeapBox& hb);
+  virtual void recall(const HeapBox& hb, const BoxStore::Entry& e);
+  void printRecalled(const BoxDimensions& b, const BoxStore::Entry& e) const;
+
+  /**
+   * Same as above, but the successor's heights are drawn from the
+   * subset sums of the given conflict learning index rather than
+   * from the deepest conflict recorded by m_pPacker.
+   */
+
+  bool pushNext(const HeapBox& hb, UInt nDeepestConflict);
   virtual bool pushNextInt(const HeapBox& hb);
   virtual void printAttempt(const BoxDimensions& b) const;
 
+  /**
+   * Prints the heuristic packing found by upperBoundSolution, for
+   * when the search ends without a solution of its own.
+   */
+
+  void printHeuristic() const;
+
   /**
    * Enqueues new classes of bounding boxes by incrementing the width
    * and inserting bounding boxes whose heights tightly wrap the
@@ -128,10 +176,38 @@ class BoundingBoxes {
   void enqueueNewWidths(UInt nMinArea);
   void enqueueNewIntWidths(UInt nMinArea);
 
+  /**
+   * Computes the least box height for the given width once we account
+   * for the strip to the right of the largest rectangle that only the
+   * rectangles narrow enough can fill.
+   *
+   * @param nRectWidth the width of the largest rectangle in the
+   * orientation considered.
+   *
+   * @param nRectHeight its height, which is also that of the strip.
+   */
+
+  UInt topLevelWasteHeight(UInt nBoxWidth, UInt nRectWidth,
+			   UInt nRectHeight) const;
+
   PriorityQ m_vBoxes;
   Int m_nPopped;
   const Parameters* m_pParams;
 
+  /**
+   * Where the record of each packing attempt is written, if it was
+   * requested.
+   */
+
+  Telemetry m_Telemetry;
+
+  /**
+   * The outcomes of the attempts made on this instance by earlier or
+   * concurrent runs, if a store was requested.
+   */
+
+  BoxStore m_BoxStore;
+
   /**
    * Points to the next width that we should consider for purposes of
    * inserting a new class of boxes.
@@ -147,8 +223,34 @@ class BoundingBoxes {
 
   UInt m_nWidth;
 
+  /**
+   * The best packing found by the heuristic packers before the search
+   * began (empty if they weren't run). Its box bounds m_nMaxArea.
+   */
+
+  Placements m_Heuristic;
+
+  /**
+   * Describes the bounds derived before the search began, to be
+   * printed along with the command line.
+   */
+
+  std::string m_sBounds;
+
  private:
+
+  /**
+   * Raises m_nMinArea with the bounds proven by solving the instance
+   * coarsened at several resolutions.
+   */
+
   void lowerBoundSolution();
+
+  /**
+   * Runs a portfolio of greedy packers to find a feasible packing,
+   * whose area tightens m_nMaxArea before any box is queued.
+   */
+
   void upperBoundSolution();
 };
 
@@ -0,0 +1,235 @@
+/**
+ * Copyright (C) 2011 Eric Huang
+ *
+ * This file is part of rectpack.
+ *
+ * rectpack is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * rectpack is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with rectpack. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BoxDimensions.h"
+#include "BoxStore.h"
+#include "Parameters.h"
+#include "RectArray.h"
+#include <fcntl.h>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+/**
+ * "RPBOXDB1" read as a little-endian integer.
+ */
+
+#define BOXSTORE_MAGIC 0x3142445842505052ULL
+#define BOXSTORE_VERSION 1
+#define BOXSTORE_RECORD 10
+
+BoxStore::BoxStore() :
+  m_nFile(-1),
+  m_nOffset(0) {
+}
+
+BoxStore::~BoxStore() {
+  close();
+}
+
+bool BoxStore::open(const Parameters* pParams, const RectArray& vRects) {
+  close();
+  if(pParams->m_sBoxStore.empty()) return(false);
+
+  /**
+   * The file is named after a hash of the key. Collisions are caught
+   * by comparing the key stored in the file.
+   */
+
+  m_sKey = key(pParams, vRects);
+  std::ostringstream ossFile;
+  ossFile << pParams->m_sBoxStore << "/box-" << std::hex
+	  << std::setw(16) << std::setfill('0') << hash(m_sKey) << ".db";
+  m_sFile = ossFile.str();
+
+  m_nFile = ::open(m_sFile.c_str(), O_RDWR | O_CREAT | O_APPEND, 0644);
+  if(m_nFile < 0 || !header()) {
+    std::cout << "Could not use the box store " << m_sFile << "."
+	      << std::endl;
+    close();
+    return(false);
+  }
+  return(true);
+}
+
+std::string BoxStore::key(const Parameters* pParams,
+			  const RectArray& vRects) {
+
+  /**
+   * Whether a box is feasible depends only on the rectangles, but the
+   * nodes and the deepest conflict depend on the packer and on the
+   * options of the box search. Those that only decide which boxes are
+   * queued ('h' and 'l') are left out.
+   */
+
+  std::string s0;
+  for(std::string::const_iterator i = pParams->m_s0.begin();
+      i != pParams->m_s0.end(); ++i)
+    if(*i != 'h' && *i != 'l')
+      s0.push_back(*i);
+  std::ostringstream oss;
+  oss << "w" << pParams->m_nWeakening << ";k" << pParams->m_bKorf
+      << ";0" << s0 << ";1" << pParams->m_s1 << ";2" << pParams->m_s2
+      << ";y" << pParams->m_nYScale << ";";
+  if(!pParams->m_vPortfolio.empty())
+    oss << "W" << pParams->m_sPortfolio << ";";
+  for(RectArray::const_iterator i = vRects.begin(); i != vRects.end(); ++i)
+    oss << i->m_nWidth << "x" << i->m_nHeight
+	<< (i->m_bRotatable ? "r" : "") << ",";
+  return(oss.str());
+}
+
+unsigned long long BoxStore::hash(const std::string& sKey) {
+
+  /**
+   * 64-bit FNV-1a.
+   */
+
+  unsigned long long nHash = 14695981039346656037ULL;
+  for(std::string::const_iterator i = sKey.begin(); i != sKey.end(); ++i)
+    nHash = (nHash ^ (unsigned char) *i) * 1099511628211ULL;
+  return(nHash);
+}
+
+bool BoxStore::header() {
+  boost::unique_lock<boost::mutex> lock(m_Mutex);
+  flock(m_nFile, LOCK_EX);
+  size_t nKeyWords = (m_sKey.size() + sizeof(UInt) - 1) / sizeof(UInt);
+  std::vector<UInt> v(3 + nKeyWords, 0);
+  v[0] = BOXSTORE_MAGIC;
+  v[1] = BOXSTORE_VERSION;
+  v[2] = m_sKey.size();
+  m_sKey.copy((char*) &v[3], m_sKey.size());
+  size_t nBytes = v.size() * sizeof(UInt);
+
+  /**
+   * The first run on an instance writes the header. Everyone else
+   * checks that it's the instance they expect.
+   */
+
+  bool bValid(false);
+  struct stat st;
+  if(fstat(m_nFile, &st) == 0) {
+    if(st.st_size == 0)
+      bValid = (write(m_nFile, &v[0], nBytes) == (ssize_t) nBytes);
+    else {
+      std::vector<UInt> vFile(v.size());
+      bValid = (pread(m_nFile, &vFile[0], nBytes, 0) == (ssize_t) nBytes &&
+		vFile == v);
+    }
+  }
+  m_nOffset = nBytes;
+  if(bValid)
+    refresh();
+  flock(m_nFile, LOCK_UN);
+  return(bValid);
+}
+
+void BoxStore::close() {
+  if(m_nFile >= 0)
+    ::close(m_nFile);
+  m_nFile = -1;
+  m_nOffset = 0;
+  m_Entries.clear();
+}
+
+bool BoxStore::enabled() const {
+  return(m_nFile >= 0);
+}
+
+void BoxStore::refresh() {
+  struct stat st;
+  if(fstat(m_nFile, &st) != 0) return;
+  const long long nRecord = BOXSTORE_RECORD * sizeof(UInt);
+  size_t nRecords = (size_t) ((st.st_size - m_nOffset) / nRecord);
+  if(nRecords == 0) return;
+  std::vector<UInt> v(nRecords * BOXSTORE_RECORD);
+  ssize_t nRead = pread(m_nFile, &v[0], nRecords * nRecord, m_nOffset);
+  if(nRead < 0) return;
+  nRecords = (size_t) (nRead / nRecord);
+  m_nOffset += nRecords * nRecord;
+  for(size_t i = 0; i < nRecords; ++i) {
+    const UInt* p = &v[i * BOXSTORE_RECORD];
+    Entry& e = m_Entries[std::make_pair(p[0], p[1])];
+    e.m_bResult = (p[2] != 0);
+    e.m_nDeepestConflict = p[3];
+    e.m_Nodes.set(YI, p[4]);
+    e.m_Nodes.set(YF, p[5]);
+    e.m_Nodes.set(XI, p[6]);
+    e.m_Nodes.set(XF, p[7]);
+    e.m_Time.set((long) p[8], (long) p[9]);
+  }
+}
+
+bool BoxStore::find(const BoxDimensions& b, Entry& e) {
+  if(!enabled()) return(false);
+  boost::unique_lock<boost::mutex> lock(m_Mutex);
+  std::pair<UInt, UInt> k(b.m_nWidth, b.m_nHeight);
+  std::map<std::pair<UInt, UInt>, Entry>::const_iterator i =
+    m_Entries.find(k);
+  if(i == m_Entries.end()) {
+
+    /**
+     * Another process may have attempted it in the meantime.
+     */
+
+    flock(m_nFile, LOCK_SH);
+    refresh();
+    flock(m_nFile, LOCK_UN);
+    i = m_Entries.find(k);
+    if(i == m_Entries.end()) return(false);
+  }
+  e = i->second;
+  return(true);
+}
+
+void BoxStore::record(const BoxDimensions& b, bool bResult,
+		      UInt nDeepestConflict, const NodeCount& nc,
+		      const TimeSpec& t) {
+  if(!enabled()) return;
+  boost::unique_lock<boost::mutex> lock(m_Mutex);
+  flock(m_nFile, LOCK_EX);
+  refresh();
+  std::pair<UInt, UInt> k(b.m_nWidth, b.m_nHeight);
+  if(m_Entries.find(k) == m_Entries.end()) {
+    UInt v[BOXSTORE_RECORD] = {
+      b.m_nWidth, b.m_nHeight, (UInt) (bResult ? 1 : 0), nDeepestConflict,
+      (UInt) nc.get(YI), (UInt) nc.get(YF), (UInt) nc.get(XI),
+      (UInt) nc.get(XF), (UInt) t.tv_sec, (UInt) t.tv_nsec
+    };
+    if(write(m_nFile, v, sizeof(v)) == (ssize_t) sizeof(v)) {
+      m_nOffset += sizeof(v);
+      Entry& e = m_Entries[k];
+      e.m_bResult = bResult;
+      e.m_nDeepestConflict = nDeepestConflict;
+      e.m_Nodes = nc;
+      e.m_Time = t;
+    }
+  }
+  flock(m_nFile, LOCK_UN);
+}
+
+size_t BoxStore::size() {
+  boost::unique_lock<boost::mutex> lock(m_Mutex);
+  return(m_Entries.size());
+}
@@ -0,0 +1,127 @@
+/**
+ * Copyright (C) 2011 Eric Huang
+ *
+ * This file is part of rectpack.
+ *
+ * rectpack is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * rectpack is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with rectpack. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BOXSTORE_H
+#define BOXSTORE_H
+
+#include "Integer.h"
+#include "NodeCount.h"
+#include "TimeSpec.h"
+#include <boost/thread/mutex.hpp>
+#include <map>
+#include <string>
+#include <utility>
+
+class BoxDimensions;
+class Parameters;
+class RectArray;
+
+/**
+ * Remembers the outcome of every packing attempt across runs, so that
+ * a sweep over the bounding boxes of an instance never has to prove
+ * the same box infeasible twice. Each instance gets its own file in
+ * the store directory, named after a hash of a key that spells out
+ * every (scaled) rectangle in order along with the options that
+ * select and configure the packer. The file is a flat array of UInts:
+ *
+ *   magic, version, key length, key (padded to whole UInts),
+ *
+ * followed by one record per attempt:
+ *
+ *   width, height, result, deepest conflict, the nodes by type (YI,
+ *   YF, XI, XF), and the CPU time in seconds and nanoseconds.
+ *
+ * Records are only ever appended, while holding an exclusive lock on
+ * the file, and read while holding a shared one. So several threads
+ * and processes can share a store, each picking up the records of
+ * the others as they are written.
+ */
+
+class BoxStore {
+ public:
+  BoxStore();
+  ~BoxStore();
+
+  /**
+   * Opens (or creates) the store file of the given instance in the
+   * directory requested by the parameters.
+   *
+   * @return false if no store was requested or the file couldn't be
+   * used, in which case nothing is recalled or recorded.
+   */
+
+  bool open(const Parameters* pParams, const RectArray& vRects);
+  void close();
+  bool enabled() const;
+
+  /**
+   * The outcome of an attempt, including the deepest conflict
+   * learning index that the packer reported.
+   */
+
+  class Entry {
+  public:
+    bool m_bResult;
+    UInt m_nDeepestConflict;
+    NodeCount m_Nodes;
+    TimeSpec m_Time;
+  };
+
+  /**
+   * Looks up the outcome of a previous attempt on the box.
+   *
+   * @return true if the box was attempted before.
+   */
+
+  bool find(const BoxDimensions& b, Entry& e);
+  void record(const BoxDimensions& b, bool bResult, UInt nDeepestConflict,
+	      const NodeCount& nc, const TimeSpec& t);
+
+  /**
+   * The number of records read from the file or written to it.
+   */
+
+  size_t size();
+
+  /**
+   * The key of an instance and packer configuration, and the hash of
+   * such a key that names its file.
+   */
+
+  static std::string key(const Parameters* pParams, const RectArray& vRects);
+  static unsigned long long hash(const std::string& sKey);
+
+ private:
+  /**
+   * Reads the records appended since we last looked. The caller must
+   * hold m_Mutex and a lock on the file.
+   */
+
+  void refresh();
+  bool header();
+
+  std::string m_sKey;
+  std::string m_sFile;
+  int m_nFile;
+  long long m_nOffset;
+  std::map<std::pair<UInt, UInt>, Entry> m_Entries;
+  boost::mutex m_Mutex;
+};
+
+#endif // BOXSTORE_H
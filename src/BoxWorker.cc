@@ -0,0 +1,88 @@
+/**
+ * Copyright (C) 2011 Eric Huang
+ *
+ * This file is part of rectpack.
+ *
+ * rectpack is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * rectpack is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with rectpack. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BoxWorker.h"
+#include "Packer.h"
+
+BoxWorker::BoxWorker(Packer* pPacker, size_t nID) :
+  m_pPacker(pPacker),
+  m_nID(nID),
+  m_nCancelled(0),
+  m_nStolen(0),
+  m_nCurrent(0) {
+}
+
+BoxWorker::~BoxWorker() {
+}
+
+void BoxWorker::clear() {
+  boost::unique_lock<boost::mutex> lock(m_Mutex);
+  m_vBoxes.clear();
+  m_vAttempts.clear();
+  m_vFound.clear();
+  m_Nodes.clear();
+  m_Time.clear();
+  m_XTime.clear();
+  m_YTime.clear();
+  m_nCancelled = 0;
+  m_nStolen = 0;
+  m_nCurrent = 0;
+}
+
+void BoxWorker::push(const HeapBox& hb) {
+  boost::unique_lock<boost::mutex> lock(m_Mutex);
+  m_vBoxes.push_back(hb);
+}
+
+bool BoxWorker::pop(HeapBox& hb) {
+  boost::unique_lock<boost::mutex> lock(m_Mutex);
+  if(m_vBoxes.empty()) return(false);
+  hb = m_vBoxes.front();
+  m_vBoxes.pop_front();
+  return(true);
+}
+
+bool BoxWorker::front(UInt& nArea) {
+  boost::unique_lock<boost::mutex> lock(m_Mutex);
+  if(m_vBoxes.empty()) return(false);
+  nArea = m_vBoxes.front().m_Box.m_nArea;
+  return(true);
+}
+
+size_t BoxWorker::size() {
+  boost::unique_lock<boost::mutex> lock(m_Mutex);
+  return(m_vBoxes.size());
+}
+
+void BoxWorker::start(const HeapBox& hb) {
+  m_pPacker->m_bCancel = false;
+  m_nCurrent = hb.m_Box.m_nArea;
+}
+
+void BoxWorker::finish() {
+  m_nCurrent = 0;
+}
+
+bool BoxWorker::cancel(UInt nArea) {
+  if(m_nCurrent.load() > nArea) {
+    m_pPacker->m_bCancel = true;
+    return(true);
+  }
+  return(false);
+}
@@ -0,0 +1,108 @@
+/**
+ * Copyright (C) 2011 Eric Huang
+ *
+ * This file is part of rectpack.
+ *
+ * rectpack is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * rectpack is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with rectpack. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BOXWORKER_H
+#define BOXWORKER_H
+
+#include "Attempt.h"
+#include "HeapBox.h"
+#include "Integer.h"
+#include "NodeCount.h"
+#include "TimeSpec.h"
+#include <boost/atomic.hpp>
+#include <boost/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <deque>
+#include <utility>
+
+class Packer;
+
+/**
+ * The per-thread state of the parallel bounding box search. Each
+ * worker owns a packer and a small deque of bounding boxes that it
+ * has claimed from the shared priority queue. The deque is sorted by
+ * increasing area since it is always filled in heap order, so idle
+ * workers can steal the smallest pending box from the front.
+ *
+ * Results are written only by the owning thread and are merged by
+ * ParallelBoxes after all of the threads have been joined.
+ */
+
+class BoxWorker {
+ public:
+  BoxWorker(Packer* pPacker, size_t nID);
+  ~BoxWorker();
+  void clear();
+
+  /**
+   * Deque operations. These are safe to call from any thread.
+   */
+
+  void push(const HeapBox& hb);
+  bool pop(HeapBox& hb);
+  bool front(UInt& nArea);
+  size_t size();
+
+  /**
+   * Marks the given box as the one currently being packed. The
+   * packer's cancellation flag is cleared before the box is
+   * published so that a concurrent call to cancel() is never lost.
+   */
+
+  void start(const HeapBox& hb);
+  void finish();
+
+  /**
+   * Cancels the current packing attempt if it is working on a box
+   * whose area exceeds the given bound.
+   *
+   * @return true if the attempt was cancelled.
+   */
+
+  bool cancel(UInt nArea);
+
+  Packer* m_pPacker;
+  size_t m_nID;
+  boost::thread m_Thread;
+
+  /**
+   * Results collected by this worker.
+   */
+
+  std::deque<Attempt> m_vAttempts;
+  std::deque<std::pair<UInt, TimeSpec> > m_vFound;
+  NodeCount m_Nodes;
+  TimeSpec m_Time;
+  TimeSpec m_XTime;
+  TimeSpec m_YTime;
+  UInt m_nCancelled;
+  UInt m_nStolen;
+
+ private:
+  boost::mutex m_Mutex;
+  std::deque<HeapBox> m_vBoxes;
+
+  /**
+   * The area of the box currently being packed, or zero if idle.
+   */
+
+  boost::atomic<UInt> m_nCurrent;
+};
+
+#endif // BOXWORKER_H
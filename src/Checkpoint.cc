@@ -0,0 +1,268 @@
+/**
+ * Copyright (C) 2011 Eric Huang
+ *
+ * This file is part of rectpack.
+ *
+ * rectpack is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * rectpack is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with rectpack. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BoxDimensions.h"
+#include "BoxStore.h"
+#include "Checkpoint.h"
+#include "Parameters.h"
+#include "RectArray.h"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdio.h>
+#include <unistd.h>
+
+/**
+ * The number of branches between two looks at the clock.
+ */
+
+#define CHECKPOINT_POLL 4096
+#define CHECKPOINT_VERSION 1
+
+Checkpoint::Checkpoint() :
+  m_bEnabled(false),
+  m_nPeriod(0),
+  m_nNext(0),
+  m_nPoll(CHECKPOINT_POLL),
+  m_pRects(NULL),
+  m_pNodes(NULL),
+  m_pCancel(NULL),
+  m_nLevel(0),
+  m_bDetour(false),
+  m_bReplaying(false),
+  m_bMismatch(false),
+  m_nInterrupted(0) {
+}
+
+Checkpoint::~Checkpoint() {
+}
+
+void Checkpoint::initialize(const Parameters* pParams,
+			    const RectArray& vOriginal, RectArray* pRects,
+			    const NodeCount* pNodes,
+			    const boost::atomic<bool>* pCancel) {
+  m_bEnabled = !pParams->m_sCheckpoint.empty();
+  if(!m_bEnabled) return;
+  m_sDir = pParams->m_sCheckpoint;
+  m_sKey = BoxStore::key(pParams, vOriginal);
+  m_pRects = pRects;
+  m_nPeriod = std::max(pParams->m_nCheckpointPeriod, 1);
+  m_pNodes = pNodes;
+  m_pCancel = pCancel;
+
+  /**
+   * Every rectangle is given a y interval and later perhaps a y
+   * coordinate along any path, which bounds its length.
+   */
+
+  m_vPath.resize(2 * vOriginal.size() + 1);
+  m_vBranches.resize(2 * vOriginal.size() + 2);
+  m_vFirst.resize(2 * vOriginal.size() + 2);
+}
+
+bool Checkpoint::enabled() const {
+  return(m_bEnabled);
+}
+
+void Checkpoint::begin(const BoxDimensions& b) {
+  m_nLevel = 0;
+  m_bDetour = m_bReplaying = m_bMismatch = false;
+  m_nInterrupted = 0;
+  m_vReplay.clear();
+  m_Prior.clear();
+  if(!m_bEnabled) return;
+  m_vBranches[0] = 0;
+  std::ostringstream oss;
+  oss << m_sDir << "/ckpt-" << std::hex << std::setw(16)
+      << std::setfill('0') << BoxStore::hash(m_sKey) << std::dec
+      << "-" << b.m_nWidth << "x" << b.m_nHeight << ".txt";
+  m_sFile = oss.str();
+  m_Box = b;
+  if(load(b) && !m_vReplay.empty()) {
+    m_bDetour = m_bReplaying = true;
+    std::cout << "Resuming the " << b.m_nWidth << "x" << b.m_nHeight
+	      << " box from a checkpoint at depth " << m_vReplay.size()
+	      << " (" << m_Prior.total() << " nodes so far)." << std::endl;
+  }
+  m_nPoll = CHECKPOINT_POLL;
+  m_nNext = time(NULL) + m_nPeriod;
+}
+
+bool Checkpoint::detour(UInt n, const Rectangle* r, Int nBegin, Int nEnd) {
+  if(m_nInterrupted > 0 || m_bMismatch) return(false);
+  if(m_nLevel == 0 && n == 0) orient();
+
+  /**
+   * We're replaying the snapshot. Earlier branches have already been
+   * searched, and the one on the path has to be exactly what the
+   * snapshot says, or else the snapshot describes some other search.
+   */
+
+  const Step& s(m_vReplay[m_nLevel]);
+  if(n < s.m_nBranch) return(false);
+  if(n == s.m_nBranch && s.m_nID == r->m_nID &&
+     s.m_nWidth == r->m_nWidth && s.m_nHeight == r->m_nHeight &&
+     s.m_nBegin == nBegin && s.m_nEnd == nEnd) {
+    if(m_nLevel + 1 == m_vReplay.size())
+      m_bDetour = m_bReplaying = false;
+    return(true);
+  }
+  m_bMismatch = true;
+  return(false);
+}
+
+void Checkpoint::orient() {
+
+  /**
+   * The packers try the orientation that a rectangle happens to have
+   * first. Some leave it rotated after they are done with it, so the
+   * branches they searched before the snapshot may have left the
+   * rectangles on the path differently oriented than they are now,
+   * at the start of the box. We turn each of them the way its first
+   * branch was, since the search gets to the path without touching
+   * them. The first rectangle is set up by the packer itself.
+   */
+
+  std::vector<UInt> vWidth(m_pRects->size(), 0);
+  std::vector<bool> vSeen(m_pRects->size(), false);
+  vSeen[m_vReplay.front().m_nID] = true;
+  for(std::vector<Step>::const_iterator i = m_vReplay.begin() + 1;
+      i != m_vReplay.end(); ++i)
+    if(i->m_nID < vSeen.size() && !vSeen[i->m_nID]) {
+      vSeen[i->m_nID] = true;
+      vWidth[i->m_nID] = i->m_nFirst;
+    }
+  for(RectArray::iterator i = m_pRects->begin(); i != m_pRects->end(); ++i)
+    if(vWidth[i->m_nID] != 0 && vWidth[i->m_nID] != i->m_nWidth &&
+       i->rotatable())
+      i->rotate();
+}
+
+void Checkpoint::poll() {
+  m_nPoll = CHECKPOINT_POLL;
+  time_t n(time(NULL));
+  if(n < m_nNext) return;
+  if(!m_bReplaying) save(m_nLevel);
+  m_nNext = n + m_nPeriod;
+}
+
+void Checkpoint::end() {
+  if(!m_bEnabled || m_bMismatch) return;
+
+  /**
+   * Only a signal leaves the box undecided. A cancelled attempt was
+   * either decided by another packer or made redundant by a smaller
+   * solution, so any snapshot written by poll() is stale as well.
+   */
+
+  if(bQuit) {
+    if(m_nInterrupted > 0 && !m_bReplaying) save(m_nInterrupted);
+  }
+  else discard();
+}
+
+bool Checkpoint::mismatch() const {
+  return(m_bMismatch || m_bReplaying);
+}
+
+void Checkpoint::discard() {
+  if(m_bEnabled) unlink(m_sFile.c_str());
+}
+
+bool Checkpoint::load(const BoxDimensions& b) {
+  std::ifstream ifs(m_sFile.c_str());
+  if(!ifs.good()) return(false);
+
+  /**
+   * The header: format and version, the instance key, the box, and
+   * the nodes searched so far by type.
+   */
+
+  std::string sMagic, sKey;
+  int nVersion(0);
+  UInt nWidth(0), nHeight(0);
+  size_t nLevels(0);
+  ifs >> sMagic >> nVersion >> std::ws;
+  std::getline(ifs, sKey);
+  ifs >> nWidth >> nHeight;
+  for(int i = YI; i <= XF; ++i) {
+    unsigned long long n(0);
+    ifs >> n;
+    m_Prior.set((VizType) i, n);
+  }
+  ifs >> nLevels;
+  if(ifs.fail() || sMagic != "rectpack-checkpoint" ||
+     nVersion != CHECKPOINT_VERSION || sKey != m_sKey ||
+     nWidth != b.m_nWidth || nHeight != b.m_nHeight ||
+     nLevels > m_vPath.size()) {
+    std::cout << "Ignoring the checkpoint " << m_sFile
+	      << " since it was written for a different search." << std::endl;
+    m_Prior.clear();
+    return(false);
+  }
+
+  /**
+   * Followed by one line per level of the path.
+   */
+
+  m_vReplay.resize(nLevels);
+  for(std::vector<Step>::iterator i = m_vReplay.begin();
+      i != m_vReplay.end(); ++i)
+    ifs >> i->m_nBranch >> i->m_nFirst >> i->m_nID >> i->m_nWidth
+	>> i->m_nHeight >> i->m_nBegin >> i->m_nEnd;
+  if(ifs.fail()) {
+    std::cout << "Ignoring the truncated checkpoint " << m_sFile
+	      << "." << std::endl;
+    m_vReplay.clear();
+    m_Prior.clear();
+    return(false);
+  }
+  return(true);
+}
+
+void Checkpoint::save(size_t nLevels) {
+
+  /**
+   * Written next to the old snapshot and then renamed over it, so
+   * that being killed halfway leaves the old snapshot intact.
+   */
+
+  std::string sTemp(m_sFile + ".tmp");
+  std::ofstream ofs(sTemp.c_str());
+  ofs << "rectpack-checkpoint " << CHECKPOINT_VERSION << std::endl
+      << m_sKey << std::endl
+      << m_Box.m_nWidth << " " << m_Box.m_nHeight << std::endl;
+  for(int i = YI; i <= XF; ++i)
+    ofs << m_Prior.get((VizType) i) + m_pNodes->get((VizType) i)
+	<< (i < XF ? " " : "\n");
+  ofs << nLevels << std::endl;
+  for(size_t i = 0; i < nLevels; ++i) {
+    const Step& s(m_vPath[i]);
+    ofs << s.m_nBranch << " " << m_vFirst[i] << " " << s.m_nID << " " << s.m_nWidth << " "
+	<< s.m_nHeight << " " << s.m_nBegin << " " << s.m_nEnd << std::endl;
+  }
+  ofs.close();
+  if(ofs.fail() || rename(sTemp.c_str(), m_sFile.c_str()) != 0) {
+    std::cout << "Could not write the checkpoint " << m_sFile << "."
+	      << std::endl;
+    unlink(sTemp.c_str());
+  }
+}
@@ -0,0 +1,199 @@
+/**
+ * Copyright (C) 2011 Eric Huang
+ *
+ * This file is part of rectpack.
+ *
+ * rectpack is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * rectpack is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with rectpack. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include "BoxDimensions.h"
+#include "Globals.h"
+#include "Integer.h"
+#include "NodeCount.h"
+#include "Rectangle.h"
+#include <boost/atomic.hpp>
+#include <string>
+#include <time.h>
+#include <vector>
+
+class Parameters;
+class RectArray;
+
+/**
+ * Snapshots of the first-dimension search of an integer packer, so
+ * that an attempt on a single bounding box that gets preempted can
+ * be resumed where it left off instead of from scratch.
+ *
+ * The packer reports every branch of its y search to enter() and
+ * every retraction to leave(), from which we keep the path to the
+ * current node: for each level, the rectangle placed there with its
+ * orientation and y interval (or y coordinate, in the case of the
+ * strips), and how many branches its parent had generated before
+ * it. Those earlier branches have been explored in full, so the path
+ * is all a snapshot needs. On resume, enter() rejects the earlier
+ * branches at each level of the path and checks that the branches on
+ * the path are generated again, after which the subtree of the
+ * deepest node is searched from scratch. Should they not be, the
+ * whole search is abandoned and the packer starts the box over.
+ *
+ * A snapshot is written every m_nCheckpointPeriod seconds and when
+ * the attempt is interrupted by a signal, to
+ * <dir>/ckpt-<hash>-<W>x<H>.txt where the hash is that of the box
+ * store key of the instance, and it is removed once the box is
+ * decided or its attempt is cancelled. The second dimension is not
+ * covered: a resumed search starts over on the x-coordinates of the
+ * deepest node of the path.
+ */
+
+class Checkpoint {
+ public:
+  Checkpoint();
+  ~Checkpoint();
+  void initialize(const Parameters* pParams, const RectArray& vOriginal,
+		  RectArray* pRects, const NodeCount* pNodes,
+		  const boost::atomic<bool>* pCancel);
+  bool enabled() const;
+
+  /**
+   * Prepares for an attempt on the given box, loading its snapshot
+   * if there is one.
+   */
+
+  void begin(const BoxDimensions& b);
+
+  /**
+   * Called for every branch of the y search, just before the branch
+   * is searched.
+   *
+   * @return false if the branch has to be skipped.
+   */
+
+  bool enter(const Rectangle* r, Int nBegin, Int nEnd) {
+    if(!m_bEnabled) return(true);
+    UInt n(m_vBranches[m_nLevel]++);
+    if(n == 0) m_vFirst[m_nLevel] = r->m_nWidth;
+    if(m_bDetour && !detour(n, r, nBegin, nEnd)) return(false);
+    Step& s(m_vPath[m_nLevel]);
+    s.m_nBranch = n;
+    s.m_nID = r->m_nID;
+    s.m_nWidth = r->m_nWidth;
+    s.m_nHeight = r->m_nHeight;
+    s.m_nBegin = nBegin;
+    s.m_nEnd = nEnd;
+    m_vBranches[++m_nLevel] = 0;
+    if(--m_nPoll == 0) poll();
+    return(true);
+  }
+
+  /**
+   * Called when a branch accepted by enter() has been undone.
+   */
+
+  void leave() {
+    if(!m_bEnabled) return;
+    if(m_nInterrupted == 0 &&
+       (bQuit || m_pCancel->load(boost::memory_order_relaxed))) {
+      m_nInterrupted = m_nLevel;
+      m_bDetour = true;
+    }
+    --m_nLevel;
+  }
+
+  /**
+   * Concludes the attempt. A snapshot is saved if the search was
+   * interrupted by a signal, and removed if the box was decided or
+   * the attempt was cancelled.
+   */
+
+  void end();
+
+  /**
+   * True if the snapshot loaded by begin() didn't match the search,
+   * in which case the attempt must be repeated after calling
+   * discard().
+   */
+
+  bool mismatch() const;
+  void discard();
+
+ private:
+
+  /**
+   * A node on the path: the branch number among the children of its
+   * parent, followed by the rectangle and its y interval, and the
+   * width of the first child of its parent.
+   */
+
+  class Step {
+  public:
+    UInt m_nBranch;
+    UInt m_nFirst;
+    UInt m_nID;
+    UInt m_nWidth;
+    UInt m_nHeight;
+    Int m_nBegin;
+    Int m_nEnd;
+  };
+
+  bool detour(UInt n, const Rectangle* r, Int nBegin, Int nEnd);
+  void orient();
+  void poll();
+  bool load(const BoxDimensions& b);
+  void save(size_t nLevels);
+
+  bool m_bEnabled;
+  std::string m_sDir;
+  std::string m_sKey;
+  std::string m_sFile;
+  BoxDimensions m_Box;
+  time_t m_nPeriod;
+  time_t m_nNext;
+  UInt m_nPoll;
+  RectArray* m_pRects;
+  const NodeCount* m_pNodes;
+  const boost::atomic<bool>* m_pCancel;
+
+  /**
+   * The path to the current node, the number of branches generated
+   * so far at each of its levels, and the width of the first one.
+   */
+
+  std::vector<Step> m_vPath;
+  std::vector<UInt> m_vBranches;
+  std::vector<UInt> m_vFirst;
+  size_t m_nLevel;
+
+  /**
+   * enter() takes the slow path while we replay a snapshot, and once
+   * the search was interrupted (at the level m_nInterrupted) or the
+   * snapshot didn't match, after which it rejects every branch.
+   */
+
+  bool m_bDetour;
+  bool m_bReplaying;
+  bool m_bMismatch;
+  size_t m_nInterrupted;
+  std::vector<Step> m_vReplay;
+
+  /**
+   * The nodes searched in the earlier sessions of this box.
+   */
+
+  NodeCount m_Prior;
+};
+
+#endif // CHECKPOINT_H
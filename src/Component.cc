@@ -36,8 +36,16 @@ Component::Component() :
 }
 
 Component::~Component() {
-  if(m_pEmpty)
-    delete m_pEmpty;
+}
+
+void Component::reset() {
+  m_nX = 0;
+  m_nY = 0;
+  m_bEmpty = false;
+  m_bTopLevel = true;
+  m_Members.clear();
+  m_pRect = NULL;
+  m_pEmpty = NULL;
 }
 
 void Component::print() const {
@@ -47,7 +55,7 @@ void Component::print() const {
 	    << "empty=" << (m_bEmpty ? "y" : "n") << ", "
 	    << "top=" << (m_bTopLevel ? "y" : "n");
   if(!m_Members.empty()) {
-    std::set<Component*>::const_iterator i = m_Members.begin();
+    ComponentSet::const_iterator i = m_Members.begin();
     std::cout << ", contains={" << (*i)->m_nID;
     for(++i; i != m_Members.end(); ++i)
       std::cout << "," << (*i)->m_nID;
@@ -102,7 +110,7 @@ void Component::instantiate() {
     return;
   if(m_Dims.m_nWidth == (*m_Members.begin())->m_Dims.m_nWidth) {
     UInt nY(m_nY);
-    for(std::set<Component*>::iterator i = m_Members.begin();
+    for(ComponentSet::iterator i = m_Members.begin();
 	i != m_Members.end(); ++i) {
       (*i)->m_nX = m_nX;
       (*i)->m_nY = nY;
@@ -112,7 +120,7 @@ void Component::instantiate() {
   }
   else {
     UInt nX(m_nX);
-    for(std::set<Component*>::iterator i = m_Members.begin();
+    for(ComponentSet::iterator i = m_Members.begin();
 	i != m_Members.end(); ++i) {
       (*i)->m_nY = m_nY;
       (*i)->m_nX = nX;
@@ -126,14 +134,14 @@ void Component::instantiateX() {
   if(m_bEmpty || m_Members.empty())
     return;
   if(m_Dims.m_nWidth == (*m_Members.begin())->m_Dims.m_nWidth)
-    for(std::set<Component*>::iterator i = m_Members.begin();
+    for(ComponentSet::iterator i = m_Members.begin();
 	i != m_Members.end(); ++i) {
       (*i)->m_nX = m_nX;
       (*i)->instantiateX();
     }
   else {
     UInt nX(m_nX);
-    for(std::set<Component*>::iterator i = m_Members.begin();
+    for(ComponentSet::iterator i = m_Members.begin();
 	i != m_Members.end(); ++i) {
       (*i)->m_nX = nX;
       nX = (*i)->x2();
@@ -147,7 +155,7 @@ void Component::instantiateY() {
     return;
   if(m_Dims.m_nWidth == (*m_Members.begin())->m_Dims.m_nWidth) {
     UInt nY(m_nY);
-    for(std::set<Component*>::iterator i = m_Members.begin();
+    for(ComponentSet::iterator i = m_Members.begin();
 	i != m_Members.end(); ++i) {
       (*i)->m_nY = nY;
       nY = (*i)->y2();
@@ -155,7 +163,7 @@ void Component::instantiateY() {
     }
   }
   else
-    for(std::set<Component*>::iterator i = m_Members.begin();
+    for(ComponentSet::iterator i = m_Members.begin();
 	i != m_Members.end(); ++i) {
       (*i)->m_nY = m_nY;
       (*i)->instantiateY();
@@ -164,7 +172,7 @@ void Component::instantiateY() {
 
 bool Component::checkMembers() const {
   if(m_Members.size() < 2) return(false);
-  for(std::set<Component*>::const_iterator i = m_Members.begin();
+  for(ComponentSet::const_iterator i = m_Members.begin();
       i != m_Members.end(); ++i) {
     if(*i == NULL) return(false);
     if((*i)->m_nID >= m_nID) return(false);
@@ -202,7 +210,7 @@ bool Component::contains(const Rectangle* r) const {
   if(m_pRect == r)
     return(true);
   else
-    for(std::set<Component*>::const_iterator i = m_Members.begin();
+    for(ComponentSet::const_iterator i = m_Members.begin();
 	i != m_Members.end(); ++i)
       if((*i)->contains(r))
 	return(true);
@@ -213,7 +221,7 @@ const Rectangle* Component::getFirstRect() const {
   if(m_pRect)
     return(m_pRect);
   const Rectangle* pReturn(NULL);
-  for(std::set<Component*>::const_iterator i = m_Members.begin();
+  for(ComponentSet::const_iterator i = m_Members.begin();
       i != m_Members.end(); ++i) {
     pReturn = (*i)->getFirstRect();
     if(pReturn)
@@ -20,10 +20,10 @@
 #ifndef COMPONENT_H
 #define COMPONENT_H
 
+#include "ComponentSet.h"
 #include "Dimensions.h"
 #include "Integer.h"
 #include "Rational.h"
-#include <set>
 #include <map>
 
 class Component;
@@ -36,6 +36,14 @@ class Component {
  public:
   Component();
   ~Component();
+
+  /**
+   * Returns the component to the state of a freshly constructed one,
+   * keeping the storage of the member set. The empty space template
+   * is not owned by the component (see ComponentPtrs).
+   */
+
+  void reset();
   bool contains(const Rectangle*) const;
 
   /**
@@ -81,7 +89,7 @@ class Component {
   Dimensions m_Dims;
   bool m_bEmpty;
   bool m_bTopLevel;
-  std::set<Component*> m_Members;
+  ComponentSet m_Members;
   const Rectangle* m_pRect;
   EmptySpace* m_pEmpty;
 
@@ -27,16 +27,18 @@ ComponentPtrs::ComponentPtrs() {
 }
 
 ComponentPtrs::~ComponentPtrs() {
-  for(iterator i = begin(); i != end(); ++i)
-    delete *i;
 }
 
 void ComponentPtrs::clear() {
-  for(iterator i = begin(); i != end(); ++i)
-    delete *i;
+  m_Components.clear();
+  m_Empty.clear();
   std::deque<Component*>::clear();
 }
 
+Component* ComponentPtrs::allocate() {
+  return(m_Components.allocate());
+}
+
 void ComponentPtrs::getCumulativeProfile(std::map<UInt, UInt>& m) const {
   for(const_iterator i = begin(); i != end(); ++i) {
     const Component* c(*i);
@@ -132,7 +134,7 @@ void ComponentPtrs::instantiateY(const RectPtrArray::iterator& iBegin,
 }
 
 Component* ComponentPtrs::newEmptyUnit(const UInt& nX) {
-  Component* pNew = new Component();
+  Component* pNew = m_Components.allocate();
   pNew->m_nID = size();
   pNew->m_Dims.initialize(1, 1);
   pNew->m_nX = nX;
@@ -143,12 +145,12 @@ Component* ComponentPtrs::newEmptyUnit(const UInt& nX) {
 
 Component* ComponentPtrs::newEmptyTemplateX(const UInt& nX, const UInt& nWidth,
 					    const UInt& nMaxHeight) {
-  Component* pNew = new Component();
+  Component* pNew = m_Components.allocate();
   pNew->m_nID = size();
   pNew->m_Dims.initialize(nWidth, 1);
   pNew->m_nX = nX;
   pNew->m_bEmpty = true;
-  pNew->m_pEmpty = new EmptySpace();
+  pNew->m_pEmpty = m_Empty.allocate();
   pNew->m_pEmpty->m_nMaxHeight = nMaxHeight;
   pNew->m_pEmpty->m_nHeightLeft = nMaxHeight;
   push_back(pNew);
@@ -158,7 +160,7 @@ Component* ComponentPtrs::newEmptyTemplateX(const UInt& nX, const UInt& nWidth,
 Component* ComponentPtrs::newEmptyComponentX(const UInt& nX,
 					     const UInt& nWidth,
 					     const UInt& nHeight) {
-  Component* pNew = new Component();
+  Component* pNew = m_Components.allocate();
   pNew->m_nID = size();
   pNew->m_Dims.initialize(nWidth, nHeight);
   pNew->m_nX = nX;
@@ -168,7 +170,7 @@ Component* ComponentPtrs::newEmptyComponentX(const UInt& nX,
 }
 
 Component* ComponentPtrs::combineHorizontally(Component* p1, Component* p2) {
-  Component* pNew = new Component();
+  Component* pNew = m_Components.allocate();
   pNew->m_nID = size();
   pNew->m_Dims.initialize(p1->m_Dims.m_nWidth + p2->m_Dims.m_nWidth,
 			  p1->m_Dims.m_nHeight);
@@ -203,7 +205,7 @@ void ComponentPtrs::unforkEmptyX(Component* pEmpty, Component* pForked) {
   pEmpty->m_pEmpty->m_nHeightLeft += pForked->m_Dims.m_nHeight;
   pEmpty->m_pEmpty->m_Instantiations.erase(pForked);
   assert(pForked->m_nID == back()->m_nID);
-  delete back();
+  m_Components.pop();
   pop_back();
 }
 
@@ -22,10 +22,19 @@
 
 #include <deque>
 #include <map>
+#include "Arena.h"
+#include "Component.h"
+#include "EmptySpace.h"
 #include "Integer.h"
 #include "RectPtrArray.h"
 
-class Component;
+/**
+ * The components and empty space templates referenced by this array
+ * are owned by it, and are carved out of a pair of arenas. Components
+ * are created and destroyed in stack order during the search, so the
+ * backtracking in forkEmptyX/unforkEmptyX and the wholesale clear()
+ * between subproblems never touch the heap once the arenas are warm.
+ */
 
 class ComponentPtrs : public std::deque<Component*> {
  public:
@@ -34,6 +43,13 @@ class ComponentPtrs : public std::deque<Component*> {
   Component* contains(const Rectangle* r);
   void clear();
 
+  /**
+   * Allocates a component from the arena without adding it to the
+   * array. It remains valid until the next call to clear().
+   */
+
+  Component* allocate();
+
   /**
    * Creates a new empty component of unit width and height at
    * location nX.
@@ -99,6 +115,10 @@ class ComponentPtrs : public std::deque<Component*> {
   void instantiateY(const RectPtrArray::iterator& iBegin,
 		    const RectPtrArray::const_iterator& iEnd);
   void print() const;
+
+ private:
+  Arena<Component> m_Components;
+  Arena<EmptySpace> m_Empty;
 };
 
 #endif // COMPONENTPTRS_H
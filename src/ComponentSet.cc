@@ -17,24 +17,23 @@
  * along with rectpack. If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include "SingleStack.h"
+#include "ComponentSet.h"
+#include <algorithm>
 
-SingleStack::SingleStack() {
+ComponentSet::ComponentSet() {
 }
 
-SingleStack::~SingleStack() {
+ComponentSet::~ComponentSet() {
 }
 
-void SingleStack::push() {
-  m_vSize.push_back(size());
+void ComponentSet::insert(Component* c) {
+  iterator i = std::lower_bound(begin(), end(), c);
+  if(i == end() || *i != c)
+    boost::container::small_vector<Component*, 4>::insert(i, c);
 }
 
-void SingleStack::push(CompulsoryAssign* p) {
-  push_back(p);
-}
-
-void SingleStack::pop() {
-  while(size() > m_vSize.back())
-    pop_back();
-  m_vSize.pop_back();
+void ComponentSet::erase(Component* c) {
+  iterator i = std::lower_bound(begin(), end(), c);
+  if(i != end() && *i == c)
+    boost::container::small_vector<Component*, 4>::erase(i);
 }
@@ -0,0 +1,43 @@
+/**
+ * Copyright (C) 2011 Eric Huang
+ *
+ * This file is part of rectpack.
+ *
+ * rectpack is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * rectpack is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with rectpack. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef COMPONENTSET_H
+#define COMPONENTSET_H
+
+#include <boost/container/small_vector.hpp>
+
+class Component;
+
+/**
+ * A set of component pointers kept as a sorted array with inline
+ * storage for the first few elements. Composite components almost
+ * always have two or three members, so unlike a std::set this never
+ * allocates in the common case. Iteration order is the same as that
+ * of a std::set<Component*>.
+ */
+
+class ComponentSet : public boost::container::small_vector<Component*, 4> {
+ public:
+  ComponentSet();
+  ~ComponentSet();
+  void insert(Component* c);
+  void erase(Component* c);
+};
+
+#endif // COMPONENTSET_H
@@ -22,8 +22,6 @@
 
 #include "Compulsory.h"
 #include "Integer.h"
-#include "RefHeight.h"
-#include <map>
 #include <ostream>
 
 class CompulsoryAssign;
@@ -37,22 +35,14 @@ class CompulsoryAssign {
   virtual ~CompulsoryAssign();
   void print() const;
   const UInt& id() const;
-  Compulsory m_nValue;
-
-  /**
-   * Points to the left side of the compulsory part. This point will
-   * have to accommodate the area of the compulsory part.
-   */
-
-  std::map<UInt, RefHeight>::iterator m_iLeft;
 
   /**
-   * Points to the right side of the compulsory part. This point does
-   * NOT accommodate the area of the compulsory part, but instead
-   * represents almost an open endpoint.
+   * The compulsory part spans the control points at m_nValue.left()
+   * and m_nValue.right() of the cumulative profile, each of which
+   * holds one reference on behalf of this assignment.
    */
 
-  std::map<UInt, RefHeight>::iterator m_iRight;
+  Compulsory m_nValue;
 };
 
 std::ostream& operator<<(std::ostream& os,
@@ -0,0 +1,112 @@
+/**
+ * Copyright (C) 2011 Eric Huang
+ *
+ * This file is part of rectpack.
+ *
+ * rectpack is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * rectpack is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with rectpack. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CompulsoryAssign.h"
+#include "CompulsoryTrail.h"
+#include "Parameters.h"
+#include "Rectangle.h"
+
+CompulsoryTrail::CompulsoryTrail() :
+  m_nFrame(0),
+  m_nFrames(0) {
+}
+
+CompulsoryTrail::~CompulsoryTrail() {
+}
+
+void CompulsoryTrail::initialize(const Parameters* pParams) {
+  m_vEntries.reserve(pParams->m_vInstance.size() *
+		     pParams->m_vInstance.size() * 2);
+  m_vValues.reserve(pParams->m_vInstance.size() *
+		    pParams->m_vInstance.size() * 2);
+  m_vCheckpoints.reserve(pParams->m_vInstance.size() * 2 + 1);
+  m_vFrames.assign(pParams->m_vInstance.size(), 0);
+}
+
+void CompulsoryTrail::initialize(const BoxDimensions* pBox) {
+  m_vEntries.clear();
+  m_vValues.clear();
+  m_vCheckpoints.clear();
+  m_nFrame = ++m_nFrames;
+}
+
+void CompulsoryTrail::save(CompulsoryAssign* p) {
+  Checkpoint c;
+  c.m_nSize = m_vEntries.size();
+  c.m_nFrame = m_nFrame;
+  c.m_pAssign = p;
+  m_vCheckpoints.push_back(c);
+  m_nFrame = ++m_nFrames;
+}
+
+CompulsoryAssign* CompulsoryTrail::restore() {
+  CompulsoryAssign* p = m_vCheckpoints.back().m_pAssign;
+  m_nFrame = m_vCheckpoints.back().m_nFrame;
+  m_vCheckpoints.pop_back();
+  return(p);
+}
+
+bool CompulsoryTrail::empty() const {
+  return(m_vCheckpoints.back().m_nSize == m_vEntries.size());
+}
+
+const CompulsoryTrail::Entry& CompulsoryTrail::top() const {
+  return(m_vEntries.back());
+}
+
+const Compulsory& CompulsoryTrail::value() const {
+  return(m_vValues.back());
+}
+
+void CompulsoryTrail::pop() {
+  if(m_vEntries.back().m_nType == Value)
+    m_vValues.pop_back();
+  m_vEntries.pop_back();
+}
+
+void CompulsoryTrail::push(CompulsoryAssign* p) {
+  UInt& nFrame = m_vFrames[p->id()];
+  if(nFrame == m_nFrame) return;
+  nFrame = m_nFrame;
+  Entry e = { Value, m_vValues.size(), p };
+  m_vEntries.push_back(e);
+  m_vValues.push_back(p->m_nValue);
+}
+
+void CompulsoryTrail::pushInterval() {
+  Entry e = { Interval, 0, NULL };
+  m_vEntries.push_back(e);
+}
+
+void CompulsoryTrail::pushRemoval(size_t n, CompulsoryAssign* p) {
+  Entry e = { Removal, n, p };
+  m_vEntries.push_back(e);
+}
+
+void CompulsoryTrail::pushSingular() {
+  Entry e = { Singular, 0, NULL };
+  m_vEntries.push_back(e);
+}
+
+size_t CompulsoryTrail::capacity() const {
+  return(m_vEntries.capacity() * sizeof(Entry) +
+	 m_vValues.capacity() * sizeof(Compulsory) +
+	 m_vCheckpoints.capacity() * sizeof(Checkpoint) +
+	 m_vFrames.capacity() * sizeof(UInt));
+}
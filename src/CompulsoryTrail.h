@@ -0,0 +1,182 @@
+/**
+ * Copyright (C) 2011 Eric Huang
+ *
+ * This file is part of rectpack.
+ *
+ * rectpack is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * rectpack is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with rectpack. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef COMPULSORYTRAIL_H
+#define COMPULSORYTRAIL_H
+
+#include "Compulsory.h"
+#include "Integer.h"
+#include <cstddef>
+#include <vector>
+
+class BoxDimensions;
+class CompulsoryAssign;
+class Parameters;
+
+/**
+ * The undo trail of the Cumulative class. Every change that has to be
+ * reverted on backtracking is recorded here in chronological order,
+ * and each search depth opens a single checkpoint. Reverting a depth
+ * pops the entries back to its checkpoint, so backtracking costs time
+ * proportional to the number of changes, and once the vectors have
+ * grown to the deepest search path no memory is allocated.
+ */
+
+class CompulsoryTrail {
+ public:
+
+  /**
+   * The kinds of changes that are recorded.
+   */
+
+  enum Type {
+
+    /**
+     * The domain of a compulsory part was changed for the first time
+     * at this depth; value() returns its previous value.
+     */
+
+    Value,
+
+    /**
+     * A compulsory part was appended to the list of intervals.
+     */
+
+    Interval,
+
+    /**
+     * The interval at m_nIndex, m_pAssign, was removed by moving the
+     * last interval into its place.
+     */
+
+    Removal,
+
+    /**
+     * A compulsory part was appended to the list of singular values.
+     */
+
+    Singular
+  };
+
+  class Entry {
+  public:
+    Type m_nType;
+    size_t m_nIndex;
+    CompulsoryAssign* m_pAssign;
+  };
+
+  CompulsoryTrail();
+  virtual ~CompulsoryTrail();
+
+  /**
+   * Initializes the data structure by preallocating the maximum
+   * amount of memory that we expect to be using.
+   *
+   * @param pParams a pointer to the Parameters class object.
+   */
+
+  void initialize(const Parameters* pParams);
+  void initialize(const BoxDimensions* pBox);
+
+  /**
+   * Opens the checkpoint of a new search depth.
+   *
+   * @param p the compulsory part that is placed at this depth, or
+   * NULL if none is.
+   */
+
+  void save(CompulsoryAssign* p);
+
+  /**
+   * Closes the checkpoint of the current search depth. This must only
+   * be called once all of the entries of the depth have been popped.
+   *
+   * @return the compulsory part that was placed at this depth.
+   */
+
+  CompulsoryAssign* restore();
+
+  /**
+   * Returns whether or not all entries of the current depth have been
+   * popped.
+   */
+
+  bool empty() const;
+
+  /**
+   * Returns the next entry that should be reverted.
+   */
+
+  const Entry& top() const;
+
+  /**
+   * Returns the previous value recorded by the top entry, which must
+   * be of type Value.
+   */
+
+  const Compulsory& value() const;
+  void pop();
+
+  /**
+   * Records the current value of the given compulsory part, unless
+   * it was already recorded at this depth.
+   */
+
+  void push(CompulsoryAssign* p);
+  void pushInterval();
+  void pushRemoval(size_t n, CompulsoryAssign* p);
+  void pushSingular();
+
+  /**
+   * Returns the number of bytes held by the trail.
+   */
+
+  size_t capacity() const;
+
+ private:
+  class Checkpoint {
+  public:
+    size_t m_nSize;
+    UInt m_nFrame;
+    CompulsoryAssign* m_pAssign;
+  };
+
+  std::vector<Entry> m_vEntries;
+
+  /**
+   * The previous values are kept apart so that the entries remain
+   * plain data.
+   */
+
+  std::vector<Compulsory> m_vValues;
+  std::vector<Checkpoint> m_vCheckpoints;
+
+  /**
+   * The identifier of the current depth, and the identifier of the
+   * depth at which each rectangle's value was last recorded. Every
+   * new depth gets a fresh identifier, so this replaces clearing a
+   * set of recorded rectangles at every depth.
+   */
+
+  UInt m_nFrame;
+  UInt m_nFrames;
+  std::vector<UInt> m_vFrames;
+};
+
+#endif // COMPULSORYTRAIL_H
@@ -168,7 +168,7 @@ bool ConflictBT::orientation(RectPtrArray::iterator i,
 }
 
 bool ConflictBT::nextVariable(RectPtrArray::iterator i, UInt& nDeepest) {
-  if(bQuit) return(false);
+  if(cancelled()) return(false);
 
   /**
    * In the base case we're at the end of our packing sequence.
@@ -117,7 +117,7 @@ bool ConflictSums::packSingle(const Compulsory* c,
 
   SimpleSums ss;
   ss.insert(0);
-  for(SingleStack::const_iterator j = m_vX.singles().begin();
+  for(std::vector<CompulsoryAssign*>::const_iterator j = m_vX.singles().begin();
       j != m_vX.singles().end(); ++j)
     if((*j)->m_nValue.right() <= c->left())
       ss.insert((*j)->m_nValue.right());
@@ -132,7 +132,7 @@ bool ConflictSums::packSingle(const Compulsory* c,
      */
 
     SimpleSums ss2(ss);
-    for(FastRemove<CompulsoryAssign*>::const_iterator j = m_vX.intervals().begin();
+    for(std::vector<CompulsoryAssign*>::const_iterator j = m_vX.intervals().begin();
 	j != m_vX.intervals().end(); ++j)
       if((*j)->m_nValue.right() <= c->left())
 	ss2.add((*j)->m_nValue.m_pRect->m_nWidth, c->left());
@@ -174,7 +174,7 @@ bool ConflictSums::packSingle(const Compulsory* c,
 
     {
       SimpleSums ss2(ss); 
-      for(FastRemove<CompulsoryAssign*>::const_iterator j = m_vX.intervals().begin();
+      for(std::vector<CompulsoryAssign*>::const_iterator j = m_vX.intervals().begin();
 	  j != m_vX.intervals().end(); ++j)
 	if((*j)->m_nValue.right() <= c->left())
 	  ss2.add((*j)->m_nValue.m_pRect->m_nWidth, c->left());
@@ -207,7 +207,7 @@ bool ConflictSums::orientation(RectPtrArray::iterator i,
 }
 
 bool ConflictSums::nextVariable(RectPtrArray::iterator i, UInt& nDeepest) {
-  if(bQuit) return(false);
+  if(cancelled()) return(false);
 
   /**
    * In the base case we're at the end of our packing sequence.
@@ -42,13 +42,13 @@ void CornerValues::initialize(const AlignedCongruencies& above,
 }
 
 void CornerValues::erase(Component* c) {
-  operator[](Above)[c->m_nY][c->m_Dims].erase(c);
-  operator[](Below)[c->y2() - 1][c->m_Dims].erase(c);
+  operator[](Above)[c->m_nY].erase(c);
+  operator[](Below)[c->y2() - 1].erase(c);
 }
 
 void CornerValues::insert(Component* c) {
-  operator[](Above)[c->m_nY][c->m_Dims].insert(c);
-  operator[](Below)[c->y2() - 1][c->m_Dims].insert(c);
+  operator[](Above)[c->m_nY].insert(c);
+  operator[](Below)[c->y2() - 1].insert(c);
 }
 
 void CornerValues::print() const {
@@ -101,7 +101,7 @@ bool CorrectedIjcai::packY(RectPtrArray::iterator iBegin,
    * compression call.
    */
 
-  m_vY.m_vRectangles.push_back(r);
+  m_vY.place(r);
   if(m_pParams->breakVerticalSymmetry())
     m_Ranges.breakVerticalSymmetry(r, m_Box, m_pDomination);
   const Range* pRange = &m_Ranges.left(r, true, true);
@@ -111,12 +111,14 @@ bool CorrectedIjcai::packY(RectPtrArray::iterator iBegin,
 	r->yi.next(r->m_nHeight, pRange->ub())) {
       if(r->yi.m_nEnd > 0 && m_Ranges.m_vDomLeft[r->m_nID] &&
 	 m_pDomination->dominatedw1(r, r->yi.m_nEnd)) continue;
+      if(!m_Checkpoint.enter(r, r->yi.m_nBegin, r->yi.m_nEnd)) continue;
       m_Nodes.tick(YI);
       m_vY.m_vDomain[r->m_nID] = r->yi;
       m_vY.pushyi(r);
       if(waste(iBegin + 1, iEnd))
 	return(true);
       m_vY.popyi(r);
+      m_Checkpoint.leave();
     }
 
   pRange = &m_Ranges.middle(r, true, true);
@@ -125,12 +127,14 @@ bool CorrectedIjcai::packY(RectPtrArray::iterator iBegin,
 		   pRange->ub());
 	r->yi.valid(pRange->ub());
 	r->yi.next(r->m_nHeight, pRange->ub())) {
+      if(!m_Checkpoint.enter(r, r->yi.m_nBegin, r->yi.m_nEnd)) continue;
       m_Nodes.tick(YI);
       m_vY.m_vDomain[r->m_nID] = r->yi;
       m_vY.pushyi(r);
       if(waste(iBegin + 1, iEnd))
 	return(true);
       m_vY.popyi(r);
+      m_Checkpoint.leave();
     }
 
   if(!m_pParams->breakVerticalSymmetry()) {
@@ -142,12 +146,14 @@ bool CorrectedIjcai::packY(RectPtrArray::iterator iBegin,
 	if(r->yi.m_nEnd > 0 &&
 	   m_Box.m_nHeight - (r->yi.m_nEnd + r->m_nHeight) < m_pDomination->entriesw2(r) &&
 	   m_pDomination->dominatedw2(r, m_Box.m_nHeight - (r->yi.m_nEnd + r->m_nHeight))) continue;
+	if(!m_Checkpoint.enter(r, r->yi.m_nBegin, r->yi.m_nEnd)) continue;
 	m_Nodes.tick(YI);
 	m_vY.m_vDomain[r->m_nID] = r->yi;
 	m_vY.pushyi(r);
 	if(waste(iBegin + 1, iEnd))
 	  return(true);
 	m_vY.popyi(r);
+	m_Checkpoint.leave();
       }
   }
   return(false);
@@ -203,6 +209,7 @@ bool CorrectedIjcai::locLeft(Rectangle* r, RectPtrArray::iterator& iBegin,
 	continue;
       if((!m_Ranges.m_vDomLeft[r->m_nID] && r->yi.m_nEnd == 0) ||
 	 !m_vY.canFityi(r)) continue;
+      if(!m_Checkpoint.enter(r, r->yi.m_nBegin, r->yi.m_nEnd)) continue;
       m_Nodes.tick(YI);
       m_vY.m_vDomain[r->m_nID] = r->yi;
       m_vY.pushyi(r);
@@ -210,6 +217,7 @@ bool CorrectedIjcai::locLeft(Rectangle* r, RectPtrArray::iterator& iBegin,
 	if(waste(iBegin + 1, iEnd))
 	  return(true);
       m_vY.popyi(r);
+      m_Checkpoint.leave();
     }
   return(false);
 }
@@ -225,6 +233,7 @@ bool CorrectedIjcai::locMid(Rectangle* r, UInt nMinY,
 	r->yi.valid(pRange->ub());
 	r->yi.next(r->m_nHeight, pRange->ub())) {
       if(!m_vY.canFityi(r)) continue;
+      if(!m_Checkpoint.enter(r, r->yi.m_nBegin, r->yi.m_nEnd)) continue;
       m_Nodes.tick(YI);
       m_vY.m_vDomain[r->m_nID] = r->yi;
       m_vY.pushyi(r);
@@ -232,6 +241,7 @@ bool CorrectedIjcai::locMid(Rectangle* r, UInt nMinY,
 	if(waste(iBegin + 1, iEnd))
 	  return(true);
       m_vY.popyi(r);
+      m_Checkpoint.leave();
     }
   }
   return(false);
@@ -251,6 +261,7 @@ bool CorrectedIjcai::locRight(Rectangle* r, UInt nMinY,
 	 m_pDomination->dominatedw2(r, m_Box.m_nHeight - (r->yi.m_nEnd + r->m_nHeight))) continue;
       if((!m_Ranges.m_vDomRight[r->m_nID] && r->yi.m_nEnd + r->m_nHeight == m_Box.m_nHeight) ||
 	 !m_vY.canFityi(r)) continue;
+      if(!m_Checkpoint.enter(r, r->yi.m_nBegin, r->yi.m_nEnd)) continue;
       m_Nodes.tick(YI);
       m_vY.m_vDomain[r->m_nID] = r->yi;
       m_vY.pushyi(r);
@@ -258,6 +269,7 @@ bool CorrectedIjcai::locRight(Rectangle* r, UInt nMinY,
 	if(waste(iBegin + 1, iEnd))
 	  return(true);
       m_vY.popyi(r);
+      m_Checkpoint.leave();
     }
   }
   return(false);
@@ -277,7 +289,7 @@ bool CorrectedIjcai::packcra() {
 
 bool CorrectedIjcai::searchSpace(RectPtrArray::iterator iBegin,
 				 const RectPtrArray::const_iterator& iEnd) {
-  if(bQuit) return(false);
+  if(cancelled()) return(false);
   if(iBegin == iEnd) {
     RectPtrArray::iterator i = m_vRectPtrs.begin();
     for(; i != iBegin; ++i) {
@@ -314,13 +326,13 @@ UInt CorrectedIjcai::bestStripArea(Rectangle*& r) {
   if(!m_bVarOrder) return(std::numeric_limits<UInt>::max());
   
   UInt nMax(0);
-  for(std::vector<const Rectangle*>::const_iterator i = m_vY.m_vRectangles.begin();
+  const RectColumns& c(m_vY.m_vColumns);
+  for(std::vector<UInt>::const_iterator i = m_vY.m_vRectangles.begin();
       i != m_vY.m_vRectangles.end(); ++i) {
-    UInt t = (*i)->m_nWidth *
-      ((*i)->m_nHeight - m_vY.m_vDomain[(*i)->m_nID].m_nWidth);
+    UInt t = c.m_vWidth[*i] * (c.m_vHeight[*i] - m_vY.m_vDomain[*i].m_nWidth);
     if(t > nMax) {
       nMax = t;
-      r = m_vRectPtrs[(*i)->m_nID];
+      r = m_vRectPtrs[*i];
     }
   }
   return(nMax);
@@ -349,10 +361,12 @@ bool CorrectedIjcai::strips(Rectangle* r, RectPtrArray::iterator iBegin,
     }
 
     if(!m_vY.canFitStrips(r)) continue;
+    if(!m_Checkpoint.enter(r, r->y, r->y)) continue;
     m_vY.pushStripsy(r);
     if(m_vY.compress())
       if(waste(iBegin, iEnd)) return(true);
     m_vY.popStripsy(r);
+    m_Checkpoint.leave();
   }
   return(false);
 }
@@ -25,8 +25,10 @@
 #include "Packer.h"
 #include "Parameters.h"
 #include "Placements.h"
+#include "Probes.h"
 #include "Rectangle.h"
 #include "RectArray.h"
+#include <algorithm>
 #include <iomanip>
 
 Cumulative::Cumulative() :
@@ -46,9 +48,9 @@ void Cumulative::initialize(const Parameters* pParams) {
   m_vMaxHeight.resize(m_pPacker->m_nNonUnits);
   m_vRMaxHeight.clear();
   m_vRMaxHeight.resize(m_pPacker->m_nNonUnits);
-  m_vStack.initialize(pParams);
-  m_vCStack.clear();
-  m_vCStack.reserve(m_pPacker->m_nNonUnits);
+  m_vSingular.reserve(m_pPacker->m_nNonUnits);
+  m_vTrail.initialize(pParams);
+  reserve(2 * m_pPacker->m_nNonUnits + 2);
 }
 
 void Cumulative::initialize(const BoxDimensions* pBox) {
@@ -62,17 +64,14 @@ void Cumulative::initialize(const BoxDimensions* pBox) {
     m_vRMaxHeight[(*i)->m_nID] = pBox->m_nHeight -
       ((*i)->m_bRotated ? (*i)->m_nHeight : (*i)->m_nWidth);
   }
-  m_vStack.initialize(pBox);
-  m_vCStack.clear();
+  m_vTrail.initialize(pBox);
 
   /**
    * Now insert the box's begin and end points.
    */
 
-  std::map<UInt, RefHeight>::
-    insert(end(), value_type(UInt(0), RefHeight(UInt(0), 1)));
-  std::map<UInt, RefHeight>::
-    insert(end(), value_type(pBox->m_nWidth, RefHeight(UInt(0), 1)));
+  push_back(value_type(UInt(0), RefHeight(UInt(0), 1)));
+  push_back(value_type(pBox->m_nWidth, RefHeight(UInt(0), 1)));
 }
 
 void Cumulative::initialize(const Packer* pPacker) {
@@ -80,10 +79,9 @@ void Cumulative::initialize(const Packer* pPacker) {
 }
 
 bool Cumulative::canFit(const Compulsory& c) {
-  CompulsoryAssign* p(&m_vValues[c.m_pRect->m_nID]);
-  p->m_iLeft = --upper_bound(c.left());
-  p->m_iRight = p->m_iLeft;
-  bool bReturn = canFitR(p->m_iRight, c.right(),
+  size_t i = find(c.left());
+  if(i == size() || (*this)[i].first > c.left()) --i;
+  bool bReturn = canFitR(i, c.right(),
 			 c.m_pRect->m_bRotated ?
 			 m_vRMaxHeight[c.m_pRect->m_nID] :
 			 m_vMaxHeight[c.m_pRect->m_nID]);
@@ -91,20 +89,19 @@ bool Cumulative::canFit(const Compulsory& c) {
 }
 
 void Cumulative::push(const Rectangle* r, const UInt& n) {
-  m_vStack.save();
-  m_vCStack.push_back(NULL);
-  m_vCompulsory.push();
-  m_vSingular.push();
+  m_vTrail.save(NULL);
 
   CompulsoryAssign* p(&m_vValues[r->m_nID]);
   if(!p->m_nValue.m_nStart.isPoint()) {
-    m_vStack.push(p->m_nValue);
-    m_vSingular.push(p);
+    m_vTrail.push(p);
+    m_vSingular.push_back(p);
+    m_vTrail.pushSingular();
 
     /**
      * Set the coordinates.
      */
 
+    UInt nLeft(p->m_nValue.left()), nRight(p->m_nValue.right());
     p->m_nValue.m_nStart = n;
     p->m_nValue.m_nEnd = n + r->m_nWidth;
 
@@ -112,84 +109,106 @@ void Cumulative::push(const Rectangle* r, const UInt& n) {
      * Extend both left and right.
      */
 
-    extendL(p->m_iLeft, p->m_nValue.m_nStart.m_nLeft, r->m_nHeight);
-    extendR(p->m_iRight, p->m_nValue.m_nEnd.m_nLeft, r->m_nHeight);
+    extendL(nLeft, p->m_nValue.m_nStart.m_nLeft, r->m_nHeight);
+    extendR(nRight, p->m_nValue.m_nEnd.m_nLeft, r->m_nHeight);
   }
 }
 
 void Cumulative::push(const Compulsory& c) {
   CompulsoryAssign* p(&m_vValues[c.m_pRect->m_nID]);
   p->m_nValue = c;
-  p->m_iLeft = insert(c.left()).first;
-  p->m_iRight = insert(c.right()).first;
   pushAux(p);
 }
 
 void Cumulative::pushHinted(const Compulsory& c) {
-  CompulsoryAssign* p(&m_vValues[c.m_pRect->m_nID]);
-  p->m_nValue = c;
-  p->m_iLeft = insert(p->m_iLeft, c.left());
-  p->m_iRight = insert(p->m_iRight, c.right());
-  pushAux(p);
+
+  /**
+   * Binary search over the flat profile is cheap enough that there
+   * is nothing to gain from the hints left by canFit.
+   */
+
+  push(c);
 }
 
 void Cumulative::pushAux(CompulsoryAssign* p) {
 
   /**
-   * Check to see if the left and right pointers are new control
-   * points. If so, we must copy the previous heights as appropriate
-   * (because these new control points should start with a height
-   * value that is consistent with what was already implied).
+   * Insert the left and right endpoints as control points. New
+   * control points start with the height of their predecessors
+   * (because they should start with a height value that is
+   * consistent with what was already implied). Inserting the right
+   * endpoint never moves the left one.
    */
 
-  if(p->m_iLeft->second.m_nReferences == 0) {
-    iterator i = p->m_iLeft; --i;
-    p->m_iLeft->second.m_nHeight = i->second.m_nHeight;
-  }
-  if(p->m_iRight->second.m_nReferences == 0) {
-    iterator i = p->m_iRight; --i;
-    p->m_iRight->second.m_nHeight = i->second.m_nHeight;
-  }
+  size_t nLeft = insert(p->m_nValue.left());
+  size_t nRight = insert(p->m_nValue.right());
+  for(size_t i = nLeft; i < nRight; ++i)
+    (*this)[i].second.m_nHeight += p->m_nValue.m_pRect->m_nHeight;
+  ++(*this)[nLeft].second.m_nReferences;
+  ++(*this)[nRight].second.m_nReferences;
 
-  for(iterator i = p->m_iLeft; i != p->m_iRight; ++i)
-    i->second.m_nHeight += p->m_nValue.m_pRect->m_nHeight;
-  ++p->m_iLeft->second.m_nReferences;
-  ++p->m_iRight->second.m_nReferences;
-
-  m_vStack.save();
-  m_vCStack.push_back(p);
-  m_vCompulsory.push();
-  m_vSingular.push();
-  if(!p->m_nValue.isFull())
+  m_vTrail.save(p);
+  if(!p->m_nValue.isFull()) {
     m_vCompulsory.push_back(p);
-  else
+    m_vTrail.pushInterval();
+  }
+  else {
     m_vSingular.push_back(p);
+    m_vTrail.pushSingular();
+  }
+}
+
+void Cumulative::settle(size_t i) {
+  CompulsoryAssign* p = m_vCompulsory[i];
+  m_vTrail.pushRemoval(i, p);
+  m_vCompulsory[i] = m_vCompulsory.back();
+  m_vCompulsory.pop_back();
+  m_vSingular.push_back(p);
+  m_vTrail.pushSingular();
 }
 
 void Cumulative::pop() {
-  while(!m_vStack.empty()) {
-    UInt nID(m_vStack.top().m_pRect->m_nID);
-    pop(m_vValues[nID], m_vStack.top());
-    m_vValues[nID].m_nValue = m_vStack.top();
-    m_vStack.pop();
+  while(!m_vTrail.empty()) {
+    const CompulsoryTrail::Entry& e = m_vTrail.top();
+    switch(e.m_nType) {
+    case CompulsoryTrail::Value:
+      pop(*e.m_pAssign, m_vTrail.value());
+      e.m_pAssign->m_nValue = m_vTrail.value();
+      break;
+    case CompulsoryTrail::Interval:
+      m_vCompulsory.pop_back();
+      break;
+    case CompulsoryTrail::Removal:
+      m_vCompulsory.push_back(m_vCompulsory[e.m_nIndex]);
+      m_vCompulsory[e.m_nIndex] = e.m_pAssign;
+      break;
+    case CompulsoryTrail::Singular:
+      m_vSingular.pop_back();
+      break;
+    }
+    m_vTrail.pop();
   }
-  m_vStack.restore();
-  m_vCompulsory.pop();
-  m_vSingular.pop();
 
   /**
    * Now completely remove the last compulsory part that this stack
    * frame is associated with.
    */
 
-  CompulsoryAssign* p(m_vCStack.back());
-  m_vCStack.pop_back();
+  CompulsoryAssign* p(m_vTrail.restore());
   if(p) {
     const Rectangle* r(p->m_nValue.m_pRect);
-    for(iterator i = p->m_iLeft; i != p->m_iRight; ++i)
-      i->second.m_nHeight -= r->m_nHeight;
-    dereference(p->m_iLeft);
-    dereference(p->m_iRight);
+    size_t nLeft = find(p->m_nValue.left());
+    size_t nRight = find(p->m_nValue.right());
+    for(size_t i = nLeft; i < nRight; ++i)
+      (*this)[i].second.m_nHeight -= r->m_nHeight;
+
+    /**
+     * Release the right endpoint first so that erasing it cannot
+     * move the left one.
+     */
+
+    dereference(nRight);
+    dereference(find(p->m_nValue.left()));
   }
 }
 
@@ -203,13 +222,12 @@ void Cumulative::pop(CompulsoryAssign& ca, const Compulsory& c) {
    */
   
   if(ca.m_nValue.m_nStart.m_nRight != c.m_nStart.m_nRight) {
-    iterator i = ca.m_iLeft;
-    iterator j = insert(c.m_nStart.m_nRight).first;
-    ++j->second.m_nReferences;
-    for(iterator k = i; k != j; ++k)
-      k->second.m_nHeight -= c.m_pRect->m_nHeight;
+    size_t i = find(ca.m_nValue.left());
+    size_t j = insert(c.m_nStart.m_nRight);
+    ++(*this)[j].second.m_nReferences;
+    for(size_t k = i; k < j; ++k)
+      (*this)[k].second.m_nHeight -= c.m_pRect->m_nHeight;
     dereference(i);
-    ca.m_iLeft = j;
     ca.m_nValue.m_nStart.m_nRight = c.m_nStart.m_nRight;
     ca.m_nValue.m_nEnd.m_nRight = c.m_nEnd.m_nRight;
   }
@@ -222,19 +240,19 @@ void Cumulative::pop(CompulsoryAssign& ca, const Compulsory& c) {
    */
 
   if(ca.m_nValue.m_nEnd.m_nLeft != c.m_nEnd.m_nLeft) {
-    iterator i = insert(c.m_nEnd.m_nLeft).first;
-    iterator j = ca.m_iRight;
-    ++i->second.m_nReferences;
-    for(iterator k = i; k != j; ++k)
-      k->second.m_nHeight -= c.m_pRect->m_nHeight;
+    size_t i = insert(c.m_nEnd.m_nLeft);
+    size_t j = find(ca.m_nValue.right());
+    ++(*this)[i].second.m_nReferences;
+    for(size_t k = i; k < j; ++k)
+      (*this)[k].second.m_nHeight -= c.m_pRect->m_nHeight;
     dereference(j);
-    ca.m_iRight = i;
     ca.m_nValue.m_nEnd.m_nLeft = c.m_nEnd.m_nLeft;
     ca.m_nValue.m_nStart.m_nLeft = c.m_nStart.m_nLeft;
   }
 }
 
 bool Cumulative::propagate() {
+  PROBE(PROBE_PROPAGATE);
 
   /**
    * Loop until we've emptied both queues.
@@ -247,8 +265,7 @@ bool Cumulative::propagate() {
     while(i < m_vCompulsory.size()) {
       CompulsoryAssign* p = m_vCompulsory[i];
       if(p->m_nValue.isFull()) {
-	m_vCompulsory.remove(i);
-	m_vSingular.push_back(p);
+	settle(i);
 	continue;
       }
 
@@ -260,8 +277,7 @@ bool Cumulative::propagate() {
       if(n == -1) return(false);
       if(n == 1) bUpdated = true;
       if(p->m_nValue.isFull()) {
-	m_vCompulsory.remove(i);
-	m_vSingular.push_back(p);
+	settle(i);
 	continue;
       }
 
@@ -273,8 +289,7 @@ bool Cumulative::propagate() {
       if(n == -1) return(false);
       if(n == 1) bUpdated = true;
       if(p->m_nValue.isFull()) {
-	m_vCompulsory.remove(i);
-	m_vSingular.push_back(p);
+	settle(i);
 	continue;
       }
       ++i;
@@ -294,7 +309,7 @@ int Cumulative::propagateLeft(CompulsoryAssign* p) {
   UInt* pMax(r->m_bRotated ?
 	     &m_vRMaxHeight[p->id()] :
 	     &m_vMaxHeight[p->id()]);
-  iterator iHint = p->m_iLeft;
+  size_t iHint = find(p->m_nValue.left());
   if(canFitL(iHint, p->m_nValue.m_nStart.m_nLeft, *pMax)) return(0);
 
   /**
@@ -306,9 +321,10 @@ int Cumulative::propagateLeft(CompulsoryAssign* p) {
    */
 
   ++iHint;
-  UInt nNewLeft(iHint->first);
-  UInt nExtension(iHint->first + r->m_nWidth);
-  iHint = p->m_iRight;
+  UInt nNewLeft((*this)[iHint].first);
+  UInt nExtension((*this)[iHint].first + r->m_nWidth);
+  UInt nRight(p->m_nValue.right());
+  iHint = find(nRight);
   if(!canFitR(iHint, nExtension, *pMax)) return(-1);
 
   /**
@@ -318,10 +334,10 @@ int Cumulative::propagateLeft(CompulsoryAssign* p) {
    * Cumulative map.
    */
 
-  m_vStack.push(p->m_nValue);
+  m_vTrail.push(p);
   p->m_nValue.m_nStart.m_nLeft = nNewLeft;
   p->m_nValue.m_nEnd.m_nLeft = nExtension;
-  extendR(p->m_iRight, nExtension, iHint, r->m_nHeight);
+  extendR(nRight, nExtension, r->m_nHeight);
   return(1);
 }
 
@@ -336,7 +352,7 @@ int Cumulative::propagateRight(CompulsoryAssign* p) {
   UInt* pMax(r->m_bRotated ?
 	     &m_vRMaxHeight[p->id()] :
 	     &m_vMaxHeight[p->id()]);
-  iterator iHint = p->m_iRight;
+  size_t iHint = find(p->m_nValue.right());
   if(canFitR(iHint, p->m_nValue.m_nEnd.m_nRight, *pMax)) return(0);
 
   /**
@@ -347,9 +363,10 @@ int Cumulative::propagateRight(CompulsoryAssign* p) {
    * new missing intervals into both skip lists.
    */
 
-  UInt nNewRight(iHint->first);
-  UInt nExtension(iHint->first - r->m_nWidth);
-  iHint = p->m_iLeft;
+  UInt nNewRight((*this)[iHint].first);
+  UInt nExtension((*this)[iHint].first - r->m_nWidth);
+  UInt nLeft(p->m_nValue.left());
+  iHint = find(nLeft);
   if(!canFitL(iHint, nExtension, *pMax)) return(-1);
 
   /**
@@ -359,23 +376,23 @@ int Cumulative::propagateRight(CompulsoryAssign* p) {
    * Cumulative map.
    */
 
-  m_vStack.push(p->m_nValue);
+  m_vTrail.push(p);
   p->m_nValue.m_nEnd.m_nRight = nNewRight;
   p->m_nValue.m_nStart.m_nRight = nExtension;
-  extendL(p->m_iLeft, nExtension, iHint, r->m_nHeight);
+  extendL(nLeft, nExtension, r->m_nHeight);
   return(1);
 }
 
-bool Cumulative::canFitR(iterator& iHint, const UInt& j,
+bool Cumulative::canFitR(size_t& iHint, const UInt& j,
 			 const UInt& nMaxHeight) {
-  for(; iHint->first < j; ++iHint)  {
-    if(iHint->second.m_nHeight > nMaxHeight)
+  for(; (*this)[iHint].first < j; ++iHint)  {
+    if((*this)[iHint].second.m_nHeight > nMaxHeight)
       return(false);
   }
   return(true);
 }
 
-bool Cumulative::canFitL(iterator& iHint, const UInt& j,
+bool Cumulative::canFitL(size_t& iHint, const UInt& j,
 			 const UInt& nMaxHeight) {
 
   /**
@@ -384,8 +401,8 @@ bool Cumulative::canFitL(iterator& iHint, const UInt& j,
    * downward.
    */
 
-  for(--iHint; iHint->first > j; --iHint)
-    if(iHint->second.m_nHeight > nMaxHeight)
+  for(--iHint; (*this)[iHint].first > j; --iHint)
+    if((*this)[iHint].second.m_nHeight > nMaxHeight)
       return(false);
 
   /**
@@ -395,55 +412,35 @@ bool Cumulative::canFitL(iterator& iHint, const UInt& j,
    * the same thing.
    */
 
-  return(iHint->second.m_nHeight <= nMaxHeight);
+  return((*this)[iHint].second.m_nHeight <= nMaxHeight);
 }
 
-bool Cumulative::dereference(const iterator& i) {
-  if(--i->second.m_nReferences == 0) {
-    erase(i);
+bool Cumulative::dereference(size_t i) {
+  if(--(*this)[i].second.m_nReferences == 0) {
+    erase(begin() + i);
     return(true);
   }
   return(false);
 }
 
-void Cumulative::extendL(iterator& iCurrent, const UInt& nDest,
-			 iterator& iHint, const UInt& nHeight) {
-  iHint = insert(iHint, nDest);
-  ++iHint->second.m_nReferences;
-  for(iterator i = iHint; i != iCurrent; ++i) // Iterates forward (same thing).
-    i->second.m_nHeight += nHeight;
-  dereference(iCurrent);
-  iCurrent = iHint;
-}
-
-void Cumulative::extendL(iterator& iCurrent, const UInt& nDest,
+void Cumulative::extendL(const UInt& nCurrent, const UInt& nDest,
 			 const UInt& nHeight) {
-  iterator iHint(insert(iCurrent, nDest));
-  ++iHint->second.m_nReferences;
-  for(iterator i = iHint; i != iCurrent; ++i) // Iterates forward (same thing).
-    i->second.m_nHeight += nHeight;
+  size_t iDest = insert(nDest);
+  ++(*this)[iDest].second.m_nReferences;
+  size_t iCurrent = find(nCurrent);
+  for(size_t i = iDest; i < iCurrent; ++i) // Iterates forward (same thing).
+    (*this)[i].second.m_nHeight += nHeight;
   dereference(iCurrent);
-  iCurrent = iHint;
 }
 
-void Cumulative::extendR(iterator& iCurrent, const UInt& nDest,
-			 iterator& iHint, const UInt& nHeight) {
-  iHint = insert(iHint, nDest);
-  ++iHint->second.m_nReferences;
-  for(iterator i = iCurrent; i != iHint; ++i)
-    i->second.m_nHeight += nHeight;
-  dereference(iCurrent);
-  iCurrent = iHint;
-}
-
-void Cumulative::extendR(iterator& iCurrent, const UInt& nDest,
+void Cumulative::extendR(const UInt& nCurrent, const UInt& nDest,
 			 const UInt& nHeight) {
-  iterator iHint = insert(iCurrent, nDest);
-  ++iHint->second.m_nReferences;
-  for(iterator i = iCurrent; i != iHint; ++i)
-    i->second.m_nHeight += nHeight;
+  size_t iDest = insert(nDest);
+  ++(*this)[iDest].second.m_nReferences;
+  size_t iCurrent = find(nCurrent);
+  for(size_t i = iCurrent; i < iDest; ++i)
+    (*this)[i].second.m_nHeight += nHeight;
   dereference(iCurrent);
-  iCurrent = iHint;
 }
 
 void Cumulative::largestAreaPlacement(UInt& n,
@@ -451,7 +448,7 @@ void Cumulative::largestAreaPlacement(UInt& n,
   n = 0;
   if(m_vCompulsory.empty()) c = NULL;
   else
-    for(FastRemove<CompulsoryAssign*>::const_iterator i = m_vCompulsory.begin();
+    for(std::vector<CompulsoryAssign*>::const_iterator i = m_vCompulsory.begin();
 	i != m_vCompulsory.end(); ++i) {
       const Compulsory* d = &(*i)->m_nValue;
       UInt m(d->carea());
@@ -474,34 +471,22 @@ UInt Cumulative::epsilon() const {
   return(nMin);
 }
 
-std::pair<Cumulative::iterator, bool>
-Cumulative::insert(const key_type& x) {
-  if(x == 0)
-    return(std::pair<Cumulative::iterator, bool>(begin(), false));
-  else {
-    std::pair<Cumulative::iterator, bool> r
-      (std::map<UInt, RefHeight>::insert(value_type(x, RefHeight())));
-    if(r.second) {
-      iterator iPrevious(r.first);
-      --iPrevious;
-      r.first->second.m_nHeight = iPrevious->second.m_nHeight;
-    }
-    return(r);
-  }
+static bool lessPoint(const std::pair<UInt, RefHeight>& a,
+		      const UInt& b) {
+  return(a.first < b);
 }
 
-Cumulative::iterator
-Cumulative::insert(iterator pos, const key_type& x) {
-  if(x == 0) return(begin());
-  else {
-    pos = std::map<UInt, RefHeight>::insert(pos, value_type(x, RefHeight()));
-    if(pos->second.m_nReferences == 0) {
-      iterator iPrevious(pos);
-      --iPrevious;
-      pos->second.m_nHeight = iPrevious->second.m_nHeight;
-    }
-    return(pos);
-  }
+size_t Cumulative::find(const UInt& x) const {
+  return(std::lower_bound(begin(), end(), x, lessPoint) - begin());
+}
+
+size_t Cumulative::insert(const UInt& x) {
+  if(x == 0) return(0);
+  size_t i = find(x);
+  if(i == size() || (*this)[i].first != x)
+    std::vector<value_type>::insert(begin() + i,
+				    value_type(x, RefHeight((*this)[i - 1].second.m_nHeight, 0)));
+  return(i);
 }
 
 void Cumulative::print() const {
@@ -583,12 +568,14 @@ bool Cumulative::validAux(const const_iterator& j) const {
 }
 
 bool Cumulative::valid() const {
-  for(std::vector<CompulsoryAssign*>::const_iterator i = m_vCStack.begin();
-      i != m_vCStack.end(); ++i) {
-    if(*i) {
-      if(!valid((*i)->m_iLeft)) return(false);
-      if(!valid((*i)->m_iRight)) return(false);
-    }
+  return(valid(m_vCompulsory) && valid(m_vSingular));
+}
+
+bool Cumulative::valid(const std::vector<CompulsoryAssign*>& v) const {
+  for(std::vector<CompulsoryAssign*>::const_iterator i = v.begin();
+      i != v.end(); ++i) {
+    if(!valid(begin() + find((*i)->m_nValue.left()))) return(false);
+    if(!valid(begin() + find((*i)->m_nValue.right()))) return(false);
   }
   return(true);
 }
@@ -597,10 +584,17 @@ const std::vector<CompulsoryAssign>& Cumulative::values() const {
   return(m_vValues);
 }
 
-const FastRemove<CompulsoryAssign*>& Cumulative::intervals() const {
+const std::vector<CompulsoryAssign*>& Cumulative::intervals() const {
   return(m_vCompulsory);
 }
 
-const SingleStack& Cumulative::singles() const {
+const std::vector<CompulsoryAssign*>& Cumulative::singles() const {
   return(m_vSingular);
 }
+
+size_t Cumulative::capacity() const {
+  return(std::vector<value_type>::capacity() * sizeof(value_type) +
+	 m_vCompulsory.capacity() * sizeof(CompulsoryAssign*) +
+	 m_vSingular.capacity() * sizeof(CompulsoryAssign*) +
+	 m_vTrail.capacity());
+}
@@ -21,12 +21,10 @@
 #define CUMULATIVE_H
 
 #include "CompulsoryAssign.h"
-#include "FastRemove.h"
+#include "CompulsoryTrail.h"
 #include "Integer.h"
 #include "RefHeight.h"
-#include "SingleStack.h"
-#include "ValueStack.h"
-#include <map>
+#include <utility>
 #include <vector>
 
 class BoxDimensions;
@@ -37,7 +35,20 @@ class IntPlacements;
 class Placements;
 class Rectangle;
 
-class Cumulative : public std::map<UInt, RefHeight> {
+/**
+ * The cumulative profile is kept as a flat array of control points
+ * sorted by their x-coordinates. Each control point holds the
+ * cumulative height from its coordinate up to the next control
+ * point, and a reference count of the compulsory part endpoints that
+ * rest on it. There are only ever a few dozen control points, so
+ * binary search and shifting the array on insertion is much cheaper
+ * than chasing the nodes of a balanced tree, and the range updates
+ * walk contiguous memory. Positions in the array are not stable
+ * across insertions, so compulsory parts refer to their endpoints by
+ * coordinate rather than by position.
+ */
+
+class Cumulative : public std::vector<std::pair<UInt, RefHeight> > {
  public:
   Cumulative();
   virtual ~Cumulative();
@@ -109,8 +120,15 @@ class Cumulative : public std::map<UInt, RefHeight> {
   void get(Placements& v) const;
   void get(IntPlacements& v) const;
   const std::vector<CompulsoryAssign>& values() const;
-  const FastRemove<CompulsoryAssign*>& intervals() const;
-  const SingleStack& singles() const;
+  const std::vector<CompulsoryAssign*>& intervals() const;
+  const std::vector<CompulsoryAssign*>& singles() const;
+
+  /**
+   * Returns the number of bytes held by the profile and its undo
+   * trail. These only grow while the search goes deeper than before.
+   */
+
+  size_t capacity() const;
 
  private:
 
@@ -121,6 +139,13 @@ class Cumulative : public std::map<UInt, RefHeight> {
 
   void pushAux(CompulsoryAssign* p);
 
+  /**
+   * Moves the interval at the given index to the singular values,
+   * recording both changes on the trail.
+   */
+
+  void settle(size_t i);
+
   /**
    * Removes the current Compulsory class object and rolls it back to
    * the previous one. We expect to actually modify the current data
@@ -160,40 +185,17 @@ class Cumulative : public std::map<UInt, RefHeight> {
    * the left. This function updates the cumulative profile to reflect
    * this growth.
    *
-   * @param iCurrent an iterator pointing to the current left endpoint
-   * of the compulsory part.
+   * @param nCurrent the current left endpoint of the compulsory part.
    *
    * @param nDest the final value of the left endpoint that we should
    * grow the compulsory part to.
    *
-   * @param iHint an iterator pointing to a location close to where
-   * the eventual location of the left endpoint should be.
-   *
    * @param nHeight the height of the rectangle that will be added to
    * the compulsory profile along the left of the current compulsory
    * part.
    */
 
-  void extendL(iterator& iCurrent, const UInt& nDest,
-	       iterator& iHint, const UInt& nHeight);
-
-  /**
-   * After constraining the domain, the compulsory part may grow to
-   * the left. This function updates the cumulative profile to reflect
-   * this growth.
-   *
-   * @param iCurrent an iterator pointing to the current left endpoint
-   * of the compulsory part.
-   *
-   * @param nDest the final value of the left endpoint that we should
-   * grow the compulsory part to.
-   *
-   * @param nHeight the height of the rectangle that will be added to
-   * the compulsory profile along the left of the current compulsory
-   * part.
-   */
-
-  void extendL(iterator& iCurrent, const UInt& nDest,
+  void extendL(const UInt& nCurrent, const UInt& nDest,
 	       const UInt& nHeight);
 
   /**
@@ -201,30 +203,8 @@ class Cumulative : public std::map<UInt, RefHeight> {
    * the right. This function updates the cumulative profile to
    * reflect this growth.
    *
-   * @param iCurrent an iterator pointing to the current right
-   * endpoint of the compulsory part.
-   *
-   * @param nDest the final value of the right endpoint that we should
-   * grow the compulsory part to.
-   *
-   * @param iHint an iterator pointing to a location close to where
-   * the eventual location of the right endpoint should be.
-   *
-   * @param nHeight the height of the rectangle that will be added to
-   * the compulsory profile along the right of the current compulsory
+   * @param nCurrent the current right endpoint of the compulsory
    * part.
-   */
-
-  void extendR(iterator& iCurrent, const UInt& nDest,
-	       iterator& iHint, const UInt& nHeight);
-
-  /**
-   * After constraining the domain, the compulsory part may grow to
-   * the right. This function updates the cumulative profile to
-   * reflect this growth.
-   *
-   * @param iCurrent an iterator pointing to the current right
-   * endpoint of the compulsory part.
    *
    * @param nDest the final value of the right endpoint that we should
    * grow the compulsory part to.
@@ -234,29 +214,29 @@ class Cumulative : public std::map<UInt, RefHeight> {
    * part.
    */
 
-  void extendR(iterator& iCurrent, const UInt& nDest,
+  void extendR(const UInt& nCurrent, const UInt& nDest,
 	       const UInt& nHeight);
   
   /**
-   * Decrements the reference counter at the given iterator, and
-   * removes the object if the reference count is 0.
+   * Decrements the reference counter of the given control point, and
+   * removes it if the reference count is 0.
    *
-   * @param i an iterator pointing to the object to dereference.
+   * @param i the index of the control point to dereference.
    *
    * @return true if the reference count is 0 and the object is
    * removed, and false otherwise.
    */
 
-  bool dereference(const iterator& i);
+  bool dereference(size_t i);
 
   /**
-   * Given a starting iterator iHint, iterates over the control points
+   * Given a starting index iHint, iterates over the control points
    * up to j, checking all intermediary points to ensure they are not
    * greater than the maximum allowable height. This function attempts
    * to check to see if we can extend the compulsory part to the
    * right.
    *
-   * @param iHint the iterator from which we should start the search,
+   * @param iHint the index from which we should start the search,
    * the current right endpoint of the compulsory part. This point is
    * assumed to be open. If it is possible to extend the compulsory
    * part, then this parameter also will return a hint to where the
@@ -273,17 +253,17 @@ class Cumulative : public std::map<UInt, RefHeight> {
    * forward, and false otherwise.
    */
 
-  bool canFitR(iterator& iHint, const UInt& j,
+  bool canFitR(size_t& iHint, const UInt& j,
 	       const UInt& nMaxHeight);
 
   /**
-   * Given a starting iterator iHint, iterates over the control points
+   * Given a starting index iHint, iterates over the control points
    * down to j, checking all intermediary points to ensure they are
    * not greater than the maximum allowable height. This function
    * attempts to check to see if we can still extend the compulsory
    * part to the left.
    *
-   * @param iHint the iterator from which we should start the search,
+   * @param iHint the index from which we should start the search,
    * the current left endpoint of the compulsory part. This point is
    * assumed to be closed. If it is possible to extend the compulsory
    * part, then this parameter also will return a hint to where the
@@ -301,7 +281,7 @@ class Cumulative : public std::map<UInt, RefHeight> {
    * backward, and false otherwise.
    */
 
-  bool canFitL(iterator& iHint, const UInt& j,
+  bool canFitL(size_t& iHint, const UInt& j,
 	       const UInt& nMaxHeight);
 
   /**
@@ -325,14 +305,19 @@ class Cumulative : public std::map<UInt, RefHeight> {
   void enqueueL(const UInt& n);
 
   /**
-   * Both the UInt as well as the RefHeight are required to
-   * insert a value pair, so we are simply assuming default
-   * construction for RefHeight by providing these overloaded
-   * functions.
+   * Returns the index of the first control point that is not less
+   * than x.
+   */
+
+  size_t find(const UInt& x) const;
+
+  /**
+   * Returns the index of the control point at x, creating it with
+   * the height of its predecessor and no references if it doesn't
+   * exist yet.
    */
 
-  std::pair<iterator, bool> insert(const key_type& x);
-  iterator insert(iterator pos, const key_type& x);
+  size_t insert(const UInt& x);
 
   /**
    * Prints a graphical representation of the cumulative solution.
@@ -346,6 +331,7 @@ class Cumulative : public std::map<UInt, RefHeight> {
   void print(iterator j) const;
   void printAux(const_iterator j) const;
   bool valid() const;
+  bool valid(const std::vector<CompulsoryAssign*>& v) const;
   bool valid(const iterator& j) const;
   bool valid(const const_iterator& j) const;
   bool validAux(const const_iterator& j) const;
@@ -363,16 +349,15 @@ class Cumulative : public std::map<UInt, RefHeight> {
    * strips and need to be checked during constraint propagation.
    */
 
-  FastRemove<CompulsoryAssign*> m_vCompulsory;
-
+  std::vector<CompulsoryAssign*> m_vCompulsory;
 
   /**
-   * A stack that tracks the current ste of CompulsoryAssign class
-   * objects representing compulsory parts that have actually either
-   * been placed or propagated to singular values.
+   * The CompulsoryAssign class objects representing compulsory parts
+   * that have actually either been placed or propagated to singular
+   * values.
    */
 
-  SingleStack m_vSingular;
+  std::vector<CompulsoryAssign*> m_vSingular;
 
   /**
    * The amount of height that cannot be exceeded in order for the
@@ -398,21 +383,13 @@ class Cumulative : public std::map<UInt, RefHeight> {
   std::vector<UInt> m_vRMaxHeight;
 
   /**
-   * Our undo stack. This one in particular is used to store, for a
-   * given stack frame, values prior to changes enforced by constraint
-   * propagation. It makes value unrolling easier.
-   */
-
-  ValueStack m_vStack;
-
-  /**
-   * This particular stack tracks assignments that we've made when
-   * placing compulsory parts. Saving this not only aids in debugging
-   * but also allows us to recall the necessary information for
-   * removing the compulsory part when popping the value assignment.
+   * Our undo trail. It records the values prior to changes enforced
+   * by constraint propagation, the changes to the interval and
+   * singular lists, and for each stack frame the compulsory part that
+   * was placed, so that popping the value assignment can remove it.
    */
 
-  std::vector<CompulsoryAssign*> m_vCStack;
+  CompulsoryTrail m_vTrail;
 };
 
 #endif // CUMULATIVE_H
@@ -0,0 +1,157 @@
+/**
+ * Copyright (C) 2011 Eric Huang
+ *
+ * This file is part of rectpack.
+ *
+ * rectpack is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * rectpack is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with rectpack. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DISTANCEMATRIX_H
+#define DISTANCEMATRIX_H
+
+#include "MinPlus.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+/**
+ * A square matrix of distances for all pairs shortest path
+ * computations, shared by APSP (signed, with MinPlus::infinity() for
+ * a missing edge) and UpperDistance (unsigned). The cells live in one
+ * contiguous allocation aligned to 64 bytes, and each row is padded
+ * to a multiple of four cells so that every row starts on a 32-byte
+ * boundary. All of the relaxation work goes through the row kernels
+ * in MinPlus.
+ */
+
+template <typename T>
+class DistanceMatrix {
+
+ public:
+  DistanceMatrix() :
+    m_nSize(0),
+    m_nStride(0),
+    m_nCapacity(0),
+    m_pCells(NULL) {
+  }
+
+  DistanceMatrix(const DistanceMatrix& src) :
+    m_nSize(0),
+    m_nStride(0),
+    m_nCapacity(0),
+    m_pCells(NULL) {
+    operator=(src);
+  }
+
+  ~DistanceMatrix() {
+    free(m_pCells);
+  }
+
+  const DistanceMatrix& operator=(const DistanceMatrix& src) {
+    if(this != &src) {
+      allocate(src.m_nSize);
+      if(m_nSize)
+	memcpy(m_pCells, src.m_pCells, m_nSize * m_nStride * sizeof(T));
+    }
+    return(*this);
+  }
+
+  /**
+   * Resizes the matrix to n by n, with every cell set to nValue.
+   */
+
+  void initialize(size_t n, const T& nValue) {
+    allocate(n);
+    std::fill(m_pCells, m_pCells + m_nSize * m_nStride, nValue);
+  }
+
+  T* operator[](size_t i) {
+    return(m_pCells + i * m_nStride);
+  }
+
+  const T* operator[](size_t i) const {
+    return(m_pCells + i * m_nStride);
+  }
+
+  size_t size() const {
+    return(m_nSize);
+  }
+
+  bool empty() const {
+    return(m_nSize == 0);
+  }
+
+  /**
+   * Relaxes row i through a path of length a to some vertex whose
+   * distances are given by the row q.
+   *
+   * @return true if any distance in row i decreased.
+   */
+
+  bool relax(size_t i, const T& a, const T* q) {
+    return(MinPlus::relax(operator[](i), q, m_nSize, a));
+  }
+
+  /**
+   * Relaxes every path through vertex k.
+   *
+   * @return true if any distance decreased.
+   */
+
+  bool floydWarshall(size_t k) {
+    bool bChanged(false);
+    for(size_t i = 0; i < m_nSize; ++i) {
+      T a = operator[](i)[k];
+      if(!MinPlus::infinite(a))
+	bChanged |= relax(i, a, operator[](k));
+    }
+    return(bChanged);
+  }
+
+  /**
+   * Computes all pairs shortest paths in n^3 time.
+   *
+   * @return true if any distance decreased.
+   */
+
+  bool floydWarshall() {
+    bool bChanged(false);
+    for(size_t k = 0; k < m_nSize; ++k)
+      bChanged |= floydWarshall(k);
+    return(bChanged);
+  }
+
+ private:
+  void allocate(size_t n) {
+    size_t nStride = (n + 3) & ~(size_t) 3;
+    if(n * nStride > m_nCapacity) {
+      free(m_pCells);
+      m_pCells = NULL;
+      if(posix_memalign((void**) &m_pCells, 64, n * nStride * sizeof(T)))
+	throw std::bad_alloc();
+      m_nCapacity = n * nStride;
+    }
+    m_nSize = n;
+    m_nStride = nStride;
+  }
+
+  size_t m_nSize;
+  size_t m_nStride;
+  size_t m_nCapacity;
+  T* m_pCells;
+};
+
+#endif // DISTANCEMATRIX_H
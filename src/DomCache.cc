@@ -0,0 +1,190 @@
+/**
+ * Copyright (C) 2011 Eric Huang
+ *
+ * This file is part of rectpack.
+ *
+ * rectpack is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * rectpack is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with rectpack. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "DomCache.h"
+#include "Parameters.h"
+#include "Rectangle.h"
+#include "RectPtrArray.h"
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <unistd.h>
+
+/**
+ * "RPDOMTBL" read as a little-endian integer.
+ */
+
+#define DOMCACHE_MAGIC 0x4c42544d4f445052ULL
+#define DOMCACHE_VERSION 1
+
+DomCache::DomCache(const Parameters* pParams, const RectPtrArray* pRects) {
+  if(pParams->m_sDomCache.empty()) return;
+
+  /**
+   * The recursive packers decide whether each entry is dominated, so
+   * the options that select and configure them are part of the key.
+   */
+
+  std::ostringstream oss;
+  oss << "w" << pParams->m_nWeakening << ";k" << pParams->m_bKorf
+      << ";1" << pParams->m_s1 << ";2" << pParams->m_s2 << ";";
+  for(RectPtrArray::const_iterator i = pRects->begin();
+      i != pRects->end(); ++i)
+    oss << (*i)->m_nID << ":" << (*i)->m_nWidth << "x" << (*i)->m_nHeight
+	<< ((*i)->m_bRotatable ? "r" : "") << ",";
+  m_sKey = oss.str();
+
+  /**
+   * 64-bit FNV-1a hash of the key for the file name. Collisions are
+   * caught by comparing the key stored in the file.
+   */
+
+  unsigned long long nHash = 14695981039346656037ULL;
+  for(std::string::const_iterator i = m_sKey.begin(); i != m_sKey.end(); ++i)
+    nHash = (nHash ^ (unsigned char) *i) * 1099511628211ULL;
+  std::ostringstream ossFile;
+  ossFile << pParams->m_sDomCache << "/dom-" << std::hex
+	  << std::setw(16) << std::setfill('0') << nHash << ".tbl";
+  m_sFile = ossFile.str();
+}
+
+DomCache::~DomCache() {
+}
+
+bool DomCache::enabled() const {
+  return(!m_sFile.empty());
+}
+
+bool DomCache::load(std::vector<std::vector<UInt> >& vWidth,
+		    std::vector<std::vector<UInt> >& vHeight,
+		    std::vector<Move>& vMoves) const {
+  if(!enabled()) return(false);
+  namespace bi = boost::interprocess;
+  try {
+    bi::file_mapping fm(m_sFile.c_str(), bi::read_only);
+    bi::mapped_region mr(fm, bi::read_only);
+    const UInt* p = (const UInt*) mr.get_address();
+    const UInt* pEnd = p + mr.get_size() / sizeof(UInt);
+
+    /**
+     * Header and key.
+     */
+
+    if(pEnd - p < 3 || p[0] != DOMCACHE_MAGIC || p[1] != DOMCACHE_VERSION ||
+       p[2] != m_sKey.size())
+      return(false);
+    p += 3;
+    size_t nKeyWords = (m_sKey.size() + sizeof(UInt) - 1) / sizeof(UInt);
+    if((size_t) (pEnd - p) < nKeyWords + 1 ||
+       m_sKey.compare(0, m_sKey.size(), (const char*) p, m_sKey.size()) != 0)
+      return(false);
+    p += nKeyWords;
+    size_t nRects = *p++;
+    if(nRects != vWidth.size() || nRects != vHeight.size())
+      return(false);
+
+    /**
+     * The two tables.
+     */
+
+    std::vector<std::vector<UInt> >* pTables[2] = { &vWidth, &vHeight };
+    for(int t = 0; t < 2; ++t) {
+      if((size_t) (pEnd - p) < nRects) return(false);
+      const UInt* pSizes = p;
+      p += nRects;
+      for(size_t i = 0; i < nRects; ++i) {
+	if((size_t) (pEnd - p) < pSizes[i]) return(false);
+	(*pTables[t])[i].assign(p, p + pSizes[i]);
+	p += pSizes[i];
+      }
+    }
+
+    /**
+     * The entries that move the root rectangle.
+     */
+
+    if(p == pEnd) return(false);
+    size_t nMoves = *p++;
+    if((size_t) (pEnd - p) < 4 * nMoves) return(false);
+    vMoves.resize(nMoves);
+    for(size_t i = 0; i < nMoves; ++i, p += 4) {
+      vMoves[i].m_nMinCoordinate = p[0];
+      vMoves[i].m_nID = p[1];
+      vMoves[i].m_nTable = p[2];
+      vMoves[i].m_nGap = p[3];
+      if(vMoves[i].m_nTable > 1 || vMoves[i].m_nID >= nRects ||
+	 vMoves[i].m_nGap >= (*pTables[vMoves[i].m_nTable])[p[1]].size())
+	return(false);
+    }
+  }
+  catch(bi::interprocess_exception&) {
+    return(false);
+  }
+  return(true);
+}
+
+void DomCache::save(const std::vector<std::vector<UInt> >& vWidth,
+		    const std::vector<std::vector<UInt> >& vHeight,
+		    const std::vector<Move>& vMoves) const {
+  if(!enabled()) return;
+  std::vector<UInt> v;
+  v.push_back(DOMCACHE_MAGIC);
+  v.push_back(DOMCACHE_VERSION);
+  v.push_back(m_sKey.size());
+  size_t nKey = v.size();
+  v.resize(nKey + (m_sKey.size() + sizeof(UInt) - 1) / sizeof(UInt), 0);
+  m_sKey.copy((char*) &v[nKey], m_sKey.size());
+  v.push_back(vWidth.size());
+  const std::vector<std::vector<UInt> >* pTables[2] = { &vWidth, &vHeight };
+  for(int t = 0; t < 2; ++t) {
+    for(size_t i = 0; i < pTables[t]->size(); ++i)
+      v.push_back((*pTables[t])[i].size());
+    for(size_t i = 0; i < pTables[t]->size(); ++i)
+      v.insert(v.end(), (*pTables[t])[i].begin(), (*pTables[t])[i].end());
+  }
+  v.push_back(vMoves.size());
+  for(std::vector<Move>::const_iterator i = vMoves.begin();
+      i != vMoves.end(); ++i) {
+    v.push_back(i->m_nMinCoordinate);
+    v.push_back(i->m_nID);
+    v.push_back(i->m_nTable);
+    v.push_back(i->m_nGap);
+  }
+
+  /**
+   * Write to a private temporary file and rename it into place, so
+   * that concurrent runs never see a partially written table.
+   */
+
+  std::ostringstream oss;
+  oss << m_sFile << ".tmp" << getpid() << "." << this;
+  std::string sTemp(oss.str());
+  std::ofstream ofs(sTemp.c_str(), std::ios::binary);
+  ofs.write((const char*) &v[0], v.size() * sizeof(UInt));
+  ofs.close();
+  if(!ofs || std::rename(sTemp.c_str(), m_sFile.c_str()) != 0) {
+    std::remove(sTemp.c_str());
+    std::cout << "Could not write domination cache " << m_sFile << "."
+	      << std::endl;
+  }
+}
@@ -0,0 +1,82 @@
+/**
+ * Copyright (C) 2011 Eric Huang
+ *
+ * This file is part of rectpack.
+ *
+ * rectpack is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * rectpack is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with rectpack. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DOMCACHE_H
+#define DOMCACHE_H
+
+#include "Integer.h"
+#include <string>
+#include <vector>
+
+class Parameters;
+class RectPtrArray;
+
+/**
+ * Persists the instance-dependent domination tables on disk so that
+ * repeated runs over the same instance can skip building them. Each
+ * instance gets its own file in the cache directory, named after a
+ * hash of a key that spells out every rectangle along with the
+ * parameters that influence the recursive packers. The file is a
+ * flat array of UInts so it can be mapped straight into memory:
+ *
+ *   magic, version, key length, key (padded to whole UInts),
+ *   number of rectangles,
+ *   entry counts of the width table, followed by its entries,
+ *   entry counts of the height table, followed by its entries,
+ *   number of root moves, followed by four UInts for each.
+ */
+
+class DomCache {
+ public:
+
+  /**
+   * A domination entry that moves the root rectangle, as recorded in
+   * Domination::m_MovesRootY. m_nTable is 0 for the width table and
+   * 1 for the height table.
+   */
+
+  class Move {
+  public:
+    UInt m_nMinCoordinate;
+    UInt m_nID;
+    UInt m_nTable;
+    UInt m_nGap;
+  };
+
+  DomCache(const Parameters* pParams, const RectPtrArray* pRects);
+  ~DomCache();
+  bool enabled() const;
+
+  /**
+   * @return true if the tables were found in the cache and loaded.
+   */
+
+  bool load(std::vector<std::vector<UInt> >& vWidth,
+	    std::vector<std::vector<UInt> >& vHeight,
+	    std::vector<Move>& vMoves) const;
+  void save(const std::vector<std::vector<UInt> >& vWidth,
+	    const std::vector<std::vector<UInt> >& vHeight,
+	    const std::vector<Move>& vMoves) const;
+
+ private:
+  std::string m_sKey;
+  std::string m_sFile;
+};
+
+#endif // DOMCACHE_H
@@ -18,6 +18,7 @@
  */
 
 #include "BoxDimensions.h"
+#include "DomCache.h"
 #include "DomDecorator.h"
 #include "Domination.h"
 #include "EmptyDom.h"
@@ -32,6 +33,8 @@
 #include "SquareDom.h"
 #include "URectDom.h"
 #include "WidthFirst.h"
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
 #include <iomanip>
 
 Domination::Domination() :
@@ -218,15 +221,69 @@ void Domination::buildTableStage1() {
   TimeSpec t;
   t.tick();
 
+  /**
+   * These tables depend only on the instance, so try the on-disk
+   * cache before doing any packing.
+   */
+
+  DomCache dc(m_pParams, m_pRects);
+  std::vector<DomCache::Move> vMoves;
+  if(dc.load(m_vTableW1, m_vTableH1, vMoves)) {
+    for(std::vector<DomCache::Move>::const_iterator i = vMoves.begin();
+	i != vMoves.end(); ++i)
+      m_MovesRootY.insert(SymKey(i->m_nMinCoordinate, i->m_nID,
+				 i->m_nTable ? &m_vTableH1 : &m_vTableW1,
+				 i->m_nGap));
+    t.tock();
+    m_Time += t;
+    return;
+  }
+
+  /**
+   * Walk both tables first, settling the entries that need no packing
+   * and collecting the distinct subproblems for the rest. The
+   * subproblems are independent, so they are then packed on as many
+   * threads as we were given.
+   */
+
   PackingCache c;
   RectDecArray rda;
   WidthFirst wf;
   HeightFirst hf;
+  std::vector<Subproblem> vJobs;
+  std::vector<Cell> vCells;
 
   rda.initialize(*m_pRects, &wf);
-  buildTable(rda, c, m_vTableW1);
+  buildTable(rda, c, m_vTableW1, vJobs, vCells);
   rda.initialize(*m_pRects, &hf);
-  buildTable(rda, c, m_vTableH1);
+  buildTable(rda, c, m_vTableH1, vJobs, vCells);
+  if(m_pParams->m_bVerbose)
+    std::cout << "Domination subproblems: " << vCells.size()
+	      << " entries, " << vJobs.size() << " distinct, "
+	      << c.m_nHits << " shared." << std::endl;
+  packAll(vJobs);
+
+  for(std::vector<Cell>::const_iterator i = vCells.begin();
+      i != vCells.end(); ++i)
+    if(vJobs[i->m_nJob].m_bResult) {
+      (*i->m_pTable)[i->m_nID][i->m_nGap] = 1; // Dominated.
+      if(i->m_bMovesRoot)
+	m_MovesRootY.insert(SymKey(i->m_nMinCoordinate, i->m_nID,
+				   i->m_pTable, i->m_nGap));
+    }
+
+  if(dc.enabled()) {
+    for(std::set<SymKey>::const_iterator i = m_MovesRootY.begin();
+	i != m_MovesRootY.end(); ++i) {
+      DomCache::Move m;
+      m.m_nMinCoordinate = i->m_nMinCoordinate;
+      m.m_nID = i->m_nID;
+      m.m_nTable = (i->m_pTable == &m_vTableH1);
+      m.m_nGap = i->m_nGap;
+      vMoves.push_back(m);
+    }
+    dc.save(m_vTableW1, m_vTableH1, vMoves);
+  }
 
   t.tock();
   m_Time += t;
@@ -411,10 +468,9 @@ void Domination::constrainDuplicatesH(const Domination::DuplicateMap& m) {
 }
 
 void Domination::buildTable(const RectDecArray& rda, PackingCache& c,
-			    std::vector<std::vector<UInt> >& vTable) {
-  BoxDimensions b;
-  Parameters p(*m_pParams);
-  p.m_s1 += 'd'; // Disable recursive domination table building.
+			    std::vector<std::vector<UInt> >& vTable,
+			    std::vector<Subproblem>& vJobs,
+			    std::vector<Cell>& vCells) {
   for(RectDecArray::const_iterator i = rda.begin();
       i != rda.end(); ++i) {
 
@@ -466,57 +522,80 @@ void Domination::buildTable(const RectDecArray& rda, PackingCache& c,
 	break;
 
       /**
-       * Check the cache to see if we've already tried packing
-       * something like this instance.
+       * The entry is decided by a packing attempt. Check the cache to
+       * see if we've already queued an attempt at something like this
+       * instance, and queue a new one otherwise.
        */
 
       BoxDimensions b;
       if(rd->d1() == r->m_nWidth) b.initialize(rd->d1(), g);
       else b.initialize(g, rd->d1());
 
-      PackingCacheKey k(b, d);
-      PackingCache::iterator pc = c.find(k);
-      if(pc != c.end()) {
-	vTable[r->m_nID][g] = pc->second;
-
-	/**
-	 * If this entry involves moving the root rectangle, we must
-	 * note this fact. The first value is the coordinate to which
-	 * the root rectangle is moved.
-	 */
-
-	if(pc->second && d.find(rda.front()->m_pRect) != d.end())
-	  m_MovesRootY.insert(SymKey(g + rd->d2(), r->m_nID, &vTable, g));
-	continue;
-      }
+      Cell cell;
+      cell.m_pTable = &vTable;
+      cell.m_nID = r->m_nID;
+      cell.m_nGap = g;
 
       /**
-       * Possible packing attempt, so let's make a copy of the
-       * parameters and construct the instance.
+       * If this entry involves moving the root rectangle, we must
+       * note this fact. The first value is the coordinate to which
+       * the root rectangle is moved.
        */
 
-      p.m_vInstance.clear();
-      for(RectDecDeq::iterator j = d.begin(); j != d.end(); ++j)
-	p.m_vInstance.push_back(RDimensions(*((*j)->m_pRect)));
-      p.m_vInstance.inferInstanceProperties();
-      if(pack(&p, b)) {
-	vTable[r->m_nID][g] = 1; // Dominated.
-	c.set(k, !p.m_vInstance.m_bOrientedNonSquares, 1);
+      cell.m_nMinCoordinate = g + rd->d2();
+      cell.m_bMovesRoot = (d.find(rda.front()->m_pRect) != d.end());
 
-	/**
-	 * If this entry involves moving the root rectangle, we must
-	 * note this fact. The first value is the coordinate to which
-	 * the root rectangle is moved.
-	 */
-
-	if(d.find(rda.front()->m_pRect) != d.end())
-	  m_MovesRootY.insert(SymKey(g + rd->d2(), r->m_nID, &vTable, g));
+      PackingCacheKey k(b, d);
+      if(!c.find(k, cell.m_nJob)) {
+	cell.m_nJob = vJobs.size();
+	vJobs.push_back(Subproblem());
+	vJobs.back().m_Box = b;
+	bool bUnoriented(true);
+	for(RectDecDeq::iterator j = d.begin(); j != d.end(); ++j) {
+	  vJobs.back().m_vRects.push_back((*j)->m_pRect);
+	  if(!(*j)->m_pRect->m_bRotatable && !(*j)->m_pRect->m_bSquare)
+	    bUnoriented = false;
+	}
+	c.set(k, bUnoriented, cell.m_nJob);
       }
-      else c.set(k, !p.m_vInstance.m_bOrientedNonSquares, 0);
+      vCells.push_back(cell);
     }
   }
 }
 
+void Domination::packAll(std::vector<Subproblem>& vJobs) const {
+  boost::atomic<size_t> nNext(0);
+  size_t nThreads =
+    std::min((size_t) std::max(m_pParams->m_nThreads, 1), vJobs.size());
+  if(nThreads <= 1) {
+    packJobs(&vJobs, &nNext);
+    return;
+  }
+  boost::thread_group tg;
+  for(size_t i = 0; i < nThreads; ++i)
+    tg.create_thread(boost::bind(&Domination::packJobs, this,
+				 &vJobs, &nNext));
+  tg.join_all();
+}
+
+void Domination::packJobs(std::vector<Subproblem>* pJobs,
+			  boost::atomic<size_t>* pNext) const {
+  Parameters p(*m_pParams);
+  p.m_s1 += 'd'; // Disable recursive domination table building.
+  p.m_nSplit = 1; // The subproblems are too small to split.
+  p.m_vPortfolio.clear(); // Or to race.
+  p.m_nThreads = 1;
+  for(size_t i = (*pNext)++; i < pJobs->size(); i = (*pNext)++) {
+    Subproblem& s = (*pJobs)[i];
+    p.m_vInstance.clear();
+    for(std::vector<const Rectangle*>::const_iterator j = s.m_vRects.begin();
+	j != s.m_vRects.end(); ++j)
+      p.m_vInstance.push_back(RDimensions(**j));
+    p.m_vInstance.inferInstanceProperties();
+    s.m_bResult = pack(&p, s.m_Box);
+  }
+}
+
 void Domination::deadlocks(const RectDecArray& rda, DomDecorator& t) const {
   for(RectDecArray::const_reverse_iterator i = rda.rbegin();
       i != rda.rend(); ++i) {
@@ -598,7 +677,7 @@ UInt Domination::totalArea(const RectDecDeq& d) const {
   return(nArea);
 }
 
-bool Domination::pack(Parameters* pParams, const BoxDimensions& b) {
+bool Domination::pack(Parameters* pParams, const BoxDimensions& b) const {
   Packer* p = Packer::create(pParams);
   p->initialize(pParams);
   p->m_pBoxes = NULL;
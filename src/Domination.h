@@ -20,12 +20,15 @@
 #ifndef DOMINATION_H
 #define DOMINATION_H
 
+#include "BoxDimensions.h"
 #include "Dimensions.h"
 #include "Integer.h"
+#include "Probes.h"
 #include "Rectangle.h"
 #include "SymKey.h"
 #include "TimeSpec.h"
 
+#include <boost/atomic.hpp>
 #include <boost/function.hpp>
 #include <deque>
 #include <list>
@@ -121,14 +124,44 @@ class Domination {
    * is the other side.
    */
 
+  /**
+   * A packing subproblem that decides one or more table entries.
+   */
+
+  class Subproblem {
+  public:
+    BoxDimensions m_Box;
+    std::vector<const Rectangle*> m_vRects;
+    bool m_bResult;
+  };
+
+  /**
+   * A table entry that waits on the result of a subproblem.
+   */
+
+  class Cell {
+  public:
+    std::vector<std::vector<UInt> >* m_pTable;
+    UInt m_nID;
+    UInt m_nGap;
+    UInt m_nMinCoordinate;
+    bool m_bMovesRoot;
+    size_t m_nJob;
+  };
+
   void buildTable(const RectDecArray& rda, PackingCache& c,
-		  std::vector<std::vector<UInt> >& vTable);
+		  std::vector<std::vector<UInt> >& vTable,
+		  std::vector<Subproblem>& vJobs,
+		  std::vector<Cell>& vCells);
+  void packAll(std::vector<Subproblem>& vJobs) const;
+  void packJobs(std::vector<Subproblem>* pJobs,
+		boost::atomic<size_t>* pNext) const;
   void buildGaps(const std::vector<std::vector<UInt> >& vTable,
 		 std::vector<UInt>& vGap);
   void buildEntries(std::vector<std::vector<UInt> >& vTable);
   void printTable(const std::vector<std::vector<UInt> >& v) const;
   void printMeta() const;
-  bool pack(Parameters* pParams, const BoxDimensions& b);
+  bool pack(Parameters* pParams, const BoxDimensions& b) const;
   UInt totalArea(const RectDecDeq& d) const;
   bool sticksOut(UInt g, UInt l,
 		 const RectDecDeq& d) const;
@@ -141,6 +174,7 @@ class Domination {
   bool dominated(const Rectangle* r, UInt nGap,
 		 const std::vector<std::vector<UInt> >& v1,
 		 const std::vector<std::vector<UInt> >& v2) const {
+    PROBE(PROBE_DOMINATION);
     if(r->m_bRotated) {
       if(nGap < v2[r->m_nID].size())
 	return(v2[r->m_nID][nGap] == 1);
@@ -140,31 +140,37 @@ bool Duplicate::packY(RectPtrArray::iterator iBegin,
    * compression call.
    */
 
-  m_vY.m_vRectangles.push_back(r);
+  m_vY.place(r);
   UInt nRealLast = std::min(m_vLastBinYI[r->m_nID],
 			    m_pDomination->entriesw1(r) - 1);
   for(r->yi.init(0, r->m_nHeight, 0, nRealLast); r->yi.valid(nRealLast);
       r->yi.next(r->m_nHeight, nRealLast)) {
     if(r->yi.m_nEnd > 0 && m_vDominationLeft[r->m_nID] &&
        m_pDomination->dominatedw1(r, r->yi.m_nEnd)) continue;
+    if(!claim(iBegin - m_vRectPtrs.begin())) continue;
+    if(!m_Checkpoint.enter(r, r->yi.m_nBegin, r->yi.m_nEnd)) continue;
     m_Nodes.tick(YI);
     m_vY.m_vDomain[r->m_nID] = r->yi;
     m_vY.pushyi(r);
     if(waste(iBegin + 1, iEnd))
       return(true);
     m_vY.popyi(r);
+    m_Checkpoint.leave();
   }
 
   for(r->yi.init(m_pDomination->entriesw1(r), r->m_nHeight,
 		 m_pParams->m_nYScale, m_vLastBinYI[r->m_nID]);
       r->yi.valid(m_vLastBinYI[r->m_nID]);
       r->yi.next(r->m_nHeight, m_vLastBinYI[r->m_nID])) {
+    if(!claim(iBegin - m_vRectPtrs.begin())) continue;
+    if(!m_Checkpoint.enter(r, r->yi.m_nBegin, r->yi.m_nEnd)) continue;
     m_Nodes.tick(YI);
     m_vY.m_vDomain[r->m_nID] = r->yi;
     m_vY.pushyi(r);
     if(waste(iBegin + 1, iEnd))
       return(true);
     m_vY.popyi(r);
+    m_Checkpoint.leave();
   }
   return(false);
 }
@@ -226,6 +232,8 @@ bool Duplicate::locLeft(Rectangle* r, RectPtrArray::iterator& iBegin,
       continue;
     if((!m_vDominationLeft[r->m_nID] && r->yi.m_nEnd == 0) ||
        !m_vY.canFityi(r)) continue;
+    if(!claim(iBegin - m_vRectPtrs.begin())) continue;
+    if(!m_Checkpoint.enter(r, r->yi.m_nBegin, r->yi.m_nEnd)) continue;
     m_Nodes.tick(YI);
     m_vY.m_vDomain[r->m_nID] = r->yi;
     m_vY.pushyi(r);
@@ -233,6 +241,7 @@ bool Duplicate::locLeft(Rectangle* r, RectPtrArray::iterator& iBegin,
       if(waste(iBegin + 1, iEnd))
 	return(true);
     m_vY.popyi(r);
+    m_Checkpoint.leave();
   }
   return(false);
 }
@@ -245,6 +254,8 @@ bool Duplicate::locMid(Rectangle* r, RectPtrArray::iterator& iBegin,
       r->yi.valid(m_vForbiddenStartYI[r->m_nID] - 1);
       r->yi.next(r->m_nHeight, m_vForbiddenStartYI[r->m_nID] - 1)) {
     if(!m_vY.canFityi(r)) continue;
+    if(!claim(iBegin - m_vRectPtrs.begin())) continue;
+    if(!m_Checkpoint.enter(r, r->yi.m_nBegin, r->yi.m_nEnd)) continue;
     m_Nodes.tick(YI);
     m_vY.m_vDomain[r->m_nID] = r->yi;
     m_vY.pushyi(r);
@@ -252,6 +263,7 @@ bool Duplicate::locMid(Rectangle* r, RectPtrArray::iterator& iBegin,
       if(waste(iBegin + 1, iEnd))
 	return(true);
     m_vY.popyi(r);
+    m_Checkpoint.leave();
   }
   return(false);
 }
@@ -265,6 +277,8 @@ bool Duplicate::locMid(Rectangle* r, UInt nMinY,
       r->yi.valid(m_vForbiddenStartYI[r->m_nID] - 1);
       r->yi.next(r->m_nHeight, m_vForbiddenStartYI[r->m_nID] - 1)) {
     if(!m_vY.canFityi(r)) continue;
+    if(!claim(iBegin - m_vRectPtrs.begin())) continue;
+    if(!m_Checkpoint.enter(r, r->yi.m_nBegin, r->yi.m_nEnd)) continue;
     m_Nodes.tick(YI);
     m_vY.m_vDomain[r->m_nID] = r->yi;
     m_vY.pushyi(r);
@@ -272,6 +286,7 @@ bool Duplicate::locMid(Rectangle* r, UInt nMinY,
       if(waste(iBegin + 1, iEnd))
 	return(true);
     m_vY.popyi(r);
+    m_Checkpoint.leave();
   }
   return(false);
 }
@@ -288,6 +303,8 @@ bool Duplicate::locRight(Rectangle* r, RectPtrArray::iterator& iBegin,
        m_pDomination->dominatedw2(r, m_Box.m_nHeight - (r->yi.m_nEnd + r->m_nHeight))) continue;
     if((!m_vDominationRight[r->m_nID] && r->yi.m_nEnd + r->m_nHeight == m_Box.m_nHeight) ||
        !m_vY.canFityi(r)) continue;
+    if(!claim(iBegin - m_vRectPtrs.begin())) continue;
+    if(!m_Checkpoint.enter(r, r->yi.m_nBegin, r->yi.m_nEnd)) continue;
     m_Nodes.tick(YI);
     m_vY.m_vDomain[r->m_nID] = r->yi;
     m_vY.pushyi(r);
@@ -295,6 +312,7 @@ bool Duplicate::locRight(Rectangle* r, RectPtrArray::iterator& iBegin,
       if(waste(iBegin + 1, iEnd))
 	return(true);
     m_vY.popyi(r);
+    m_Checkpoint.leave();
   }
   return(false);
 }
@@ -313,7 +331,7 @@ bool Duplicate::packcra() {
 
 bool Duplicate::searchSpace(RectPtrArray::iterator iBegin,
 			    const RectPtrArray::const_iterator& iEnd) {
-  if(bQuit) return(false);
+  if(cancelled()) return(false);
   if(iBegin == iEnd) {
 
     /**
@@ -377,13 +395,13 @@ UInt Duplicate::bestStripArea(Rectangle*& r) {
   if(!m_bVarOrder) return(std::numeric_limits<UInt>::max());
   
   UInt nMax(0);
-  for(std::vector<const Rectangle*>::const_iterator i = m_vY.m_vRectangles.begin();
+  const RectColumns& c(m_vY.m_vColumns);
+  for(std::vector<UInt>::const_iterator i = m_vY.m_vRectangles.begin();
       i != m_vY.m_vRectangles.end(); ++i) {
-    UInt t = (*i)->m_nWidth *
-      ((*i)->m_nHeight - m_vY.m_vDomain[(*i)->m_nID].m_nWidth);
+    UInt t = c.m_vWidth[*i] * (c.m_vHeight[*i] - m_vY.m_vDomain[*i].m_nWidth);
     if(t > nMax) {
       nMax = t;
-      r = m_vRectPtrs[(*i)->m_nID];
+      r = m_vRectPtrs[*i];
     }
   }
   return(nMax);
@@ -395,10 +413,12 @@ bool Duplicate::strips(Rectangle* r, RectPtrArray::iterator iBegin,
       r->y <= (UInt) m_vY.m_vDomain[r->m_nID].m_nEnd; ++r->y) {
     m_Nodes.tick(YF);
     if(!m_vY.canFitStrips(r)) continue;
+    if(!m_Checkpoint.enter(r, r->y, r->y)) continue;
     m_vY.pushStripsy(r);
     if(m_vY.compress())
       if(waste(iBegin, iEnd)) return(true);
     m_vY.popStripsy(r);
+    m_Checkpoint.leave();
   }
   return(false);
 }
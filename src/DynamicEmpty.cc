@@ -38,6 +38,7 @@ DynamicEmpty::DynamicEmpty() :
   m_pBox(NULL),
   m_pTime(NULL),
   m_pNodes(NULL),
+  m_pCancel(NULL),
   m_nDepth(0),
   m_nCorners(0),
   m_pValidY(NULL),
@@ -54,6 +55,7 @@ void DynamicEmpty::initialize(Packer* pPacker) {
   m_pCuSP = &pPacker->m_nCuSP;
   m_pTime = &pPacker->m_YTime;
   m_pNodes = &pPacker->m_Nodes;
+  m_pCancel = &pPacker->m_bCancel;
 }
 
 void DynamicEmpty::initialize(const Parameters* pParams) {
@@ -116,7 +118,7 @@ bool DynamicEmpty::packY(Cumulative& c, const SubsetSums* pValidY) {
 }
 
 bool DynamicEmpty::packYAux(Int nDepth) {
-  if(bQuit) return(false);
+  if(bQuit || m_pCancel->load(boost::memory_order_relaxed)) return(false);
 
   /**
    * Base case is when we've got
@@ -212,7 +214,7 @@ void DynamicEmpty::pushAux(Component* c) {
    * (carefully putting them into our undo stack).
    */
 
-  m_vStack.push_back(Assignment(c));
+  m_vStack.push_back(c);
   m_vVariables.erase(c, m_vStack.back().m_vErased);
 
   /**
@@ -239,7 +241,7 @@ void DynamicEmpty::pushAux(Component* c, Component* pNew) {
    * (carefully putting them into our undo stack).
    */
 
-  m_vStack.push_back(Assignment(pNew));
+  m_vStack.push_back(pNew);
   m_vVariables.erase(pNew, m_vStack.back().m_vErased);
 
   /**
@@ -321,11 +323,11 @@ void DynamicEmpty::popAux(Component* c) {
 void DynamicEmpty::newCorners(const Component* c,
 			   std::vector<EmptyCorner>& v) const {
   v.clear();
-  std::vector<Assignment>::const_iterator iEnd(m_vStack.end());
+  AssignmentStack::const_iterator iEnd(m_vStack.end());
   --iEnd;
   UInt x2(c->x2());
   UInt y2(c->y2());
-  for(std::vector<Assignment>::const_iterator i = m_vStack.begin();
+  for(AssignmentStack::const_iterator i = m_vStack.begin();
       i != iEnd; ++i) {
     
     const Component* c2(i->m_pComponent);
@@ -440,7 +442,7 @@ void DynamicEmpty::newCorners(const Component* c,
        * other rectangle has already filled in the empty corner.
        */
 
-      for(std::vector<Assignment>::const_iterator i = m_vStack.begin();
+      for(AssignmentStack::const_iterator i = m_vStack.begin();
 	  i != iEnd; ++i)
 	if(i->m_pComponent->fills(v[j])) {
 	  v[j] = v.back();
@@ -483,7 +485,7 @@ void DynamicEmpty::pop(Component* c) {
 }
 
 bool DynamicEmpty::placed(Component* c) const {
-  for(std::vector<Assignment>::const_iterator i = m_vStack.begin();
+  for(AssignmentStack::const_iterator i = m_vStack.begin();
       i != m_vStack.end(); ++i)
     if(i->m_pComponent == c) return(true);
   return(false);
@@ -511,7 +513,7 @@ bool DynamicEmpty::packYCorner(EmptyCorner& ec, Int nDepth) {
    * representation.
    */
 
-  for(SymmetryMap::reverse_iterator k = pValues->rbegin();
+  for(SymmetryMap::const_reverse_iterator k = pValues->rbegin();
       k != pValues->rend(); ++k) {
 
     /**
@@ -727,7 +729,7 @@ bool DynamicEmpty::packYCorner(EmptyCorner& ec, Int nDepth) {
 void DynamicEmpty::printStack() const {
   std::cout << "Assignment Stack:" << std::endl;
   UInt nMax(0), nStart(0);
-  for(std::vector<Assignment>::const_iterator i = m_vStack.begin();
+  for(AssignmentStack::const_iterator i = m_vStack.begin();
       i != m_vStack.end(); ++i) {
     std::ostringstream oss;
     Printer::print(i->m_vErased, oss);
@@ -773,7 +775,7 @@ void DynamicEmpty::print() const {
 }
 
 bool DynamicEmpty::canPlace(const Component* c) const {
-  for(std::vector<Assignment>::const_iterator i = m_vStack.begin();
+  for(AssignmentStack::const_iterator i = m_vStack.begin();
       i != m_vStack.end(); ++i)
     if(i->m_pComponent->yOverlaps(*c) &&
        i->m_pComponent->xOverlaps(*c)) return(false);
@@ -805,7 +807,7 @@ UInt DynamicEmpty::maxHeight(const EmptyCorner& ec,
    * Iterate over every iteme in our stack, constraining the height.
    */
 
-  for(std::vector<Assignment>::const_iterator i = m_vStack.begin();
+  for(AssignmentStack::const_iterator i = m_vStack.begin();
       i != m_vStack.end(); ++i)
     ec.constrainHeight(nWidth, nHeight, i->m_pComponent);
   return(nHeight);
@@ -815,11 +817,11 @@ void DynamicEmpty::placeDominated(Int& nStartDepth) {
   EmptyCorner ec(0, 0, EmptyCorner::LowerLeft);
   SymmetryMap* pValues = getValues(ec);
   m_vDominated.clear();
-  for(SymmetryMap::reverse_iterator k = pValues->rbegin();
+  for(SymmetryMap::const_reverse_iterator k = pValues->rbegin();
       k != pValues->rend(); ++k) {
     if(k->second.empty() ||
        k->first.m_nWidth != m_pBox->m_nWidth) continue;
-    for(std::set<Component*>::iterator i = k->second.begin();
+    for(std::set<Component*>::const_iterator i = k->second.begin();
 	i != k->second.end(); ++i) {
       if((*i)->m_pEmpty)
 	continue;
@@ -857,7 +859,7 @@ void DynamicEmpty::findTopSymmetry() {
    * and it's not empty.
      */
   
-  SymmetryMap::reverse_iterator i = pValues->rbegin();
+  SymmetryMap::const_reverse_iterator i = pValues->rbegin();
   while(i->second.empty() && i != pValues->rend())
     ++i;
   if(i == pValues->rend() || i->second.size() != 1)
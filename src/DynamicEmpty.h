@@ -22,7 +22,7 @@
 
 #include "AlignedComponentPtrs.h"
 #include "AlignedCongruencies.h"
-#include "Assignment.h"
+#include "AssignmentStack.h"
 #include "BinomialCache.h"
 #include "Bins.h"
 #include "NewCornerValues.h"
@@ -36,6 +36,7 @@
 #include "SpaceFill.h"
 #include "SymmetryMap.h"
 #include "WastedBins.h"
+#include <boost/atomic.hpp>
 #include <string>
 #include <vector>
 
@@ -142,6 +143,7 @@ class DynamicEmpty : public SpaceFill {
   const BoxDimensions* m_pBox;
   TimeSpec* m_pTime;
   NodeCount* m_pNodes;
+  const boost::atomic<bool>* m_pCancel;
 
   /**
    * Some indexing and inference classes.
@@ -158,7 +160,7 @@ class DynamicEmpty : public SpaceFill {
    */
 
   std::vector<UInt> m_vStackSize;
-  std::vector<Assignment> m_vStack;
+  AssignmentStack m_vStack;
   int m_nDepth;
   NewCornerValues m_vValues;
   NewCornerVariables m_vVariables;
@@ -101,7 +101,7 @@ bool DynamicSums::packSingle(const Compulsory* c,
 
   SimpleSums ss;
   ss.insert(0);
-  for(SingleStack::const_iterator j = m_vX.singles().begin();
+  for(std::vector<CompulsoryAssign*>::const_iterator j = m_vX.singles().begin();
       j != m_vX.singles().end(); ++j)
     if((*j)->m_nValue.right() <= c->left())
       ss.insert((*j)->m_nValue.right());
@@ -111,7 +111,7 @@ bool DynamicSums::packSingle(const Compulsory* c,
    * intervals determined, but who haven't been fixed yet.
    */
 
-  for(FastRemove<CompulsoryAssign*>::const_iterator j = m_vX.intervals().begin();
+  for(std::vector<CompulsoryAssign*>::const_iterator j = m_vX.intervals().begin();
       j != m_vX.intervals().end(); ++j)
     if((*j)->m_nValue.right() <= c->left())
       ss.add((*j)->m_nValue.m_pRect->m_nWidth, c->left());
@@ -152,7 +152,7 @@ bool DynamicSums::orientation(RectPtrArray::iterator i) {
 }
 
 bool DynamicSums::nextVariable(RectPtrArray::iterator i) {
-  if(bQuit) return(false);
+  if(cancelled()) return(false);
 
   /**
    * In the base case we're at the end of our packing sequence.
@@ -30,11 +30,17 @@ EmptySpace::EmptySpace() :
 EmptySpace::~EmptySpace() {
 }
 
+void EmptySpace::reset() {
+  m_nMaxHeight = 0;
+  m_nHeightLeft = 0;
+  m_Instantiations.clear();
+}
+
 void EmptySpace::print() const {
   std::cout << m_nHeightLeft << "/" << m_nMaxHeight;
   if(!m_Instantiations.empty())
     std::cout << ":";
-  for(std::set<Component*>::const_iterator i = m_Instantiations.begin();
+  for(ComponentSet::const_iterator i = m_Instantiations.begin();
       i != m_Instantiations.end(); ++i)
     std::cout << " " << (*i)->m_nID;
   std::cout << std::flush;
@@ -42,7 +48,7 @@ void EmptySpace::print() const {
 
 UInt EmptySpace::maxNonAdjacentHeight(const EmptyCorner& ec) const {
   UInt nHeight = m_nHeightLeft;
-  for(std::set<Component*>::const_iterator i = m_Instantiations.begin();
+  for(ComponentSet::const_iterator i = m_Instantiations.begin();
       i != m_Instantiations.end(); ++i) {
     if(ec.m_nType == EmptyCorner::LowerLeft ||
        ec.m_nType == EmptyCorner::LowerRight) {
@@ -20,8 +20,8 @@
 #ifndef EMPTYSPACE_H
 #define EMPTYSPACE_H
 
+#include "ComponentSet.h"
 #include "Integer.h"
-#include <set>
 
 class Component;
 class EmptyCorner;
@@ -30,6 +30,7 @@ class EmptySpace {
  public:
   EmptySpace();
   ~EmptySpace(); 
+  void reset();
   
   /**
    * Returns a height restricted by either the max height of this
@@ -43,7 +44,7 @@ class EmptySpace {
 
   UInt m_nMaxHeight;
   UInt m_nHeightLeft;
-  std::set<Component*> m_Instantiations;
+  ComponentSet m_Instantiations;
 
   void print() const;
 };
@@ -22,6 +22,7 @@
 #include "BoxDimensions.h"
 #include "ICoords.h"
 #include "Packer.h"
+#include "WastedBins.h"
 #include <iomanip>
 #include <iostream>
 
@@ -54,6 +55,9 @@ void Grid::initialize(const BoxDimensions* pBox) {
   m_vVer.clear();
   m_vVer.resize(pBox->m_nWidth + 1,
 		std::vector<UInt>(pBox->m_nHeight, pBox->m_nHeight));
+#ifdef GRIDBITS
+  m_Bits.initialize(pBox->m_nWidth, pBox->m_nHeight);
+#endif
 }
 
 void Grid::resize(Int nDim) {
@@ -63,6 +67,9 @@ void Grid::resize(Int nDim) {
   m_vHor.resize(nDim + 1, std::vector<UInt>(nDim, 0));
   m_vVer.clear();
   m_vVer.resize(nDim + 1, std::vector<UInt>(nDim, 0));
+#ifdef GRIDBITS
+  m_Bits.initialize(nDim + 1, nDim);
+#endif
 }
 
 void Grid::del(const Rectangle* s) {
@@ -71,8 +78,7 @@ void Grid::del(const Rectangle* s) {
   Int top;                                /* y index of top of old empty strip */
   Int left;                    /* x index of left-most cell of old empty strip */
 
-  for (x = s->x; x < (Int) (s->x + s->m_nWidth); x++)    /* for each column occupied by square */
-    std::fill(operator[](x).begin() + s->y, operator[](x).begin() + s->y + s->m_nHeight, GRIDEMPTY);
+  draw(s->x, s->m_nWidth, s->y, s->m_nHeight, GRIDEMPTY);
 
   for (x = s->x; x < (Int) (s->x + s->m_nWidth); x++)     /* each column occupied by placement */
     {vert = m_vVer[x][s->y];                    /* old height of vertical strip */
@@ -96,17 +102,17 @@ void Grid::del(const Rectangle* s) {
     }
 }
 
-void Grid::add(const Rectangle* s, std::vector<Int>& v) {
+void Grid::add(const Rectangle* s, WastedBins& v) {
   Int x, y;
   Int run;              /* length of horizontal or vertical run of empty space */
 
+  draw(s->x, s->m_nWidth, s->y, s->m_nHeight, s->m_nID);   /* fill in square */
   for (x = (Int) s->x; x < (Int) (s->x + s->m_nWidth); x++)    /* for each column occupied by square */
     for (y = (Int) s->y; y < (Int) (s->y + s->m_nHeight); y++) {    /* for each row occupied by square */
-      operator[](x)[y] = s->m_nID;                                       /* fill in square */
       if (m_vVer[x][y] <= m_vHor[x][y])
-	v[m_vVer[x][y]]--;     /* remove old value */
+	v.decrement(m_vVer[x][y]);     /* remove old value */
       else
-	v[m_vHor[x][y]]--;                         /* remove old value */
+	v.decrement(m_vHor[x][y]);                         /* remove old value */
     }
   /* update vertical grid above placement */
   for (x = (Int) s->x; x < (Int) (s->x + s->m_nWidth); x++) {/* for each column occupied by placement */
@@ -116,9 +122,9 @@ void Grid::add(const Rectangle* s, std::vector<Int>& v) {
       else break;                    /* cell is occupied, vertical run is over */
     for (y = y + 1; y < (Int) s->y; y++) {            /* for each cell of empty run */
       if (run < (Int) m_vHor[x][y]) {          /* new vertical strip < horizontal strip */
-	if (m_vVer[x][y] <= m_vHor[x][y]) v[m_vVer[x][y]]--;  /* remove old value */
-	else v[m_vHor[x][y]]--;                          /* remove old value */
-	v[run]++;}                                    /* insert new value */
+	if (m_vVer[x][y] <= m_vHor[x][y]) v.decrement(m_vVer[x][y]);  /* remove old value */
+	else v.decrement(m_vHor[x][y]);                          /* remove old value */
+	v.increment(run);}                                    /* insert new value */
       m_vVer[x][y] = run;                        /* new height of vertical strip */
     }
     /* update vertical grid below placement */
@@ -126,9 +132,9 @@ void Grid::add(const Rectangle* s, std::vector<Int>& v) {
     for (y = (Int) (s->y + s->m_nHeight + run - 1);
 	 y >= (Int) (s->y + s->m_nHeight); y--) {/* for each cell of empty run */
       if (run < (Int) m_vHor[x][y]) {          /* new vertical strip < horizontal strip */
-	if (m_vVer[x][y] <= m_vHor[x][y]) v[m_vVer[x][y]]--;  /* remove old value */
-	else v[m_vHor[x][y]]--;                          /* remove old value */
-	v[run]++;                                    /* insert new value */
+	if (m_vVer[x][y] <= m_vHor[x][y]) v.decrement(m_vVer[x][y]);  /* remove old value */
+	else v.decrement(m_vHor[x][y]);                          /* remove old value */
+	v.increment(run);                                    /* insert new value */
       }
       m_vVer[x][y] = run;                       /* new height of vertical strip */
     }
@@ -141,9 +147,9 @@ void Grid::add(const Rectangle* s, std::vector<Int>& v) {
       else break;                    /* cell is occupied, vertical run is over */
     for(x = x + 1; x < (Int) s->x; x++) {            /* for each cell of empty run */
       if(run < (Int) m_vVer[x][y]) {          /* new horizontal strip < vertical strip */
-	if (m_vVer[x][y] <= m_vHor[x][y]) v[m_vVer[x][y]]--;  /* remove old value */
-	else v[m_vHor[x][y]]--;                          /* remove old value */
-	v[run]++;                                    /* insert new value */
+	if (m_vVer[x][y] <= m_vHor[x][y]) v.decrement(m_vVer[x][y]);  /* remove old value */
+	else v.decrement(m_vHor[x][y]);                          /* remove old value */
+	v.increment(run);                                    /* insert new value */
       }
       m_vHor[x][y] = run;                        /* new height of vertical strip */
     }
@@ -152,9 +158,9 @@ void Grid::add(const Rectangle* s, std::vector<Int>& v) {
     for(x = (Int) (s->x + s->m_nWidth + run - 1);
 	x >= (Int) (s->x + s->m_nWidth); x--) { /* for each cell of empty run */
       if(run < (Int) m_vVer[x][y]) {          /* new horizontal strip < vertical strip */
-	if (m_vVer[x][y] <= m_vHor[x][y]) v[m_vVer[x][y]]--;  /* remove old value */
-	else v[m_vHor[x][y]]--;                          /* remove old value */
-	v[run]++;}                                    /* insert new value */
+	if (m_vVer[x][y] <= m_vHor[x][y]) v.decrement(m_vVer[x][y]);  /* remove old value */
+	else v.decrement(m_vHor[x][y]);                          /* remove old value */
+	v.increment(run);}                                    /* insert new value */
       m_vHor[x][y] = run;                      /* new height of vertical strip */
     }
   }
@@ -164,9 +170,7 @@ void Grid::add(const Rectangle* s) {
   Int x, y;
   Int run;              /* length of horizontal or vertical run of empty space */
 
-  for (x = (Int) s->x; x < (Int) (s->x + s->m_nWidth); x++)    /* for each column occupied by square */
-    for (y = (Int) s->y; y < (Int) (s->y + s->m_nHeight); y++)
-      operator[](x)[y] = s->m_nID;
+  draw(s->x, s->m_nWidth, s->y, s->m_nHeight, s->m_nID);
   /* update vertical grid above placement */
   for (x = (Int) s->x; x < (Int) (s->x + s->m_nWidth); x++) {/* for each column occupied by placement */
     run = 0;                                                    /* no run yet */
@@ -205,10 +209,7 @@ void Grid::add(Component* c) {
 
   Int x, y;
   Int run;              /* length of horizontal or vertical run of empty space */
-  for(x = c->m_nX; x < (Int) (c->m_nX + c->m_Dims.m_nWidth); ++x)
-    std::fill(operator[](x).begin() + c->m_nY,
-	      operator[](x).begin() + c->m_nY + c->m_Dims.m_nHeight,
-	      c->m_nID);
+  draw(c->m_nX, c->m_Dims.m_nWidth, c->m_nY, c->m_Dims.m_nHeight, c->m_nID);
 
   /* update vertical grid above placement */
   for(x = (Int) c->m_nX; x < (Int) (c->m_nX + c->m_Dims.m_nWidth); ++x) {/* for each column occupied by placement */
@@ -238,17 +239,17 @@ void Grid::add(Component* c) {
   }
 }
 
-void Grid::add(Component* c, std::vector<Int>& v) {
+void Grid::add(Component* c, WastedBins& v) {
   Int x, y;
   Int run;              /* length of horizontal or vertical run of empty space */
 
+  draw(c->m_nX, c->m_Dims.m_nWidth, c->m_nY, c->m_Dims.m_nHeight, c->m_nID);
   for(x = c->m_nX; x < (Int) (c->m_nX + c->m_Dims.m_nWidth); ++x)
     for (y = c->m_nY; y < (Int) (c->m_nY + c->m_Dims.m_nHeight); ++y) {
-      operator[](x)[y] = c->m_nID;
       if(m_vVer[x][y] <= m_vHor[x][y])
-	--v[m_vVer[x][y]];
+	v.decrement(m_vVer[x][y]);
       else
-	--v[m_vHor[x][y]];
+	v.decrement(m_vHor[x][y]);
     }
   
   for(x = (Int) c->m_nX; x < (Int) (c->m_nX + c->m_Dims.m_nWidth); ++x) {/* for each column occupied by placement */
@@ -258,9 +259,9 @@ void Grid::add(Component* c, std::vector<Int>& v) {
       else break;                    /* cell is occupied, vertical run is over */
     for (y = y + 1; y < (Int) c->m_nY; ++y) {            /* for each cell of empty run */
       if(run < (Int) m_vHor[x][y]) {          /* new vertical strip < horizontal strip */
-	if (m_vVer[x][y] <= m_vHor[x][y]) --v[m_vVer[x][y]];  /* remove old value */
-	else --v[m_vHor[x][y]];                          /* remove old value */
-	++v[run];}                                    /* insert new value */
+	if (m_vVer[x][y] <= m_vHor[x][y]) v.decrement(m_vVer[x][y]);  /* remove old value */
+	else v.decrement(m_vHor[x][y]);                          /* remove old value */
+	v.increment(run);}                                    /* insert new value */
       m_vVer[x][y] = run;                        /* new height of vertical strip */
     }
     /* update vertical grid below placement */
@@ -268,9 +269,9 @@ void Grid::add(Component* c, std::vector<Int>& v) {
     for(y = (Int) c->m_nY + c->m_Dims.m_nHeight + run - 1;
 	y >= (Int) (c->m_nY + c->m_Dims.m_nHeight); --y) {/* for each cell of empty run */
       if(run < (Int) m_vHor[x][y]) {          /* new vertical strip < horizontal strip */
-	if(m_vVer[x][y] <= m_vHor[x][y]) --v[m_vVer[x][y]];  /* remove old value */
-	else --v[m_vHor[x][y]];                          /* remove old value */
-	++v[run];                                    /* insert new value */
+	if(m_vVer[x][y] <= m_vHor[x][y]) v.decrement(m_vVer[x][y]);  /* remove old value */
+	else v.decrement(m_vHor[x][y]);                          /* remove old value */
+	v.increment(run);                                    /* insert new value */
       }
       m_vVer[x][y] = run;                       /* new height of vertical strip */
     }
@@ -283,9 +284,9 @@ void Grid::add(Component* c, std::vector<Int>& v) {
       else break;                    /* cell is occupied, vertical run is over */
     for(x = x + 1; x < (Int) c->m_nX; ++x) {            /* for each cell of empty run */
       if(run < (Int) m_vVer[x][y]) {          /* new horizontal strip < vertical strip */
-	if(m_vVer[x][y] <= m_vHor[x][y]) --v[m_vVer[x][y]];  /* remove old value */
-	else --v[m_vHor[x][y]];                          /* remove old value */
-	++v[run];                                    /* insert new value */
+	if(m_vVer[x][y] <= m_vHor[x][y]) v.decrement(m_vVer[x][y]);  /* remove old value */
+	else v.decrement(m_vHor[x][y]);                          /* remove old value */
+	v.increment(run);                                    /* insert new value */
       }
       m_vHor[x][y] = run;                        /* new height of vertical strip */
     }
@@ -294,9 +295,9 @@ void Grid::add(Component* c, std::vector<Int>& v) {
     for(x = (Int) c->m_nX + c->m_Dims.m_nWidth + run - 1;
 	x >= (Int) (c->m_nX + c->m_Dims.m_nWidth); --x) { /* for each cell of empty run */
       if(run < (Int) m_vVer[x][y]) {          /* new horizontal strip < vertical strip */
-	if(m_vVer[x][y] <= m_vHor[x][y]) --v[m_vVer[x][y]];  /* remove old value */
-	else --v[m_vHor[x][y]];                          /* remove old value */
-	++v[run];}                                    /* insert new value */
+	if(m_vVer[x][y] <= m_vHor[x][y]) v.decrement(m_vVer[x][y]);  /* remove old value */
+	else v.decrement(m_vHor[x][y]);                          /* remove old value */
+	v.increment(run);}                                    /* insert new value */
       m_vHor[x][y] = run;                      /* new height of vertical strip */
     }
   }
@@ -313,10 +314,7 @@ void Grid::del(Component* c) {
    * Undraw the component's outline.
    */
 
-  for(x = c->m_nX; x < (Int) (c->m_nX + c->m_Dims.m_nWidth); ++x)
-    std::fill(operator[](x).begin() + c->m_nY,
-	      operator[](x).begin() + c->m_nY + c->m_Dims.m_nHeight,
-	      GRIDEMPTY);
+  draw(c->m_nX, c->m_Dims.m_nWidth, c->m_nY, c->m_Dims.m_nHeight, GRIDEMPTY);
 
   for(x = c->m_nX; x < (Int) (c->m_nX + c->m_Dims.m_nWidth); ++x) {   /* each column occupied by placement */
     vert = m_vVer[x][c->m_nY];                /* old height of vertical strip */
@@ -351,6 +349,7 @@ void Grid::del(Component* c) {
 }
 
 void Grid::print() const {
+  materialize();
   printAux(*this);
 }
 
@@ -28,12 +28,24 @@
 #include "Integer.h"
 #include "Packer.h"
 #include "Component.h"
+#ifdef GRIDBITS
+#include "GridBits.h"
+#endif
 
 #define GRIDEMPTY std::numeric_limits<UInt>::max()
 
+/**
+ * With the bit-packed occupancy layer, the number of logged strokes
+ * after which the ID layer is brought up to date regardless of
+ * whether anyone has asked for it.
+ */
+
+#define GRIDBACKLOG 4096
+
 class Interval;
 class Parameters;
 class Packer;
+class WastedBins;
 
 class Grid : public std::vector<std::vector<UInt> > {
  public:
@@ -47,13 +59,20 @@ class Grid : public std::vector<std::vector<UInt> > {
 
   /**
    * Basic drawing function that doesn't update the vertical or
-   * horizontal grids.
+   * horizontal grids. When built with GRIDBITS only the occupancy
+   * bitmap is updated here and the IDs are filled in on demand.
    */
 
   void draw(Int x, Int dx, Int y, Int dy, UInt id) {
+#ifdef GRIDBITS
+    m_Bits.draw(x, dx, y, dy, id, GRIDEMPTY);
+    if(m_Bits.backlog() > GRIDBACKLOG)
+      m_Bits.flush(*this);
+#else
     for(Int i = x; i < x + dx; ++i)
       std::fill(operator[](i).begin() + y,
 		operator[](i).begin() + y + dy, id);
+#endif
   };
 
   /**
@@ -66,10 +85,11 @@ class Grid : public std::vector<std::vector<UInt> > {
    * location of the square is contained within the class object.
    *
    * @param v the histogram which indicates how many cells of each
-   * accommodating size there are.
+   * accommodating size there are. It is updated through its journal,
+   * so a mark taken beforehand lets the caller undo the placement.
    */
 
-  void add(const Rectangle* s, std::vector<Int>& v);
+  void add(const Rectangle* s, WastedBins& v);
 
   /**
    * Places the square in the location on the grid and updates the
@@ -81,7 +101,7 @@ class Grid : public std::vector<std::vector<UInt> > {
 
   void add(const Rectangle* s);
   void add(Component* c);
-  void add(Component* c, std::vector<Int>& v);
+  void add(Component* c, WastedBins& v);
   void addSimple(const Rectangle* r) {
     draw(r->x, r->m_nWidth, r->y, r->m_nHeight, r->m_nID);
   };
@@ -90,23 +110,23 @@ class Grid : public std::vector<std::vector<UInt> > {
   void del(const Rectangle* s);
   void del(Component* c);
   bool empty(const ICoords& c) const {
-    return(operator[](c.x).operator[](c.y) == GRIDEMPTY);
+    return(!cell(c.x, c.y));
   }
 
   bool empty(Int x, Int y) const {
-    return(operator[](x).operator[](y) == GRIDEMPTY);
+    return(!cell(x, y));
   }
 
   bool empty(UInt x, UInt y) const {
-    return(operator[](x).operator[](y) == GRIDEMPTY);
+    return(!cell(x, y));
   }
 
   bool empty(Int x, UInt y) const {
-    return(operator[](x).operator[](y) == GRIDEMPTY);
+    return(!cell(x, y));
   }
 
   bool empty(UInt x, Int y) const {
-    return(operator[](x).operator[](y) == GRIDEMPTY);
+    return(!cell(x, y));
   }
 
   bool empty(Int x, Int xWidth, Int y, Int yWidth) {
@@ -129,22 +149,27 @@ class Grid : public std::vector<std::vector<UInt> > {
   }
 
   UInt get(const ICoords& c) const {
+    materialize();
     return(operator[](c.x)[c.y]);
   };
   
   UInt get(Int x, Int y) const {
+    materialize();
     return(operator[](x)[y]);
   };
 
   UInt& get(Int x, Int y) {
+    materialize();
     return(operator[](x)[y]);
   };
 
   UInt get(UInt x, UInt y) const {
+    materialize();
     return(operator[](x)[y]);
   };
 
   UInt& get(UInt x, UInt y) {
+    materialize();
     return(operator[](x)[y]);
   };
 
@@ -161,7 +186,7 @@ class Grid : public std::vector<std::vector<UInt> > {
   }
 
   bool occupied(Int x, Int y) const {
-    return(operator[](x).operator[](y) != GRIDEMPTY);
+    return(cell(x, y));
   };
 
   /**
@@ -169,6 +194,9 @@ class Grid : public std::vector<std::vector<UInt> > {
    */
 
   bool occupied(UInt nx, UInt ny, UInt w, UInt h) const {
+#ifdef GRIDBITS
+    return(m_Bits.outline(nx, ny, w, h));
+#else
     for(UInt x = nx; x < nx + w; ++x)
       if(occupied(x, ny) || occupied(x, ny + h - 1))
 	return(true);
@@ -176,6 +204,7 @@ class Grid : public std::vector<std::vector<UInt> > {
       if(occupied(nx, y) || occupied(nx + w - 1, y))
 	return(true);
     return(false);
+#endif
   }
 
   bool occupied(UInt nx, UInt ny, const Dimensions& d) const {
@@ -195,10 +224,14 @@ class Grid : public std::vector<std::vector<UInt> > {
   }
 
   bool areaOccupied(UInt nx, UInt ny, UInt w, UInt h) const {
+#ifdef GRIDBITS
+    return(m_Bits.area(nx, ny, w, h));
+#else
     for(UInt x = nx; x < nx + w; ++x)
       for(UInt y = ny; y < ny + h; ++y)
 	if(occupied(x, y)) return(true);
     return(false);
+#endif
   }
 
   bool areaOccupied(const Rectangle* r) const {
@@ -227,6 +260,29 @@ class Grid : public std::vector<std::vector<UInt> > {
  private:
   void printAux(const std::vector<std::vector<UInt> >& v) const;
   void printRaw(const std::vector<std::vector<UInt> >& v) const;
+
+  bool cell(UInt x, UInt y) const {
+#ifdef GRIDBITS
+    return(m_Bits.test(x, y));
+#else
+    return(operator[](x)[y] != GRIDEMPTY);
+#endif
+  }
+
+  /**
+   * Brings the ID layer up to date with the occupancy layer.
+   */
+
+  void materialize() const {
+#ifdef GRIDBITS
+    if(m_Bits.pending())
+      m_Bits.flush(const_cast<Grid&>(*this));
+#endif
+  }
+
+#ifdef GRIDBITS
+  mutable GridBits m_Bits;
+#endif
 };
 
 #endif // GRID_H
@@ -0,0 +1,135 @@
+/**
+ * Copyright (C) 2011 Eric Huang
+ *
+ * This file is part of rectpack.
+ *
+ * rectpack is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * rectpack is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with rectpack. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "GridBits.h"
+#include <algorithm>
+
+GridBits::GridBits() :
+  m_nWords(0) {
+}
+
+GridBits::~GridBits() {
+}
+
+void GridBits::initialize(UInt nWidth, UInt nHeight) {
+  m_nWords = (nWidth + 63) >> 6;
+  m_vBits.assign(m_nWords * nHeight, 0);
+  m_vStrokes.clear();
+}
+
+void GridBits::draw(UInt x, UInt dx, UInt y, UInt dy, UInt id,
+		    UInt nEmpty) {
+  if(dx == 0 || dy == 0) return;
+  if(id == nEmpty) {
+    for(UInt j = y; j < y + dy; ++j)
+      reset(j, x, dx);
+
+    /**
+     * Undoing the most recent stroke needs no replay at all, because
+     * the cells it covered were free before it was drawn.
+     */
+
+    if(!m_vStrokes.empty()) {
+      const Stroke& s = m_vStrokes.back();
+      if(s.id != nEmpty && s.x == x && s.dx == dx &&
+	 s.y == y && s.dy == dy) {
+	m_vStrokes.pop_back();
+	return;
+      }
+    }
+  }
+  else
+    for(UInt j = y; j < y + dy; ++j)
+      set(j, x, dx);
+  Stroke s;
+  s.x = x;
+  s.dx = dx;
+  s.y = y;
+  s.dy = dy;
+  s.id = id;
+  m_vStrokes.push_back(s);
+}
+
+bool GridBits::area(UInt x, UInt y, UInt w, UInt h) const {
+  if(w == 0 || h == 0) return(false);
+  for(UInt j = y; j < y + h; ++j)
+    if(row(j, x, w)) return(true);
+  return(false);
+}
+
+bool GridBits::outline(UInt x, UInt y, UInt w, UInt h) const {
+  if(w == 0 || h == 0) return(false);
+  if(row(y, x, w) || row(y + h - 1, x, w))
+    return(true);
+  for(UInt j = y + 1; j < y + h - 1; ++j)
+    if(test(x, j) || test(x + w - 1, j))
+      return(true);
+  return(false);
+}
+
+void GridBits::flush(std::vector<std::vector<UInt> >& v) {
+  for(std::vector<Stroke>::const_iterator i = m_vStrokes.begin();
+      i != m_vStrokes.end(); ++i)
+    for(UInt x = i->x; x < i->x + i->dx; ++x)
+      std::fill(v[x].begin() + i->y, v[x].begin() + i->y + i->dy, i->id);
+  m_vStrokes.clear();
+}
+
+bool GridBits::row(UInt y, UInt x, UInt w) const {
+  const Word* p = &m_vBits[y * m_nWords];
+  UInt nFirst = x >> 6, nLast = (x + w - 1) >> 6;
+  Word nHead = ~(Word) 0 << (x & 63);
+  Word nTail = ~(Word) 0 >> (63 - ((x + w - 1) & 63));
+  if(nFirst == nLast)
+    return((p[nFirst] & nHead & nTail) != 0);
+  if(p[nFirst] & nHead) return(true);
+  for(UInt i = nFirst + 1; i < nLast; ++i)
+    if(p[i]) return(true);
+  return((p[nLast] & nTail) != 0);
+}
+
+void GridBits::set(UInt y, UInt x, UInt w) {
+  Word* p = &m_vBits[y * m_nWords];
+  UInt nFirst = x >> 6, nLast = (x + w - 1) >> 6;
+  Word nHead = ~(Word) 0 << (x & 63);
+  Word nTail = ~(Word) 0 >> (63 - ((x + w - 1) & 63));
+  if(nFirst == nLast) {
+    p[nFirst] |= nHead & nTail;
+    return;
+  }
+  p[nFirst] |= nHead;
+  for(UInt i = nFirst + 1; i < nLast; ++i)
+    p[i] = ~(Word) 0;
+  p[nLast] |= nTail;
+}
+
+void GridBits::reset(UInt y, UInt x, UInt w) {
+  Word* p = &m_vBits[y * m_nWords];
+  UInt nFirst = x >> 6, nLast = (x + w - 1) >> 6;
+  Word nHead = ~(Word) 0 << (x & 63);
+  Word nTail = ~(Word) 0 >> (63 - ((x + w - 1) & 63));
+  if(nFirst == nLast) {
+    p[nFirst] &= ~(nHead & nTail);
+    return;
+  }
+  p[nFirst] &= ~nHead;
+  for(UInt i = nFirst + 1; i < nLast; ++i)
+    p[i] = 0;
+  p[nLast] &= ~nTail;
+}
@@ -0,0 +1,98 @@
+/**
+ * Copyright (C) 2011 Eric Huang
+ *
+ * This file is part of rectpack.
+ *
+ * rectpack is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * rectpack is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with rectpack. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GRIDBITS_H
+#define GRIDBITS_H
+
+#include "Integer.h"
+#include <cstddef>
+#include <vector>
+
+/**
+ * Occupancy layer for the packing grid. Cells are stored row-major
+ * as one bit each, 64 to a word, so that emptiness and overlap tests
+ * over a rectangle reduce to a handful of masked word operations per
+ * row. The rectangle IDs for each cell are not written when a
+ * rectangle is drawn. Instead the strokes are logged and replayed
+ * into the ID layer only when somebody asks for an ID, and a stroke
+ * that is undone before that happens is simply dropped from the log.
+ */
+
+class GridBits {
+ public:
+  typedef unsigned long long Word;
+
+  GridBits();
+  ~GridBits();
+  void initialize(UInt nWidth, UInt nHeight);
+
+  /**
+   * Marks the cells covered by the given rectangle as occupied by id,
+   * or as free if id is nEmpty.
+   */
+
+  void draw(UInt x, UInt dx, UInt y, UInt dy, UInt id, UInt nEmpty);
+
+  bool test(UInt x, UInt y) const {
+    return((m_vBits[y * m_nWords + (x >> 6)] >> (x & 63)) & 1);
+  }
+
+  /**
+   * @return true if any cell of the rectangle is occupied.
+   */
+
+  bool area(UInt x, UInt y, UInt w, UInt h) const;
+
+  /**
+   * @return true if any cell on the border of the rectangle is
+   * occupied.
+   */
+
+  bool outline(UInt x, UInt y, UInt w, UInt h) const;
+
+  bool pending() const {
+    return(!m_vStrokes.empty());
+  }
+
+  size_t backlog() const {
+    return(m_vStrokes.size());
+  }
+
+  /**
+   * Replays the logged strokes into the ID layer.
+   */
+
+  void flush(std::vector<std::vector<UInt> >& v);
+
+ private:
+  class Stroke {
+  public:
+    UInt x, dx, y, dy, id;
+  };
+
+  bool row(UInt y, UInt x, UInt w) const;
+  void set(UInt y, UInt x, UInt w);
+  void reset(UInt y, UInt x, UInt w);
+
+  UInt m_nWords;
+  std::vector<Word> m_vBits;
+  std::vector<Stroke> m_vStrokes;
+};
+
+#endif // GRIDBITS_H
@@ -67,7 +67,7 @@ void GridViz::resize(int nDim) {
   m_Mutex.unlock();
 }
 
-void GridViz::add(const Rectangle* r, std::vector<Int>& v) {
+void GridViz::add(const Rectangle* r, WastedBins& v) {
   boost::this_thread::interruption_point();
   Grid::add(r, v);
   pushSStack(r);
@@ -85,7 +85,7 @@ void GridViz::add(Component* c) {
   pushCStack(c);
 }
 
-void GridViz::add(Component* c, std::vector<Int>& v) {
+void GridViz::add(Component* c, WastedBins& v) {
   boost::this_thread::interruption_point();
   Grid::add(c, v);
   pushCStack(c);
@@ -35,6 +35,7 @@ class Parameters;
 class Packer;
 class Rectangle;
 class SearchControl;
+class WastedBins;
 
 class GridViz : public Grid {
  public:
@@ -45,9 +46,9 @@ class GridViz : public Grid {
   void initialize(const BoxDimensions* pBox);
   void resize(int nDim);
   void add(const Rectangle* s);
-  void add(const Rectangle* s, std::vector<Int>& v);
+  void add(const Rectangle* s, WastedBins& v);
   void add(Component* c);
-  void add(Component* c, std::vector<Int>& v);
+  void add(Component* c, WastedBins& v);
   void addSimple(const Rectangle* s);
   void del(const Rectangle* s);
   void del(Component* c);
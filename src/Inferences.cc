@@ -22,6 +22,7 @@
 #include "GridViz.h"
 #include "Inferences.h"
 #include "Printer.h"
+#include "Probes.h"
 #include <algorithm>
 #include <iomanip>
 #include <sstream>
@@ -62,8 +63,8 @@ void Inferences::initialize(const Bins& vBins,
   m_vComponents.resize(j - i, NULL);
   m_TopSymmetries.clear();
   m_BottomSymmetries.clear();
-  m_X = Adjacency(j - i);
-  m_Y = Adjacency(j - i);
+  m_X.initialize(j - i);
+  m_Y.initialize(j - i);
   m_vBottomsAdjacent.clear();
   m_vBottomsAdjacent.resize(vBins.size(), false);
   m_lDomination.clear();
@@ -73,7 +74,7 @@ void Inferences::initialize(const Bins& vBins,
      * Set the component intoparameters.
      */
 
-    m_vComponents[k] = new Component();
+    m_vComponents[k] = m_vComponents.allocate();
     m_vComponents[k]->m_nID = k;
     m_vComponents[k]->m_nY = (*i)->y;
     m_vComponents[k]->m_Dims.initialize((*i)->m_nWidth, (*i)->m_nHeight);
@@ -97,6 +98,7 @@ void Inferences::findSymmetries() {
 }
 
 void Inferences::compute() {
+  PROBE(PROBE_INFERENCES);
 
   /**
    * Applies all inferences rules until we've reached a steady
@@ -147,15 +149,15 @@ bool Inferences::consolidateComponentsH() {
    * except for those in m_vComponents.
    */
 
-  boost::graph_traits<Adjacency>::edge_iterator ei, ei_end;
-  for(boost::tie(ei, ei_end) = boost::edges(m_X); ei != ei_end; ++ei) {
-    UInt n1(boost::source(*ei, m_X)), n2(boost::target(*ei, m_X));
-    if((m_vComponents[n1]->m_nY != m_vComponents[n2]->m_nY) ||
-       (m_vComponents[n1]->m_Dims.m_nHeight != m_vComponents[n2]->m_Dims.m_nHeight))
-      continue;
-    replace(n1, n2, combineH(n1, n2));
-    return(true);
-  }
+  for(UInt n1 = 0; n1 < m_X.size(); ++n1)
+    for(UInt n2 = m_X.next(n1, n1); n2 < m_X.size();
+	n2 = m_X.next(n1, n2)) {
+      if((m_vComponents[n1]->m_nY != m_vComponents[n2]->m_nY) ||
+	   (m_vComponents[n1]->m_Dims.m_nHeight != m_vComponents[n2]->m_Dims.m_nHeight))
+	continue;
+      replace(n1, n2, combineH(n1, n2));
+      return(true);
+    }
 
   /**
    * Iterate over all of the vertices and see if any have more than
@@ -163,23 +165,22 @@ bool Inferences::consolidateComponentsH() {
    */
 
   for(UInt i = 0; i < m_vComponents.size(); ++i) {
-    if(boost::out_degree(i, m_Y) < 2) continue;
-    boost::graph_traits<Adjacency>::adjacency_iterator vi, vi_end;
-    boost::tie(vi, vi_end) = boost::adjacent_vertices(i, m_Y);
-    UInt nHeight = m_vComponents[*vi]->m_Dims.m_nHeight;
-    UInt y = m_vComponents[*vi]->m_nY;
-    UInt nWidth = m_vComponents[*vi]->m_Dims.m_nWidth;
+    if(m_Y.degree(i) < 2) continue;
+    UInt v = m_Y.first(i);
+    UInt nHeight = m_vComponents[v]->m_Dims.m_nHeight;
+    UInt y = m_vComponents[v]->m_nY;
+    UInt nWidth = m_vComponents[v]->m_Dims.m_nWidth;
     std::list<UInt> l;
-    l.push_back(*vi);
-    for(++vi; vi != vi_end; ++vi) {
-      if(m_vComponents[*vi]->m_Dims.m_nHeight != nHeight ||
-	 m_vComponents[*vi]->m_nY != (int) y) break;
+    l.push_back(v);
+    for(v = m_Y.next(i, v); v < m_Y.size(); v = m_Y.next(i, v)) {
+      if(m_vComponents[v]->m_Dims.m_nHeight != nHeight ||
+	 m_vComponents[v]->m_nY != (int) y) break;
       else {
-	nWidth += m_vComponents[*vi]->m_Dims.m_nWidth;
-	l.push_back(*vi);
+	nWidth += m_vComponents[v]->m_Dims.m_nWidth;
+	l.push_back(v);
       }
     }
-    if((vi == vi_end) && (nWidth == m_vComponents[i]->m_Dims.m_nWidth)) {
+    if((v == m_Y.size()) && (nWidth == m_vComponents[i]->m_Dims.m_nWidth)) {
       replace(l, combineH(l));
       return(true);
     }
@@ -402,10 +403,10 @@ void Inferences::replace(UInt n1, UInt n2, UInt nNew) {
    * perform the necessary remapping.
    */
 
-  boost::add_vertex(m_X);
-  boost::add_vertex(m_Y);
-  boost::remove_edge(n1, n2, m_X);
-  boost::remove_edge(n1, n2, m_Y);
+  m_X.addVertex();
+  m_Y.addVertex();
+  m_X.removeEdge(n1, n2);
+  m_Y.removeEdge(n1, n2);
   remap(n1, nNew, m_X);
   remap(n2, nNew, m_X);
   remap(n1, nNew, m_Y);
@@ -413,23 +414,13 @@ void Inferences::replace(UInt n1, UInt n2, UInt nNew) {
 }
 
 void Inferences::remap(UInt nOld, UInt nNew, Adjacency& g) {
-  boost::graph_traits<Adjacency>::adjacency_iterator vi, vi_end;
-  for(boost::tie(vi, vi_end) = boost::adjacent_vertices(nOld, g); vi != vi_end; ++vi)
-    if(!boost::edge(*vi, nNew, g).second)
-      boost::add_edge(*vi, nNew, g);
-  boost::clear_vertex(nOld, g);
+  g.merge(nOld, nNew);
 }
 
 void Inferences::remap(const std::list<UInt>& l, UInt nNew,
 		       Adjacency& g) {
-  for(std::list<UInt>::const_iterator i = l.begin(); i != l.end(); ++i) {
-    boost::graph_traits<Adjacency>::adjacency_iterator vi, vi_end;
-    for(boost::tie(vi, vi_end) = boost::adjacent_vertices(*i, g); vi != vi_end; ++vi)
-      if(!boost::edge(*vi, nNew, g).second)
-	boost::add_edge(*vi, nNew, g);
-  }
   for(std::list<UInt>::const_iterator i = l.begin(); i != l.end(); ++i)
-    boost::clear_vertex(*i, g);
+    g.merge(*i, nNew);
 }
 
 
@@ -602,10 +593,10 @@ bool Inferences::boundsAdjacency(UInt nWidth, UInt nRest, bool bBottom,
      */
 
     if(canFill(nStart, nEnd, n1, n2, nSpace) ||
-       boost::edge(n1, n2, m_X).second)
+       m_X.edge(n1, n2))
       return(false);
     else {
-      boost::add_edge(n1, n2, m_X);
+      m_X.addEdge(n1, n2);
       return(true);
     }
   }
@@ -662,28 +653,28 @@ bool Inferences::updateAdjacencyList(UInt nBottomItems,
 				     const std::set<UInt>& s2) {
   bool bWorkDone = false;
   if((nBottomItems == 2 && s1.size() == 2) &&
-     (!boost::edge(*s1.begin(), *s1.rbegin(), m_X).second)) {
+     (!m_X.edge(*s1.begin(), *s1.rbegin()))) {
     bWorkDone = true;
-    boost::add_edge(*s1.begin(), *s1.rbegin(), m_X);
+    m_X.addEdge(*s1.begin(), *s1.rbegin());
   }
   if((nTopItems == 2 && s2.size() == 2) &&
-     (!boost::edge(*s2.begin(), *s2.rbegin(), m_X).second)) {
+     (!m_X.edge(*s2.begin(), *s2.rbegin()))) {
     bWorkDone = true;
-    boost::add_edge(*s2.begin(), *s2.rbegin(), m_X);
+    m_X.addEdge(*s2.begin(), *s2.rbegin());
   }
   if(nBottomItems == 1 && s1.size() == 1)
     for(std::set<UInt>::const_iterator i = s2.begin();
 	i != s2.end(); ++i)
-      if(!boost::edge(*s1.begin(), *i, m_Y).second) {
+      if(!m_Y.edge(*s1.begin(), *i)) {
 	bWorkDone = true;
-	boost::add_edge(*s1.begin(), *i, m_Y);
+	m_Y.addEdge(*s1.begin(), *i);
       }
   if(nTopItems == 1 && s2.size() == 1)
     for(std::set<UInt>::const_iterator i = s1.begin();
 	i != s1.end(); ++i)
-      if(!boost::edge(*s2.begin(), *i, m_Y).second) {
+      if(!m_Y.edge(*s2.begin(), *i)) {
 	bWorkDone = true;
-	boost::add_edge(*s2.begin(), *i, m_Y);
+	m_Y.addEdge(*s2.begin(), *i);
       }
   return(bWorkDone);
 }
@@ -768,32 +759,29 @@ void Inferences::print2() const {
 
   std::cout << "Adjacency Graphs:" << std::endl;
   UInt nMaxX = 0;
-  boost::graph_traits<Adjacency>::vertex_iterator vi, vi_end;
-  for(tie(vi, vi_end) = boost::vertices(m_X); vi != vi_end; ++vi)
-    nMaxX = std::max(nMaxX, (UInt) boost::out_degree(*vi, m_X));
+  for(UInt i = 0; i < m_X.size(); ++i)
+    nMaxX = std::max(nMaxX, (UInt) m_X.degree(i));
   UInt nMaxXWidth = nMaxX * 5 + nMaxX - 1 + 2;
   t1 = 8 + nMaxXWidth;
   for(UInt i = 0; i < m_vComponents.size(); ++i) {
     std::ostringstream oss;
     oss << std::setw(5) << m_vComponents[i]->m_Dims
 	<< " x={";
-    if(boost::out_degree(i, m_X) > 0) {
-      boost::graph_traits<Adjacency>::adjacency_iterator ji, ji_end;
-      tie(ji, ji_end) = boost::adjacent_vertices(i, m_X);
-      oss << m_vComponents[*ji]->m_Dims;
-      for(++ji; ji != ji_end; ++ji)
-	oss << "," << m_vComponents[*ji]->m_Dims;
+    if(m_X.degree(i) > 0) {
+      UInt j = m_X.first(i);
+      oss << m_vComponents[j]->m_Dims;
+      for(j = m_X.next(i, j); j < m_X.size(); j = m_X.next(i, j))
+	oss << "," << m_vComponents[j]->m_Dims;
     }
     oss << "}";
     while(oss.str().size() < t1)
       oss << " ";
     oss << " y={";
-    if(boost::out_degree(i, m_Y) > 0) {
-      boost::graph_traits<Adjacency>::adjacency_iterator ji, ji_end;
-      tie(ji, ji_end) = boost::adjacent_vertices(i, m_Y);
-      oss << m_vComponents[*ji]->m_Dims;
-      for(++ji; ji != ji_end; ++ji)
-	oss << "," << m_vComponents[*ji]->m_Dims;
+    if(m_Y.degree(i) > 0) {
+      UInt j = m_Y.first(i);
+      oss << m_vComponents[j]->m_Dims;
+      for(j = m_Y.next(i, j); j < m_Y.size(); j = m_Y.next(i, j))
+	oss << "," << m_vComponents[j]->m_Dims;
     }
     oss << "}";
     std::cout << oss.str() << std::endl;
@@ -880,32 +868,29 @@ void Inferences::print() const {
 
   std::cout << "Adjacency Graphs:" << std::endl;
   UInt nMaxX = 0;
-  boost::graph_traits<Adjacency>::vertex_iterator vi, vi_end;
-  for(tie(vi, vi_end) = boost::vertices(m_X); vi != vi_end; ++vi)
-    nMaxX = std::max(nMaxX, (UInt) boost::out_degree(*vi, m_X));
+  for(UInt i = 0; i < m_X.size(); ++i)
+    nMaxX = std::max(nMaxX, (UInt) m_X.degree(i));
   UInt nMaxXWidth = nMaxX * 2 + nMaxX - 1 + 2;
   t1 = 5 + nMaxXWidth;
   for(UInt i = 0; i < m_vComponents.size(); ++i) {
     std::ostringstream oss;
     oss << std::setw(2) << i
 	<< " x={";
-    if(boost::out_degree(i, m_X) > 0) {
-      boost::graph_traits<Adjacency>::adjacency_iterator ji, ji_end;
-      tie(ji, ji_end) = boost::adjacent_vertices(i, m_X);
-      oss << *ji;
-      for(++ji; ji != ji_end; ++ji)
-	oss << "," << *ji;
+    if(m_X.degree(i) > 0) {
+      UInt j = m_X.first(i);
+      oss << j;
+      for(j = m_X.next(i, j); j < m_X.size(); j = m_X.next(i, j))
+	oss << "," << j;
     }
     oss << "}";
     while(oss.str().size() < t1)
       oss << " ";
     oss << " y={";
-    if(boost::out_degree(i, m_Y) > 0) {
-      boost::graph_traits<Adjacency>::adjacency_iterator ji, ji_end;
-      tie(ji, ji_end) = boost::adjacent_vertices(i, m_Y);
-      oss << *ji;
-      for(++ji; ji != ji_end; ++ji)
-	oss << "," << *ji;
+    if(m_Y.degree(i) > 0) {
+      UInt j = m_Y.first(i);
+      oss << j;
+      for(j = m_Y.next(i, j); j < m_Y.size(); j = m_Y.next(i, j))
+	oss << "," << j;
     }
     oss << "}";
     std::cout << oss.str() << std::endl;
@@ -923,9 +908,9 @@ void Inferences::print() const {
 }
 
 int Inferences::newComponent() {
-  boost::add_vertex(m_X);
-  boost::add_vertex(m_Y);
-  m_vComponents.push_back(new Component());
+  m_X.addVertex();
+  m_Y.addVertex();
+  m_vComponents.push_back(m_vComponents.allocate());
   return(m_vComponents.back()->m_nID = m_vComponents.size() - 1);
 }
 
@@ -979,8 +964,8 @@ void Inferences::updateAdjacency(const BoxDimensions& b) {
 	 m_XDist.yOverlaps(i, j)) {
 	UInt m = m_XDist.m_vComponents[i]->m_nID;
 	UInt n = m_XDist.m_vComponents[j]->m_nID;
-	if(!boost::edge(m, n, m_X).second)
-	  boost::add_edge(m, n, m_X);
+	if(!m_X.edge(m, n))
+	  m_X.addEdge(m, n);
       }
 }
 
@@ -1084,13 +1069,13 @@ void Inferences::surroundingHeight(UInt h, const std::set<UInt>& s,
    * the given set.
    */
 
-  boost::graph_traits<Adjacency>::edge_iterator ei, ei_end;
-  for(boost::tie(ei, ei_end) = boost::edges(m_X); ei != ei_end; ++ei) {
-    UInt n1(boost::source(*ei, m_X)), n2(boost::target(*ei, m_X));
-    if(s.find(n1) != s.end() && s.find(n2) != s.end()) {
-      ++m[n1]; ++m[n2];
+  for(UInt n1 = 0; n1 < m_X.size(); ++n1)
+    for(UInt n2 = m_X.next(n1, n1); n2 < m_X.size();
+	n2 = m_X.next(n1, n2)) {
+      if(s.find(n1) != s.end() && s.find(n2) != s.end()) {
+	++m[n1]; ++m[n2];
+      }
     }
-  }
 
   /**
    * Now we verify that exactly two have a count of 1 and everything
@@ -1145,13 +1130,13 @@ bool Inferences::isBookEnd(UInt c, const std::set<UInt>& s) const {
    * the given set.
    */
 
-  boost::graph_traits<Adjacency>::edge_iterator ei, ei_end;
-  for(boost::tie(ei, ei_end) = boost::edges(m_X); ei != ei_end; ++ei) {
-    UInt n1(boost::source(*ei, m_X)), n2(boost::target(*ei, m_X));
-    if(s.find(n1) != s.end() && s.find(n2) != s.end()) {
-      ++m[n1]; ++m[n2];
+  for(UInt n1 = 0; n1 < m_X.size(); ++n1)
+    for(UInt n2 = m_X.next(n1, n1); n2 < m_X.size();
+	n2 = m_X.next(n1, n2)) {
+      if(s.find(n1) != s.end() && s.find(n2) != s.end()) {
+	++m[n1]; ++m[n2];
+      }
     }
-  }
 
   /**
    * Now we verify that exactly two have a count of 1 and everything
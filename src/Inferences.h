@@ -23,7 +23,6 @@
 #include <vector>
 #include <map>
 #include <set>
-#include <boost/graph/adjacency_list.hpp>
 #include "AlignedComponents.h"
 #include "AlignedCongruencies.h"
 #include "Bins.h"
@@ -52,8 +51,7 @@ class Inferences {
    * the upper bound.
    */
 
-  typedef boost::adjacency_list<boost::listS, boost::vecS, boost::undirectedS> Adjacency;
-  typedef boost::graph_traits<Adjacency> AdjacencyTraits;
+  typedef UpperDistance::Adjacency Adjacency;
   Inferences();
   ~Inferences();
   void clear();
@@ -111,16 +111,19 @@ bool IntBalOpt::packY(size_t i) {
    * compression call.
    */
 
-  m_vY.m_vRectangles.push_back(r);
+  m_vY.place(r);
   IntDomains* pDomain = &m_vDomains.get(r);
   for(IntDomains::iterator j = pDomain->begin();
       j != pDomain->end(); ++j) {
+    if(!claim(i)) continue;
+    if(!m_Checkpoint.enter(r, j->m_nBegin, j->m_nEnd)) continue;
     m_Nodes.tick(YI);
     m_vY.m_vDomain[r->m_nID] = r->yi = *j;
     m_vY.pushyi(r);
     if(waste(i + 1))
       return(true);
     m_vY.popyi(r);
+    m_Checkpoint.leave();
   }
   return(false);
 }
@@ -152,6 +155,8 @@ bool IntBalOpt::location(size_t i) {
       if(r->yi.empty()) continue;
     }
     if(!m_vY.canFityi(r)) continue;
+    if(!claim(i)) continue;
+    if(!m_Checkpoint.enter(r, r->yi.m_nBegin, r->yi.m_nEnd)) continue;
     m_Nodes.tick(YI);
     m_vY.m_vDomain[r->m_nID] = r->yi;
     m_vY.pushyi(r);
@@ -159,6 +164,7 @@ bool IntBalOpt::location(size_t i) {
       if(waste(i + 1))
 	return(true);
     m_vY.popyi(r);
+    m_Checkpoint.leave();
   }
   return(false);
 }
@@ -182,7 +188,7 @@ bool IntBalOpt::packcra() {
 }
 
 bool IntBalOpt::searchSpace(size_t i) {
-  if(bQuit) return(false);
+  if(cancelled()) return(false);
   if(i == m_Branches.size()) {
     for(size_t i = 0; i < m_Branches.size(); ++i) {
       Rectangle* r = m_Branches[i].m_pRect;
@@ -218,13 +224,13 @@ size_t IntBalOpt::bestStripArea(Rectangle*& r) {
   if(!m_bVarOrder) return(std::numeric_limits<size_t>::max());
   
   size_t nMax(0);
-  for(std::vector<const Rectangle*>::const_iterator i = m_vY.m_vRectangles.begin();
+  const RectColumns& c(m_vY.m_vColumns);
+  for(std::vector<UInt>::const_iterator i = m_vY.m_vRectangles.begin();
       i != m_vY.m_vRectangles.end(); ++i) {
-    size_t t = (*i)->m_nWidth *
-      ((*i)->m_nHeight - m_vY.m_vDomain[(*i)->m_nID].m_nWidth);
+    size_t t = c.m_vWidth[*i] * (c.m_vHeight[*i] - m_vY.m_vDomain[*i].m_nWidth);
     if(t > nMax) {
       nMax = t;
-      r = m_vRectPtrs[(*i)->m_nID];
+      r = m_vRectPtrs[*i];
     }
   }
   return(nMax);
@@ -235,11 +241,13 @@ bool IntBalOpt::strips(Rectangle* r, size_t i) {
       r->y <= (size_t) m_vY.m_vDomain[r->m_nID].m_nEnd; ++r->y) {
     m_Nodes.tick(YF);
     if(!m_vY.canFitStrips(r)) continue;
+    if(!m_Checkpoint.enter(r, r->y, r->y)) continue;
     m_vY.pushStripsy(r);
     if(m_vY.compress())
       if(waste(i))
 	return(true);
     m_vY.popStripsy(r);
+    m_Checkpoint.leave();
   }
   return(false);
 }
@@ -24,6 +24,7 @@
 #include "Packer.h"
 #include "GridViz.h"
 #include "Grid.h"
+#include "HeapBox.h"
 #include "Parameters.h"
 #include "Perfect.h"
 #include "Placements.h"
@@ -39,7 +40,11 @@ IntPack::IntPack() :
   m_pGrid(NULL),
   m_pDomination(NULL),
   m_pDomTemplate(NULL),
-  m_pPerfect(NULL) {
+  m_pPerfect(NULL),
+  m_nSplit(1),
+  m_nSplitIndex(0),
+  m_nSplitDepth(0),
+  m_nSplitBranch(0) {
   m_bYSmallerThanX = true;
   m_bCanBuildDomination = true;
   m_pPerfect = new Perfect();
@@ -99,11 +104,21 @@ void IntPack::initialize(const Parameters* pParams) {
 
   m_pPerfect->initialize(pParams->m_s2);
   m_pPerfect->initialize(&m_nCuSP, &m_Box, &m_XTime, m_pGrid,
-			 &m_Nodes);
+			 &m_Nodes, &m_bCancel);
+
+  /**
+   * The split workers each search only part of the tree, so a path
+   * of one of them says nothing about the others.
+   */
+
+  if(m_nSplit <= 1)
+    m_Checkpoint.initialize(pParams, m_vOriginalRects, &m_vRects,
+			    &m_Nodes, &m_bCancel);
 }
 
 void IntPack::initialize(const HeapBox* pBox) {
   Packer::initialize(pBox);
+  m_nSplitBranch = 0;
 
   /**
    * Initialize the domination tables.
@@ -145,12 +160,33 @@ void IntPack::initialize(const HeapBox* pBox) {
    */
 
   m_pPerfect->initWastedSpace();
+  m_Checkpoint.begin(pBox->m_Box);
 }
 
 void IntPack::initialize(const BoundingBoxes* pBoxes) {
   Packer::initialize(pBoxes);
 }
 
+bool IntPack::pack(const HeapBox& b) {
+  bool bResult(Packer::pack(b));
+
+  /**
+   * A snapshot that doesn't lead the search back to where it was
+   * taken can't tell us which branches were already searched, so we
+   * start the box over without it.
+   */
+
+  if(!bResult && !cancelled() && m_Checkpoint.mismatch()) {
+    std::cout << "The checkpoint of the " << b.m_Box.m_nWidth << "x"
+	      << b.m_Box.m_nHeight << " box does not match the search. "
+	      << "Starting the box over." << std::endl;
+    m_Checkpoint.discard();
+    bResult = Packer::pack(b);
+  }
+  m_Checkpoint.end();
+  return(bResult);
+}
+
 void IntPack::finalizeDomination() {
   if(m_pParams->breakVerticalSymmetry()) {
     if(m_vRects[0].rotatable()) {
@@ -263,6 +299,16 @@ TimeSpec& IntPack::timeDomination() {
   return(m_pDomination->m_Time);
 }
 
+void IntPack::wastedSpace(UInt& nYTests, UInt& nYPrunes,
+			  UInt& nXTests, UInt& nXPrunes) const {
+  nYTests += m_vY.m_vWaste.m_nTests;
+  nYPrunes += m_vY.m_vWaste.m_nPrunes;
+  if(m_pPerfect) {
+    nXTests += m_pPerfect->m_vWastedX.m_nTests;
+    nXPrunes += m_pPerfect->m_vWastedX.m_nPrunes;
+  }
+}
+
 bool IntPack::packX() {
   if(m_pParams->m_bScheduling) {
     for(RectPtrArray::iterator i = m_vRectPtrs.begin();
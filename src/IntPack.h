@@ -21,6 +21,7 @@
 #define INTPACK_H
 
 #include "Bins.h"
+#include "Checkpoint.h"
 #include "Integer.h"
 #include "Packer.h"
 #include "RectPtrArray.h"
@@ -31,6 +32,7 @@ class BoxDimensions;
 class Domination;
 class Grid;
 class GridViz;
+class HeapBox;
 class Parameters;
 class Perfect;
 class Placements;
@@ -45,6 +47,7 @@ class IntPack : public Packer {
   virtual void initialize(const HeapBox* pBox);
   virtual void initialize(const BoundingBoxes* pBoxes);
   virtual void finalizeDomination();
+  virtual bool pack(const HeapBox& b);
 
   /**
    * After packing the first dimension, this call packs the second
@@ -75,12 +78,42 @@ class IntPack : public Packer {
   Domination* m_pDomination;
   Domination* m_pDomTemplate;
   virtual TimeSpec& timeDomination();
+  virtual void wastedSpace(UInt& nYTests, UInt& nYPrunes,
+			   UInt& nXTests, UInt& nXPrunes) const;
 
   /**
    * Packing mechanism for the second dimension.
    */
 
   Perfect* m_pPerfect;
+
+  /**
+   * Intra-box parallelism. When m_nSplit exceeds one, this packer is
+   * one of m_nSplit workers sharing a single bounding box (see
+   * SplitPacker). The first-dimension assignments made at depth
+   * m_nSplitDepth are numbered in the order in which they are
+   * generated, and this worker only explores those that are
+   * congruent to m_nSplitIndex. Every worker expands the shallower
+   * nodes itself, which keeps the numbering identical across
+   * workers.
+   */
+
+  bool claim(size_t nDepth) {
+    if(m_nSplit <= 1 || nDepth != m_nSplitDepth) return(true);
+    return(m_nSplitBranch++ % m_nSplit == m_nSplitIndex);
+  }
+  UInt m_nSplit;
+  UInt m_nSplitIndex;
+  size_t m_nSplitDepth;
+  unsigned long long m_nSplitBranch;
+
+  /**
+   * Snapshots of the first-dimension search, which the packers keep
+   * up to date by reporting each of their branches to enter() and
+   * each retraction to leave(). Not used by the split workers.
+   */
+
+  Checkpoint m_Checkpoint;
 };
 
 #endif // INTPACK_H
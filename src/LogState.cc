@@ -189,6 +189,22 @@ bool LogState::load(const std::string& s) {
       }
       break;
     }
+
+  /**
+   * Only runs with a box store report the boxes recalled from it,
+   * which count towards the box numbers as well.
+   */
+
+  m_nRecalled = 0;
+  for(std::list<std::string>::iterator j = i;
+      j != m_lLog.end() && j->find("Optimal Solution") >= j->size(); ++j)
+    if(j->find("Boxes Recalled") < j->size()) {
+      if(!getNodes(*j, m_nRecalled)) {
+	std::cout << "Unable to parse line Boxes Recalled." << std::endl;
+	return(false);
+      }
+      break;
+    }
   for(; i != m_lLog.end(); ++i)
     if(i->find("Optimal Solution") < i->size()) {
       if(!getString(*i, m_sSolutions)) {
@@ -49,6 +49,7 @@ class LogState {
   NodeCount m_vNodes;
   unsigned long long m_nCuSP;
   unsigned long long m_nBoxes;
+  unsigned long long m_nRecalled;
   std::string m_sSolutions;
 };
 
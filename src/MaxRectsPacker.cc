@@ -0,0 +1,122 @@
+/**
+ * Copyright (C) 2011 Eric Huang
+ *
+ * This file is part of rectpack.
+ *
+ * rectpack is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * rectpack is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with rectpack. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MaxRectsPacker.h"
+#include <algorithm>
+
+MaxRectsPacker::MaxRectsPacker() {
+}
+
+MaxRectsPacker::~MaxRectsPacker() {
+}
+
+const char* MaxRectsPacker::name() const {
+  return("maximal rectangles");
+}
+
+void MaxRectsPacker::pack(UInt nWidth, std::vector<StripItem>& v) {
+
+  /**
+   * The strip is tall enough to stack every item on top of each
+   * other, so the free space never runs out.
+   */
+
+  UInt nHeight(0);
+  for(std::vector<StripItem>::const_iterator i = v.begin();
+      i != v.end(); ++i)
+    nHeight += std::max(i->m_nWidth, i->m_nHeight);
+  m_vFree.assign(1, Free(0, 0, nWidth, nHeight));
+
+  for(std::vector<StripItem>::iterator i = v.begin(); i != v.end(); ++i) {
+    bool bFound(false), bRotated(false);
+    UInt nX(0), nY(0), nTop(0);
+    for(int r = 0; r < (i->m_bRotatable ? 2 : 1); ++r) {
+      i->m_bRotated = (r == 1);
+      UInt w = i->width(), h = i->height();
+      for(std::vector<Free>::const_iterator f = m_vFree.begin();
+	  f != m_vFree.end(); ++f)
+	if(w <= f->m_nWidth && h <= f->m_nHeight &&
+	   (!bFound || f->m_nY + h < nTop ||
+	    (f->m_nY + h == nTop && f->m_nX < nX))) {
+	  bFound = true;
+	  bRotated = i->m_bRotated;
+	  nX = f->m_nX;
+	  nY = f->m_nY;
+	  nTop = f->m_nY + h;
+	}
+    }
+    i->m_bRotated = bRotated;
+    i->m_nX = nX;
+    i->m_nY = nY;
+    split(nX, nY, i->width(), i->height());
+    prune();
+  }
+}
+
+void MaxRectsPacker::split(UInt x, UInt y, UInt w, UInt h) {
+
+  /**
+   * Every free rectangle that the item intersects is replaced by the
+   * (up to four) maximal pieces of it lying left, right, below and
+   * above the item.
+   */
+
+  m_vScratch.clear();
+  for(std::vector<Free>::const_iterator f = m_vFree.begin();
+      f != m_vFree.end(); ++f) {
+    UInt fx2 = f->m_nX + f->m_nWidth, fy2 = f->m_nY + f->m_nHeight;
+    if(x >= fx2 || f->m_nX >= x + w || y >= fy2 || f->m_nY >= y + h) {
+      m_vScratch.push_back(*f);
+      continue;
+    }
+    if(x > f->m_nX)
+      m_vScratch.push_back(Free(f->m_nX, f->m_nY, x - f->m_nX,
+				f->m_nHeight));
+    if(x + w < fx2)
+      m_vScratch.push_back(Free(x + w, f->m_nY, fx2 - x - w,
+				f->m_nHeight));
+    if(y > f->m_nY)
+      m_vScratch.push_back(Free(f->m_nX, f->m_nY, f->m_nWidth,
+				y - f->m_nY));
+    if(y + h < fy2)
+      m_vScratch.push_back(Free(f->m_nX, y + h, f->m_nWidth,
+				fy2 - y - h));
+  }
+  m_vFree.swap(m_vScratch);
+}
+
+void MaxRectsPacker::prune() {
+
+  /**
+   * Drop the free rectangles contained in another. Of two identical
+   * ones, the first is kept.
+   */
+
+  m_vScratch.clear();
+  for(size_t i = 0; i < m_vFree.size(); ++i) {
+    bool bContained(false);
+    for(size_t j = 0; j < m_vFree.size() && !bContained; ++j)
+      if(i != j && m_vFree[j].contains(m_vFree[i]) &&
+	 (j < i || !m_vFree[i].contains(m_vFree[j])))
+	bContained = true;
+    if(!bContained)
+      m_vScratch.push_back(m_vFree[i]);
+  }
+  m_vFree.swap(m_vScratch);
+}
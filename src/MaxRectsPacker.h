@@ -0,0 +1,63 @@
+/**
+ * Copyright (C) 2011 Eric Huang
+ *
+ * This file is part of rectpack.
+ *
+ * rectpack is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * rectpack is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with rectpack. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MAXRECTSPACKER_H
+#define MAXRECTSPACKER_H
+
+#include "StripPacker.h"
+
+/**
+ * Tracks the empty space as the set of maximal free rectangles (which
+ * may overlap one another), and puts each item into the corner of the
+ * free rectangle where its top edge ends up lowest, preferring the
+ * leftmost one. Unlike the skyline, holes left under overhangs remain
+ * available to later items.
+ */
+
+class MaxRectsPacker : public StripPacker {
+ public:
+  MaxRectsPacker();
+  virtual ~MaxRectsPacker();
+  virtual const char* name() const;
+  virtual void pack(UInt nWidth, std::vector<StripItem>& v);
+
+ private:
+  class Free {
+  public:
+    Free(UInt x, UInt y, UInt w, UInt h) :
+      m_nX(x), m_nY(y), m_nWidth(w), m_nHeight(h) {}
+    bool contains(const Free& f) const {
+      return(m_nX <= f.m_nX && m_nY <= f.m_nY &&
+	     f.m_nX + f.m_nWidth <= m_nX + m_nWidth &&
+	     f.m_nY + f.m_nHeight <= m_nY + m_nHeight);
+    }
+    UInt m_nX;
+    UInt m_nY;
+    UInt m_nWidth;
+    UInt m_nHeight;
+  };
+
+  void split(UInt x, UInt y, UInt w, UInt h);
+  void prune();
+
+  std::vector<Free> m_vFree;
+  std::vector<Free> m_vScratch;
+};
+
+#endif // MAXRECTSPACKER_H
@@ -20,6 +20,7 @@
 #include "AsciiGrid.h"
 #include "MetaCSP.h"
 #include "Parameters.h"
+#include <limits>
 #include <stdlib.h>
 
 MetaCSP::MetaCSP() {
@@ -33,8 +34,9 @@ bool MetaCSP::pack() {
   m_vStack.clear();
   m_vStack.reserve(m_vVariableDescs.size());
   m_vStack.resize(1);
-  m_vStack.back().initialize(m_vVariableDescs);
+  m_vStack.back().initialize(m_vVariableDescs, &m_XMatrix, &m_YMatrix);
   m_Best.clear();
+  m_Best.m_nArea = std::numeric_limits<UInt>::max();
   m_nBestReplacements = 0;
 
   if(m_vRectPtrs.size() == 1) {
@@ -119,6 +121,13 @@ void MetaCSP::branchOn(MetaFrame::VarIter& i) {
 
   std::vector<int> v;
   valueOrdering(i, v);
+
+  /**
+   * Pushing a frame may reallocate the stack and invalidate i, so we
+   * hold on to the variable itself.
+   */
+
+  const MetaVarDesc* pDesc(i->first);
   
   /**
    * Iterate over each possible value in the domain.
@@ -141,26 +150,16 @@ void MetaCSP::branchOn(MetaFrame::VarIter& i) {
 
     m_vStack.push_back(MetaFrame(m_vStack.back()));
     MetaFrame* pCurrent = &m_vStack.back();
-    pCurrent->assign(i->first, (MetaDomain::ValueT) *j);
+    pCurrent->assign(pDesc, (MetaDomain::ValueT) *j);
+    m_XMatrix.mark();
+    m_YMatrix.mark();
 
     /**
      * Assert our constraint into our APSP and check it for negative
      * cycles.
      */
 
-    if(*j == MetaDomain::ABOVE || *j == MetaDomain::BELOW)
-      pCurrent->m_vYMatrix.assign(i->first, *j);
-
-    /**
-     * @TODO Optimizations may be performed here, by focusing on
-     * only propagating the changes that we've made instead of
-     * recomputing the entire matrix.
-     */
-
-    else
-      pCurrent->m_vXMatrix.assign(i->first, *j);
-
-    if(computeAPSP()) {
+    if(computeAPSP(pDesc, *j)) {
 
       /**
        * Subsume variables.
@@ -200,27 +199,30 @@ void MetaCSP::branchOn(MetaFrame::VarIter& i) {
      */
     
     m_vStack.pop_back();
-    semanticBranching(i, *j);
+    m_XMatrix.undo();
+    m_YMatrix.undo();
+    semanticBranching(pDesc, *j);
   }
 }
 
-void MetaCSP::semanticBranching(MetaFrame::VarIter& v, int n) {
+void MetaCSP::semanticBranching(const MetaVarDesc* pDesc, int n) {
   MetaFrame* pCurrent = &m_vStack.back();
+  bool bConsistent;
   if(n == MetaDomain::LEFTOF || n == MetaDomain::RIGHTOF)
-    pCurrent->m_vXMatrix.negate(v->first, n);
+    bConsistent = m_XMatrix.negate(pDesc, n);
   else
-    pCurrent->m_vYMatrix.negate(v->first, n);
+    bConsistent = m_YMatrix.negate(pDesc, n);
+  if(!bConsistent)
+    pCurrent->m_bNegativeCycle = true;
 }
 
-bool MetaCSP::computeAPSP() {
-  MetaFrame* pCurrent = &m_vStack.back();
-  pCurrent->m_vXMatrix.floydWarshall();
-  if(pCurrent->m_vXMatrix.negativeCycles())
-    return(false);
-  pCurrent->m_vYMatrix.floydWarshall();
-  if(pCurrent->m_vYMatrix.negativeCycles())
+bool MetaCSP::computeAPSP(const MetaVarDesc* pDesc, int n) {
+  if(m_vStack.back().m_bNegativeCycle)
     return(false);
-  return(true);
+  if(n == MetaDomain::ABOVE || n == MetaDomain::BELOW)
+    return(m_YMatrix.assign(pDesc, n));
+  else
+    return(m_XMatrix.assign(pDesc, n));
 }
 
 bool MetaCSP::allAssigned() const {
@@ -550,19 +552,19 @@ void MetaCSP::valueOrdering(MetaFrame::VarIter& i,
     Int nSlack;
     switch(*j) {
     case MetaDomain::LEFTOF:
-      nSlack = pCurrent->m_vXMatrix[r1->m_nID][r2->m_nID] -
+      nSlack = m_XMatrix[r1->m_nID][r2->m_nID] -
 	r1->m_nWidth;
       break;
     case MetaDomain::RIGHTOF:
-      nSlack = pCurrent->m_vXMatrix[r2->m_nID][r1->m_nID] -
+      nSlack = m_XMatrix[r2->m_nID][r1->m_nID] -
 	r2->m_nWidth;
       break;
     case MetaDomain::BELOW:
-      nSlack = pCurrent->m_vYMatrix[r1->m_nID][r2->m_nID] -
+      nSlack = m_YMatrix[r1->m_nID][r2->m_nID] -
 	r1->m_nHeight;
       break;
     case MetaDomain::ABOVE:
-      nSlack = pCurrent->m_vYMatrix[r2->m_nID][r1->m_nID] -
+      nSlack = m_YMatrix[r2->m_nID][r1->m_nID] -
 	r2->m_nHeight;
       break;
     default:
@@ -600,7 +602,7 @@ void MetaCSP::get2(Placements& v) const {
     for(std::vector<MetaVarDesc>::const_iterator j = i->begin();
 	j != i->end(); ++j) {
       const MetaVarDesc* pDesc = &(*j);
-      Int nWidth = pCurrent->m_vXMatrix.minWidth(pDesc);
+      Int nWidth = m_XMatrix.minWidth(pDesc);
       if(nWidth == (Int) pCurrent->m_nMinWidth) {
 	const MetaVariable* pVar(NULL);
 	MetaFrame::ConstVarIter k = pCurrent->m_Assigned.find(pDesc);
@@ -636,7 +638,7 @@ void MetaCSP::get2(Placements& v) const {
     q.pop_back();
     for(size_t j = 0; j < i; ++j) {
       if(vAssigned[j]) continue;
-      Int nWidth = pCurrent->m_vXMatrix.minWidth(&m_vVariableDescs[i][j]);
+      Int nWidth = m_XMatrix.minWidth(&m_vVariableDescs[i][j]);
       if(nWidth > 0)
 	vX[j] = (UInt) nWidth - m_vRectPtrs[j]->m_nWidth;
       vAssigned[j] = true;
@@ -655,7 +657,7 @@ void MetaCSP::get2(Placements& v) const {
     for(std::vector<MetaVarDesc>::const_iterator j = i->begin();
 	j != i->end(); ++j) {
       const MetaVarDesc* pDesc = &(*j);
-      Int nHeight = pCurrent->m_vYMatrix.minHeight(pDesc);
+      Int nHeight = m_YMatrix.minHeight(pDesc);
       if(nHeight == (Int) pCurrent->m_nMinHeight) {
 	const MetaVariable* pVar(NULL);
 	MetaFrame::ConstVarIter k = pCurrent->m_Assigned.find(pDesc);
@@ -691,7 +693,7 @@ void MetaCSP::get2(Placements& v) const {
     q.pop_back();
     for(size_t j = 0; j < i; ++j) {
       if(vAssigned[j]) continue;
-      Int nHeight = pCurrent->m_vYMatrix.minHeight(&m_vVariableDescs[i][j]);
+      Int nHeight = m_YMatrix.minHeight(&m_vVariableDescs[i][j]);
       if(nHeight > 0)
 	vY[j] = (UInt) nHeight - m_vRectPtrs[j]->m_nHeight;
       vAssigned[j] = true;
@@ -721,7 +723,6 @@ void MetaCSP::get(Placements& v) const {
    * box. They immediately get assigned x=0.
    */
 
-  const MetaFrame* pCurrent = &m_vStack.back();
   std::vector<bool> vAssigned(m_vRects.size(), false);
   std::vector<Int> vX(m_vRects.size(), 0);
   std::deque<size_t> q;
@@ -732,7 +733,7 @@ void MetaCSP::get(Placements& v) const {
       const MetaVarDesc* pDesc = &(*j);
       vX[pDesc->m_pRect1->m_nID] =
 	std::min(vX[pDesc->m_pRect1->m_nID],
-		 pCurrent->m_vXMatrix
+		 m_XMatrix
 		 [pDesc->m_pRect1->m_nID]
 		 [pDesc->m_pRect2->m_nID]);
     }
@@ -752,7 +753,7 @@ void MetaCSP::get(Placements& v) const {
       const MetaVarDesc* pDesc = &(*j);
       vY[pDesc->m_pRect1->m_nID] =
 	std::min(vY[pDesc->m_pRect1->m_nID],
-		 pCurrent->m_vYMatrix
+		 m_YMatrix
 		 [pDesc->m_pRect1->m_nID]
 		 [pDesc->m_pRect2->m_nID]);
     }
@@ -141,8 +141,8 @@ class MetaCSP : public Packer {
    */
 
   void valueOrdering(MetaFrame::VarIter& i, std::vector<int>& v) const;
-  bool computeAPSP();
-  void semanticBranching(MetaFrame::VarIter& v, int n);
+  bool computeAPSP(const MetaVarDesc* pDesc, int n);
+  void semanticBranching(const MetaVarDesc* pDesc, int n);
 
   /**
    * Performs clique detection to derive a minimum width.
@@ -184,6 +184,8 @@ class MetaCSP : public Packer {
   bool updateSolution();
 
   std::vector<MetaFrame> m_vStack;
+  APSP m_XMatrix;
+  APSP m_YMatrix;
 
   /**
    * The current global set of variable descriptions. This is
@@ -27,8 +27,9 @@ MetaFrame::MetaFrame() {
 MetaFrame::MetaFrame(const MetaFrame& src) :
   m_Assigned(src.m_Assigned),
   m_Unassigned(src.m_Unassigned),
-  m_vXMatrix(src.m_vXMatrix),
-  m_vYMatrix(src.m_vYMatrix),
+  m_pXMatrix(src.m_pXMatrix),
+  m_pYMatrix(src.m_pYMatrix),
+  m_bNegativeCycle(src.m_bNegativeCycle),
   m_nMinWidth(0),
   m_nMinHeight(0),
   m_nMaxWidth(std::numeric_limits<UInt>::max()),
@@ -38,9 +39,13 @@ MetaFrame::MetaFrame(const MetaFrame& src) :
 MetaFrame::~MetaFrame() {
 }
 
-void MetaFrame::initialize(const std::vector<std::vector<MetaVarDesc> >& vVars) {
-  m_vXMatrix.initialize(vVars.size());
-  m_vYMatrix.initialize(vVars.size());
+void MetaFrame::initialize(const std::vector<std::vector<MetaVarDesc> >& vVars,
+			   APSP* pXMatrix, APSP* pYMatrix) {
+  m_pXMatrix = pXMatrix;
+  m_pYMatrix = pYMatrix;
+  m_pXMatrix->initialize(vVars.size());
+  m_pYMatrix->initialize(vVars.size());
+  m_bNegativeCycle = false;
   for(size_t i = 0; i < vVars.size(); ++i)
     for(size_t j = 0; j < i; ++j)
       m_Unassigned[&vVars[i][j]].initialize(&vVars[i][j]);
@@ -59,13 +64,13 @@ bool MetaFrame::forwardChecking() {
 	m_Unassigned.begin(); i != m_Unassigned.end(); ++i) {
     const Rectangle* r1(i->first->m_pRect1);
     const Rectangle* r2(i->first->m_pRect2);
-    if(m_vXMatrix[r1->m_nID][r2->m_nID] < (Int) r1->m_nWidth)
+    if((*m_pXMatrix)[r1->m_nID][r2->m_nID] < (Int) r1->m_nWidth)
       i->second.m_Domain.erase(MetaDomain::LEFTOF);
-    if(m_vYMatrix[r1->m_nID][r2->m_nID] < (Int) r1->m_nHeight)
+    if((*m_pYMatrix)[r1->m_nID][r2->m_nID] < (Int) r1->m_nHeight)
       i->second.m_Domain.erase(MetaDomain::BELOW);
-    if(m_vXMatrix[r2->m_nID][r1->m_nID] < (Int) r2->m_nWidth)
+    if((*m_pXMatrix)[r2->m_nID][r1->m_nID] < (Int) r2->m_nWidth)
       i->second.m_Domain.erase(MetaDomain::RIGHTOF);
-    if(m_vYMatrix[r2->m_nID][r1->m_nID] < (Int) r2->m_nHeight)
+    if((*m_pYMatrix)[r2->m_nID][r1->m_nID] < (Int) r2->m_nHeight)
       i->second.m_Domain.erase(MetaDomain::ABOVE);
     if(i->second.m_Domain.empty())
       return(false);
@@ -92,25 +97,25 @@ bool MetaFrame::forwardCheckBounds(const Solution& s) {
     case MetaDomain::LEFTOF:
       b.m_nWidth =
 	std::max(b.m_nWidth,
-		 (UInt) (- m_vXMatrix[r1->m_nID][r2->m_nID] +
+		 (UInt) (- (*m_pXMatrix)[r1->m_nID][r2->m_nID] +
 			 r2->m_nWidth));
       break;
     case MetaDomain::RIGHTOF:
       b.m_nWidth =
 	std::max(b.m_nWidth,
-		 (UInt) (- m_vXMatrix[r2->m_nID][r1->m_nID] +
+		 (UInt) (- (*m_pXMatrix)[r2->m_nID][r1->m_nID] +
 			 r1->m_nWidth));
       break;
     case MetaDomain::BELOW:
       b.m_nHeight =
 	std::max(b.m_nHeight,
-		 (UInt) (- m_vYMatrix[r1->m_nID][r2->m_nID] +
+		 (UInt) (- (*m_pYMatrix)[r1->m_nID][r2->m_nID] +
 			 r2->m_nHeight));
       break;
     case MetaDomain::ABOVE:
       b.m_nHeight =
 	std::max(b.m_nHeight,
-		 (UInt) (- m_vYMatrix[r2->m_nID][r1->m_nID] +
+		 (UInt) (- (*m_pYMatrix)[r2->m_nID][r1->m_nID] +
 			 r1->m_nHeight));
       break;
     default:
@@ -175,7 +180,7 @@ void MetaFrame::subsumeVariables() {
     
     const Rectangle* r1(i->first->m_pRect1);
     const Rectangle* r2(i->first->m_pRect2);
-    if(m_vXMatrix[r2->m_nID][r1->m_nID] <= (Int) r1->m_nWidth) {
+    if((*m_pXMatrix)[r2->m_nID][r1->m_nID] <= (Int) r1->m_nWidth) {
       lErase.push_back(i);
       i->second.assign(MetaDomain::LEFTOF);
       continue;
@@ -185,7 +190,7 @@ void MetaFrame::subsumeVariables() {
      * Is the RIGHTOF relation implied?
      */
 
-    if(m_vXMatrix[r1->m_nID][r2->m_nID] <= - (Int) r2->m_nWidth) {
+    if((*m_pXMatrix)[r1->m_nID][r2->m_nID] <= - (Int) r2->m_nWidth) {
       lErase.push_back(i);
       i->second.assign(MetaDomain::RIGHTOF);
       continue;
@@ -195,7 +200,7 @@ void MetaFrame::subsumeVariables() {
      * Is the BELOW relation implied?
      */
 
-    if(m_vYMatrix[r2->m_nID][r1->m_nID] <= - (Int) r1->m_nHeight) {
+    if((*m_pYMatrix)[r2->m_nID][r1->m_nID] <= - (Int) r1->m_nHeight) {
       lErase.push_back(i);
       i->second.assign(MetaDomain::BELOW);
       continue;
@@ -205,7 +210,7 @@ void MetaFrame::subsumeVariables() {
      * Is the ABOVE relation implied?
      */
 
-    if(m_vXMatrix[r1->m_nID][r2->m_nID] <= - (Int) r2->m_nHeight) {
+    if((*m_pXMatrix)[r1->m_nID][r2->m_nID] <= - (Int) r2->m_nHeight) {
       lErase.push_back(i);
       i->second.assign(MetaDomain::ABOVE);
       continue;
@@ -239,9 +244,9 @@ void MetaFrame::print() const {
     std::cout << "    " << i->second << std::endl;
   std::cout << std::endl << std::endl
 	    << "Horizontal APSP matrix:" << std::endl
-	    << m_vXMatrix << std::endl
+	    << *m_pXMatrix << std::endl
 	    << "Vertical APSP matrix:" << std::endl
-	    << m_vYMatrix << std::endl
+	    << *m_pYMatrix << std::endl
 	    << "Min=" << m_nMinWidth << 'x' << m_nMinHeight << ", "
 	    << "Max=" << m_nMaxWidth << 'x' << m_nMaxHeight
 	    << std::endl;
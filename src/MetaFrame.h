@@ -38,7 +38,8 @@ class MetaFrame {
   MetaFrame();
   MetaFrame(const MetaFrame& src);
   virtual ~MetaFrame();
-  void initialize(const std::vector<std::vector<MetaVarDesc> >& vVars);
+  void initialize(const std::vector<std::vector<MetaVarDesc> >& vVars,
+		  APSP* pXMatrix, APSP* pYMatrix);
 
   /**
    * Makes the requested assignment, moving the appropriate meta
@@ -104,8 +105,22 @@ class MetaFrame {
    */
 
   std::map<const MetaVarDesc*, MetaVariable> m_Unassigned;
-  APSP m_vXMatrix;
-  APSP m_vYMatrix;
+
+  /**
+   * The APSP matrices are shared by all frames on the stack and are
+   * restored through their trails when a frame is popped.
+   */
+
+  APSP* m_pXMatrix;
+  APSP* m_pYMatrix;
+
+  /**
+   * Set when a negated disjunct could not be asserted into the APSP
+   * matrices because of a negative cycle, so that no assignment below
+   * this frame can succeed.
+   */
+
+  bool m_bNegativeCycle;
 
   UInt m_nMinWidth;
   UInt m_nMinHeight;
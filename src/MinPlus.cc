@@ -0,0 +1,216 @@
+/**
+ * Copyright (C) 2011 Eric Huang
+ *
+ * This file is part of rectpack.
+ *
+ * rectpack is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * rectpack is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with rectpack. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MinPlus.h"
+#include <immintrin.h>
+
+/**
+ * Scalar implementations.
+ */
+
+static bool relaxScalar(Int* p, const Int* q, size_t n, Int a) {
+  const Int nInf = MinPlus::infinity();
+  bool bChanged(false);
+  for(size_t i = 0; i < n; ++i)
+    if(q[i] != nInf && a + q[i] < p[i]) {
+      p[i] = a + q[i];
+      bChanged = true;
+    }
+  return(bChanged);
+}
+
+static bool relaxUScalar(UInt* p, const UInt* q, size_t n, UInt a) {
+  bool bChanged(false);
+  for(size_t i = 0; i < n; ++i)
+    if(a + q[i] < p[i]) {
+      p[i] = a + q[i];
+      bChanged = true;
+    }
+  return(bChanged);
+}
+
+static bool improvesScalar(const Int* p, const Int* q, size_t n, Int a) {
+  const Int nInf = MinPlus::infinity();
+  for(size_t i = 0; i < n; ++i)
+    if(q[i] != nInf && a + q[i] < p[i])
+      return(true);
+  return(false);
+}
+
+/**
+ * SSE4.2 implementations, two 64-bit lanes at a time. The unsigned
+ * comparison flips the sign bits and compares as signed.
+ */
+
+__attribute__((target("sse4.2")))
+static bool relaxSSE(Int* p, const Int* q, size_t n, Int a) {
+  const __m128i vA = _mm_set1_epi64x(a);
+  const __m128i vInf = _mm_set1_epi64x(MinPlus::infinity());
+  __m128i vChanged = _mm_setzero_si128();
+  size_t i = 0;
+  for(; i + 2 <= n; i += 2) {
+    __m128i vQ = _mm_loadu_si128((const __m128i*) (q + i));
+    __m128i vSum = _mm_blendv_epi8(_mm_add_epi64(vA, vQ), vInf,
+				   _mm_cmpeq_epi64(vQ, vInf));
+    __m128i vP = _mm_loadu_si128((const __m128i*) (p + i));
+    __m128i vLess = _mm_cmpgt_epi64(vP, vSum);
+    _mm_storeu_si128((__m128i*) (p + i), _mm_blendv_epi8(vP, vSum, vLess));
+    vChanged = _mm_or_si128(vChanged, vLess);
+  }
+  bool bChanged = !_mm_testz_si128(vChanged, vChanged);
+  return(relaxScalar(p + i, q + i, n - i, a) || bChanged);
+}
+
+__attribute__((target("sse4.2")))
+static bool relaxUSSE(UInt* p, const UInt* q, size_t n, UInt a) {
+  const __m128i vA = _mm_set1_epi64x(a);
+  const __m128i vSign = _mm_set1_epi64x(std::numeric_limits<Int>::min());
+  __m128i vChanged = _mm_setzero_si128();
+  size_t i = 0;
+  for(; i + 2 <= n; i += 2) {
+    __m128i vQ = _mm_loadu_si128((const __m128i*) (q + i));
+    __m128i vSum = _mm_add_epi64(vA, vQ);
+    __m128i vP = _mm_loadu_si128((const __m128i*) (p + i));
+    __m128i vLess = _mm_cmpgt_epi64(_mm_xor_si128(vP, vSign),
+				    _mm_xor_si128(vSum, vSign));
+    _mm_storeu_si128((__m128i*) (p + i), _mm_blendv_epi8(vP, vSum, vLess));
+    vChanged = _mm_or_si128(vChanged, vLess);
+  }
+  bool bChanged = !_mm_testz_si128(vChanged, vChanged);
+  return(relaxUScalar(p + i, q + i, n - i, a) || bChanged);
+}
+
+__attribute__((target("sse4.2")))
+static bool improvesSSE(const Int* p, const Int* q, size_t n, Int a) {
+  const __m128i vA = _mm_set1_epi64x(a);
+  const __m128i vInf = _mm_set1_epi64x(MinPlus::infinity());
+  size_t i = 0;
+  for(; i + 2 <= n; i += 2) {
+    __m128i vQ = _mm_loadu_si128((const __m128i*) (q + i));
+    __m128i vSum = _mm_blendv_epi8(_mm_add_epi64(vA, vQ), vInf,
+				   _mm_cmpeq_epi64(vQ, vInf));
+    __m128i vP = _mm_loadu_si128((const __m128i*) (p + i));
+    if(!_mm_testz_si128(_mm_cmpgt_epi64(vP, vSum), _mm_set1_epi64x(-1)))
+      return(true);
+  }
+  return(improvesScalar(p + i, q + i, n - i, a));
+}
+
+/**
+ * AVX2 implementations, four 64-bit lanes at a time.
+ */
+
+__attribute__((target("avx2")))
+static bool relaxAVX2(Int* p, const Int* q, size_t n, Int a) {
+  const __m256i vA = _mm256_set1_epi64x(a);
+  const __m256i vInf = _mm256_set1_epi64x(MinPlus::infinity());
+  __m256i vChanged = _mm256_setzero_si256();
+  size_t i = 0;
+  for(; i + 4 <= n; i += 4) {
+    __m256i vQ = _mm256_loadu_si256((const __m256i*) (q + i));
+    __m256i vSum = _mm256_blendv_epi8(_mm256_add_epi64(vA, vQ), vInf,
+				      _mm256_cmpeq_epi64(vQ, vInf));
+    __m256i vP = _mm256_loadu_si256((const __m256i*) (p + i));
+    __m256i vLess = _mm256_cmpgt_epi64(vP, vSum);
+    _mm256_storeu_si256((__m256i*) (p + i),
+			_mm256_blendv_epi8(vP, vSum, vLess));
+    vChanged = _mm256_or_si256(vChanged, vLess);
+  }
+  bool bChanged = !_mm256_testz_si256(vChanged, vChanged);
+  return(relaxSSE(p + i, q + i, n - i, a) || bChanged);
+}
+
+__attribute__((target("avx2")))
+static bool relaxUAVX2(UInt* p, const UInt* q, size_t n, UInt a) {
+  const __m256i vA = _mm256_set1_epi64x(a);
+  const __m256i vSign =
+    _mm256_set1_epi64x(std::numeric_limits<Int>::min());
+  __m256i vChanged = _mm256_setzero_si256();
+  size_t i = 0;
+  for(; i + 4 <= n; i += 4) {
+    __m256i vQ = _mm256_loadu_si256((const __m256i*) (q + i));
+    __m256i vSum = _mm256_add_epi64(vA, vQ);
+    __m256i vP = _mm256_loadu_si256((const __m256i*) (p + i));
+    __m256i vLess = _mm256_cmpgt_epi64(_mm256_xor_si256(vP, vSign),
+				       _mm256_xor_si256(vSum, vSign));
+    _mm256_storeu_si256((__m256i*) (p + i),
+			_mm256_blendv_epi8(vP, vSum, vLess));
+    vChanged = _mm256_or_si256(vChanged, vLess);
+  }
+  bool bChanged = !_mm256_testz_si256(vChanged, vChanged);
+  return(relaxUSSE(p + i, q + i, n - i, a) || bChanged);
+}
+
+__attribute__((target("avx2")))
+static bool improvesAVX2(const Int* p, const Int* q, size_t n, Int a) {
+  const __m256i vA = _mm256_set1_epi64x(a);
+  const __m256i vInf = _mm256_set1_epi64x(MinPlus::infinity());
+  size_t i = 0;
+  for(; i + 4 <= n; i += 4) {
+    __m256i vQ = _mm256_loadu_si256((const __m256i*) (q + i));
+    __m256i vSum = _mm256_blendv_epi8(_mm256_add_epi64(vA, vQ), vInf,
+				      _mm256_cmpeq_epi64(vQ, vInf));
+    __m256i vP = _mm256_loadu_si256((const __m256i*) (p + i));
+    __m256i vLess = _mm256_cmpgt_epi64(vP, vSum);
+    if(!_mm256_testz_si256(vLess, vLess))
+      return(true);
+  }
+  return(improvesSSE(p + i, q + i, n - i, a));
+}
+
+bool (*MinPlus::m_pRelax)(Int*, const Int*, size_t, Int) = relaxScalar;
+bool (*MinPlus::m_pRelaxU)(UInt*, const UInt*, size_t, UInt) = relaxUScalar;
+bool (*MinPlus::m_pImproves)(const Int*, const Int*, size_t, Int) =
+  improvesScalar;
+const char* MinPlus::m_pName = "scalar";
+
+/**
+ * Makes sure that we start out with the fastest kernels even if
+ * select() is never called.
+ */
+
+static struct MinPlusInit {
+  MinPlusInit() { MinPlus::select(true); }
+} initMinPlus;
+
+void MinPlus::select(bool bVector) {
+  __builtin_cpu_init();
+  if(bVector && sizeof(Int) == 8 && __builtin_cpu_supports("avx2")) {
+    m_pRelax = relaxAVX2;
+    m_pRelaxU = relaxUAVX2;
+    m_pImproves = improvesAVX2;
+    m_pName = "avx2";
+  }
+  else if(bVector && sizeof(Int) == 8 && __builtin_cpu_supports("sse4.2")) {
+    m_pRelax = relaxSSE;
+    m_pRelaxU = relaxUSSE;
+    m_pImproves = improvesSSE;
+    m_pName = "sse4.2";
+  }
+  else {
+    m_pRelax = relaxScalar;
+    m_pRelaxU = relaxUScalar;
+    m_pImproves = improvesScalar;
+    m_pName = "scalar";
+  }
+}
+
+const char* MinPlus::name() {
+  return(m_pName);
+}
@@ -0,0 +1,95 @@
+/**
+ * Copyright (C) 2011 Eric Huang
+ *
+ * This file is part of rectpack.
+ *
+ * rectpack is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * rectpack is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with rectpack. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MINPLUS_H
+#define MINPLUS_H
+
+#include "Integer.h"
+#include <cstddef>
+#include <limits>
+
+/**
+ * Vectorized min-plus row kernels for the shortest path matrices (see
+ * DistanceMatrix). A relaxation updates a row p of n distances with
+ * p[j] = min(p[j], a + q[j]) for a pivot distance a and a pivot row
+ * q. As with BinsKernel, the implementation is picked at run time
+ * from AVX2, SSE4.2 and plain scalar code.
+ *
+ * The signed kernels treat the largest Int as infinity: an infinite
+ * q[j] yields an infinite sum, selected with a blend rather than a
+ * branch, so the sentinel never overflows and never decays into a
+ * finite distance. Callers skip rows whose pivot distance a is
+ * infinite. The unsigned kernels have no infinity and add with
+ * wrap-around, exactly like the scalar UInt arithmetic they replace.
+ */
+
+class MinPlus {
+ public:
+
+  /**
+   * Picks the fastest implementation available on this processor,
+   * or the scalar one if bVector is false.
+   */
+
+  static void select(bool bVector);
+  static const char* name();
+
+  static Int infinity() {
+    return(std::numeric_limits<Int>::max());
+  }
+
+  static bool infinite(const Int& n) {
+    return(n == infinity());
+  }
+
+  static bool infinite(const UInt&) {
+    return(false);
+  }
+
+  /**
+   * Relaxes the n values starting at p through the pivot.
+   *
+   * @return true if any value decreased.
+   */
+
+  static bool relax(Int* p, const Int* q, size_t n, Int a) {
+    return(m_pRelax(p, q, n, a));
+  }
+
+  static bool relax(UInt* p, const UInt* q, size_t n, UInt a) {
+    return(m_pRelaxU(p, q, n, a));
+  }
+
+  /**
+   * @return true if relax() would decrease any of the values, without
+   * writing to them.
+   */
+
+  static bool improves(const Int* p, const Int* q, size_t n, Int a) {
+    return(m_pImproves(p, q, n, a));
+  }
+
+ private:
+  static bool (*m_pRelax)(Int*, const Int*, size_t, Int);
+  static bool (*m_pRelaxU)(UInt*, const UInt*, size_t, UInt);
+  static bool (*m_pImproves)(const Int*, const Int*, size_t, Int);
+  static const char* m_pName;
+};
+
+#endif // MINPLUS_H
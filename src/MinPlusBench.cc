@@ -0,0 +1,81 @@
+/**
+ * Copyright (C) 2011 Eric Huang
+ *
+ * This file is part of rectpack.
+ *
+ * rectpack is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * rectpack is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with rectpack. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * Stand-alone benchmark for the min-plus kernels (see MinPlus and
+ * DistanceMatrix). This is not part of rectpack; "make apspbench"
+ * builds it and reports the time for one Floyd-Warshall pass over
+ * random sparse distance matrices of increasing size, with the scalar
+ * and the vector kernels, and checks that both produce the same
+ * matrix.
+ */
+
+#include "DistanceMatrix.h"
+#include "MinPlus.h"
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+
+static void randomize(DistanceMatrix<Int>& m, size_t n) {
+  m.initialize(n, MinPlus::infinity());
+  for(size_t i = 0; i < n; ++i)
+    for(size_t j = 0; j < n; ++j)
+      if(i == j)
+	m[i][j] = 0;
+      else if(rand() % 4 == 0)
+	m[i][j] = rand() % 1000;
+}
+
+static double run(const DistanceMatrix<Int>& src, DistanceMatrix<Int>& dst,
+		  size_t nReps) {
+  clock_t nStart = clock();
+  for(size_t r = 0; r < nReps; ++r) {
+    dst = src;
+    dst.floydWarshall();
+  }
+  return((double) (clock() - nStart) / CLOCKS_PER_SEC / nReps);
+}
+
+int main() {
+  srand(1);
+  std::cout << std::setw(6) << "n" << std::setw(14) << "scalar (s)"
+	    << std::setw(14) << "vector (s)" << std::setw(10) << "speedup"
+	    << "  kernel" << std::endl;
+  for(size_t n = 16; n <= 256; n *= 2) {
+    DistanceMatrix<Int> m, m1, m2;
+    randomize(m, n);
+    size_t nReps = (1 << 24) / (n * n * n) + 1;
+    MinPlus::select(false);
+    double d1 = run(m, m1, nReps);
+    MinPlus::select(true);
+    double d2 = run(m, m2, nReps);
+    for(size_t i = 0; i < n; ++i)
+      for(size_t j = 0; j < n; ++j)
+	if(m1[i][j] != m2[i][j]) {
+	  std::cout << "Mismatch at (" << i << ", " << j << ") for n = "
+		    << n << std::endl;
+	  return(1);
+	}
+    std::cout << std::setw(6) << n << std::setw(14) << d1
+	      << std::setw(14) << d2 << std::setw(10) << d1 / d2
+	      << "  " << MinPlus::name() << std::endl;
+  }
+  return(0);
+}
@@ -19,77 +19,256 @@
 
 #include "MpqWrapper.h"
 #include <iostream>
+#include <limits>
 
-MpqWrapper::MpqWrapper() {
+bool MpqWrapper::s_bFastPath = true;
+
+/**
+ * Greatest common divisor of two 128-bit magnitudes, dropping down
+ * to 64-bit division as soon as both operands fit. Keeping a >= b
+ * means that happens as soon as a fits.
+ */
+
+static unsigned __int128 gcd(unsigned __int128 a, unsigned __int128 b) {
+  if(a < b) {
+    unsigned __int128 t = a;
+    a = b;
+    b = t;
+  }
+  while((a >> 64) != 0) {
+    if(b == 0) return(a);
+    unsigned __int128 t = a % b;
+    a = b;
+    b = t;
+  }
+  unsigned long long x = (unsigned long long) a;
+  unsigned long long y = (unsigned long long) b;
+  while(y != 0) {
+    unsigned long long t = x % y;
+    x = y;
+    y = t;
+  }
+  return(x);
+}
+
+static mpz_class wide(__int128 n) {
+  unsigned __int128 m = (n < 0) ?
+    (unsigned __int128) 0 - (unsigned __int128) n : (unsigned __int128) n;
+  mpz_class z((unsigned long) (m >> 64));
+  z <<= 64;
+  z += (unsigned long) m;
+  if(n < 0)
+    z = -z;
+  return(z);
+}
+
+MpqWrapper::MpqWrapper() :
+  m_nNum(0),
+  m_nDen(1),
+  m_pBig(NULL) {
 }
 
 MpqWrapper::MpqWrapper(const mpq_class& rhs) :
-  mpq_class(rhs) {
+  m_nNum(0),
+  m_nDen(1),
+  m_pBig(NULL) {
+  setBig(rhs);
 }
 
 MpqWrapper::MpqWrapper(const MpqWrapper& rhs) :
-  mpq_class(rhs) {
+  m_nNum(rhs.m_nNum),
+  m_nDen(rhs.m_nDen),
+  m_pBig(rhs.m_pBig ? new mpq_class(*rhs.m_pBig) : NULL) {
 }
 
-MpqWrapper::MpqWrapper(const MpzWrapper& n) {
-  mpq_class::get_num() = n.get_mpz_class();
-  mpq_class::get_den() = 1;
+MpqWrapper::MpqWrapper(const MpzWrapper& n) :
+  m_nNum(0),
+  m_nDen(1),
+  m_pBig(NULL) {
+  setBig(mpq_class(n.get_mpz_class()));
 }
 
 MpqWrapper::MpqWrapper(int n) :
-  mpq_class(n, 1) {
+  m_nNum(0),
+  m_nDen(1),
+  m_pBig(NULL) {
+  set(n);
 }
 
 MpqWrapper::MpqWrapper(unsigned int n) :
-  mpq_class(n, 1) {
+  m_nNum(0),
+  m_nDen(1),
+  m_pBig(NULL) {
+  set(n);
 }
 
-MpqWrapper::MpqWrapper(const long long& n) {
-  std::ostringstream oss;
-  oss << n;
-  mpq_class::set_str(oss.str(), 10);
+MpqWrapper::MpqWrapper(const long long& n) :
+  m_nNum(0),
+  m_nDen(1),
+  m_pBig(NULL) {
+  set(n);
 }
 
-MpqWrapper::MpqWrapper(const unsigned long long& n) {
-  std::ostringstream oss;
-  oss << n;
-  mpq_class::set_str(oss.str(), 10);
+MpqWrapper::MpqWrapper(const unsigned long long& n) :
+  m_nNum(0),
+  m_nDen(1),
+  m_pBig(NULL) {
+  set(n);
 }
 
-MpqWrapper::MpqWrapper(int p, int q) {
-  std::ostringstream oss;
-  oss << p << '/' << q;
-  mpq_class::set_str(oss.str(), 10);
-  mpq_class::canonicalize();
+MpqWrapper::MpqWrapper(int p, int q) :
+  m_nNum(0),
+  m_nDen(1),
+  m_pBig(NULL) {
+  setWide(p, q);
 }
 
-MpqWrapper::MpqWrapper(unsigned int p, unsigned int q) {
-  std::ostringstream oss;
-  oss << p << '/' << q;
-  mpq_class::set_str(oss.str(), 10);
-  mpq_class::canonicalize();
+MpqWrapper::MpqWrapper(unsigned int p, unsigned int q) :
+  m_nNum(0),
+  m_nDen(1),
+  m_pBig(NULL) {
+  setWide(p, q);
 }
 
-MpqWrapper::MpqWrapper(const long long& p, const long long& q) {
-  std::ostringstream oss;
-  oss << p << '/' << q;
-  mpq_class::set_str(oss.str(), 10);
-  mpq_class::canonicalize();
+MpqWrapper::MpqWrapper(const long long& p, const long long& q) :
+  m_nNum(0),
+  m_nDen(1),
+  m_pBig(NULL) {
+  setWide(p, q);
 }
 
 MpqWrapper::MpqWrapper(const unsigned long long& p,
-		       const unsigned long long& q) {
-  std::ostringstream oss;
-  oss << p << '/' << q;
-  mpq_class::set_str(oss.str(), 10);
-  mpq_class::canonicalize();
+		       const unsigned long long& q) :
+  m_nNum(0),
+  m_nDen(1),
+  m_pBig(NULL) {
+  setWide(p, q);
 }
 
 MpqWrapper::MpqWrapper(float f) :
-  mpq_class(f) {
+  m_nNum(0),
+  m_nDen(1),
+  m_pBig(NULL) {
+  setBig(mpq_class(f));
 }
 
 MpqWrapper::~MpqWrapper() {
+  delete m_pBig;
+}
+
+void MpqWrapper::setFastPath(bool bFastPath) {
+  s_bFastPath = bFastPath;
+}
+
+void MpqWrapper::set(int n) {
+  setSmall(n, 1);
+}
+
+void MpqWrapper::set(unsigned int n) {
+  setSmall(n, 1);
+}
+
+void MpqWrapper::set(long n) {
+  setSmall(n, 1);
+}
+
+void MpqWrapper::set(unsigned long n) {
+  set((unsigned long long) n);
+}
+
+void MpqWrapper::set(long long n) {
+  setSmall(n, 1);
+}
+
+void MpqWrapper::set(unsigned long long n) {
+  if(n <= (unsigned long long) std::numeric_limits<long long>::max())
+    setSmall((long long) n, 1);
+  else
+    setBig(mpq_class(mpz_class((unsigned long) n)));
+}
+
+void MpqWrapper::set(const MpqWrapper& n) {
+  operator=(n);
+}
+
+void MpqWrapper::setSmall(long long p, long long q) {
+
+  /**
+   * The most negative value is kept out of the inline
+   * representation so that negating a numerator never overflows.
+   */
+
+  if(s_bFastPath && p != std::numeric_limits<long long>::min()) {
+    delete m_pBig;
+    m_pBig = NULL;
+    m_nNum = p;
+    m_nDen = q;
+  }
+  else
+    setWide(p, q);
+}
+
+void MpqWrapper::setWide(__int128 p, __int128 q) {
+  if(q == 0) {
+
+    /**
+     * Leave division by zero to GMP, as before.
+     */
+
+    mpq_class r(wide(p), wide(q));
+    r.canonicalize();
+    setBig(r);
+    return;
+  }
+  if(q < 0) {
+    p = -p;
+    q = -q;
+  }
+  unsigned __int128 g =
+    gcd((p < 0) ? (unsigned __int128) 0 - (unsigned __int128) p :
+	(unsigned __int128) p, (unsigned __int128) q);
+  p /= (__int128) g;
+  q /= (__int128) g;
+  if(s_bFastPath &&
+     p > (__int128) std::numeric_limits<long long>::min() &&
+     p <= (__int128) std::numeric_limits<long long>::max() &&
+     q <= (__int128) std::numeric_limits<long long>::max()) {
+    delete m_pBig;
+    m_pBig = NULL;
+    m_nNum = (long long) p;
+    m_nDen = (long long) q;
+  }
+  else {
+    mpq_class r(wide(p), wide(q));
+    r.canonicalize();
+    setBig(r);
+  }
+}
+
+void MpqWrapper::setBig(const mpq_class& q) {
+  if(s_bFastPath &&
+     q.get_num().fits_slong_p() && q.get_den().fits_slong_p() &&
+     q.get_num() != std::numeric_limits<long>::min()) {
+    long long nNum = q.get_num().get_si();
+    long long nDen = q.get_den().get_si();
+    delete m_pBig;
+    m_pBig = NULL;
+    m_nNum = nNum;
+    m_nDen = nDen;
+  }
+  else if(m_pBig)
+    *m_pBig = q;
+  else
+    m_pBig = new mpq_class(q);
+}
+
+mpq_class MpqWrapper::big() const {
+  if(m_pBig)
+    return(*m_pBig);
+  mpq_class q;
+  q.get_num() = (long) m_nNum;
+  q.get_den() = (long) m_nDen;
+  return(q);
 }
 
 void MpqWrapper::print() const {
@@ -102,8 +281,9 @@ void MpqWrapper::print() const {
 void MpqWrapper::initialize(const std::string& s) {
   size_t n = s.find_first_of('.');
   if(n >= s.size()) {
-    mpq_class::set_str(s, 10);
-    canonicalize();
+    mpq_class q(s, 10);
+    q.canonicalize();
+    setBig(q);
   }
   else {
     std::string sWhole(s.substr(0, n));
@@ -111,8 +291,9 @@ void MpqWrapper::initialize(const std::string& s) {
     std::ostringstream oss;
     oss << sDecimal << "/1";
     for(size_t i = 0; i < sDecimal.size(); ++i) oss << '0';
-    mpq_class::set_str(oss.str(), 10);
-    canonicalize();
+    mpq_class q(oss.str(), 10);
+    q.canonicalize();
+    setBig(q);
     MpqWrapper nWhole;
     nWhole.initialize(sWhole);
     operator+=(nWhole);
@@ -120,19 +301,27 @@ void MpqWrapper::initialize(const std::string& s) {
 }
 
 void MpqWrapper::clear() {
-  mpq_class::set_str("0", 10);
+  setSmall(0, 1);
 }
 
 std::ostream& operator<<(std::ostream& os, const MpqWrapper& mpq) {
-  if(mpq.get_den() == 1)
-    return(os << mpq.get_str());
+  if(mpq.m_pBig) {
+    if(mpq.m_pBig->get_den() == 1)
+      return(os << mpq.get_str());
+    else
+      return(os << mpq.m_pBig->get_num().get_str() << '/'
+	     << mpq.m_pBig->get_den().get_str());
+  }
+  if(mpq.m_nDen == 1)
+    return(os << mpq.m_nNum);
   else
-    return(os << mpq.mpq_class::get_num().get_str() << '/'
-	   << mpq.mpq_class::get_den().get_str());
+    return(os << mpq.m_nNum << '/' << mpq.m_nDen);
 }
 
 bool MpqWrapper::integer() const {
-  return(mpq_class::get_den() == 1);
+  if(m_pBig)
+    return(m_pBig->get_den() == 1);
+  return(m_nDen == 1);
 }
 
 UInt MpqWrapper::get_ui() const {
@@ -140,31 +329,59 @@ UInt MpqWrapper::get_ui() const {
 }
 
 float MpqWrapper::get_f() const {
-  return((float) mpq_class::get_d());
+  return((float) big().get_d());
 }
 
 double MpqWrapper::get_d() const {
-  return((float) mpq_class::get_d());
+  return((float) big().get_d());
 }
 
 UInt MpqWrapper::get_num() const {
-  return((UInt) mpq_class::get_num().get_ui());
+  if(m_pBig)
+    return((UInt) m_pBig->get_num().get_ui());
+
+  /**
+   * Like mpz_get_ui, this returns the magnitude.
+   */
+
+  if(m_nNum < 0)
+    return((UInt) 0 - (UInt) m_nNum);
+  return((UInt) m_nNum);
 }
 
 UInt MpqWrapper::get_den() const {
-  return((UInt) mpq_class::get_den().get_ui());
+  if(m_pBig)
+    return((UInt) m_pBig->get_den().get_ui());
+  return((UInt) m_nDen);
 }
 
 MpzWrapper MpqWrapper::get_num_mpz() const {
-  return(MpzWrapper(mpq_class::get_num()));
+  if(m_pBig)
+    return(MpzWrapper(m_pBig->get_num()));
+  return(MpzWrapper(mpz_class((long) m_nNum)));
 }
 
 MpzWrapper MpqWrapper::get_den_mpz() const {
-  return(MpzWrapper(mpq_class::get_den()));
+  if(m_pBig)
+    return(MpzWrapper(m_pBig->get_den()));
+  return(MpzWrapper(mpz_class((long) m_nDen)));
 }
 
 MpqWrapper& MpqWrapper::operator=(const MpqWrapper& n) {
-  mpq_class::operator=(n);
+  if(this == &n)
+    return(*this);
+  if(n.m_pBig) {
+    if(m_pBig)
+      *m_pBig = *n.m_pBig;
+    else
+      m_pBig = new mpq_class(*n.m_pBig);
+  }
+  else {
+    delete m_pBig;
+    m_pBig = NULL;
+    m_nNum = n.m_nNum;
+    m_nDen = n.m_nDen;
+  }
   return(*this);
 }
 
@@ -189,47 +406,94 @@ MpqWrapper MpqWrapper::operator*(const MpqWrapper& n) const {
 }
 
 MpqWrapper& MpqWrapper::operator+=(const MpqWrapper& n) {
-  mpq_class::operator+=((mpq_class) n);
+  if(m_pBig || n.m_pBig)
+    setBig(big() + n.big());
+  else if(m_nDen == 1 && n.m_nDen == 1) {
+    long long nSum;
+    if(__builtin_add_overflow(m_nNum, n.m_nNum, &nSum))
+      setWide((__int128) m_nNum + n.m_nNum, 1);
+    else
+      setSmall(nSum, 1);
+  }
+  else
+    setWide((__int128) m_nNum * n.m_nDen + (__int128) n.m_nNum * m_nDen,
+	    (__int128) m_nDen * n.m_nDen);
   return(*this);
 }
 
 MpqWrapper& MpqWrapper::operator-=(const MpqWrapper& n) {
-  mpq_class::operator-=((mpq_class) n);
+  if(m_pBig || n.m_pBig)
+    setBig(big() - n.big());
+  else if(m_nDen == 1 && n.m_nDen == 1) {
+    long long nDiff;
+    if(__builtin_sub_overflow(m_nNum, n.m_nNum, &nDiff))
+      setWide((__int128) m_nNum - n.m_nNum, 1);
+    else
+      setSmall(nDiff, 1);
+  }
+  else
+    setWide((__int128) m_nNum * n.m_nDen - (__int128) n.m_nNum * m_nDen,
+	    (__int128) m_nDen * n.m_nDen);
   return(*this);
 }
 
 MpqWrapper& MpqWrapper::operator/=(const MpqWrapper& n) {
-  mpq_class::operator/=((mpq_class) n);
+  if(m_pBig || n.m_pBig || n.m_nNum == 0)
+    setBig(big() / n.big());
+  else
+    setWide((__int128) m_nNum * n.m_nDen, (__int128) m_nDen * n.m_nNum);
   return(*this);
 }
 
 MpqWrapper& MpqWrapper::operator*=(const MpqWrapper& n) {
-  mpq_class::operator*=((mpq_class) n);
+  if(m_pBig || n.m_pBig)
+    setBig(big() * n.big());
+  else if(m_nDen == 1 && n.m_nDen == 1) {
+    long long nProduct;
+    if(__builtin_mul_overflow(m_nNum, n.m_nNum, &nProduct))
+      setWide((__int128) m_nNum * n.m_nNum, 1);
+    else
+      setSmall(nProduct, 1);
+  }
+  else
+    setWide((__int128) m_nNum * n.m_nNum, (__int128) m_nDen * n.m_nDen);
   return(*this);
 }
 
+int MpqWrapper::compare(const MpqWrapper& n) const {
+  if(m_pBig || n.m_pBig)
+    return(cmp(big(), n.big()));
+  if(m_nDen == n.m_nDen)
+    return((m_nNum > n.m_nNum) - (m_nNum < n.m_nNum));
+  __int128 a = (__int128) m_nNum * n.m_nDen;
+  __int128 b = (__int128) n.m_nNum * m_nDen;
+  return((a > b) - (a < b));
+}
+
 bool MpqWrapper::operator!=(const MpqWrapper& n) const {
-  return((mpq_class) (*this) != (mpq_class) n);
+  return(!operator==(n));
 }
 
 bool MpqWrapper::operator==(const MpqWrapper& n) const {
-  return((mpq_class) (*this) == (mpq_class) n);
+  if(m_pBig || n.m_pBig)
+    return(compare(n) == 0);
+  return(m_nNum == n.m_nNum && m_nDen == n.m_nDen);
 }
 
 bool MpqWrapper::operator>(const MpqWrapper& n) const {
-  return((mpq_class) (*this) > (mpq_class) n);
+  return(compare(n) > 0);
 }
 
 bool MpqWrapper::operator>=(const MpqWrapper& n) const {
-  return((mpq_class) (*this) >= (mpq_class) n);
+  return(compare(n) >= 0);
 }
 
 bool MpqWrapper::operator<(const MpqWrapper& n) const {
-  return((mpq_class) (*this) < (mpq_class) n);
+  return(compare(n) < 0);
 }
 
 bool MpqWrapper::operator<=(const MpqWrapper& n) const {
-  return((mpq_class) (*this) <= (mpq_class) n);
+  return(compare(n) <= 0);
 }
 
 UInt MpqWrapper::roundUp() const {
@@ -238,20 +502,30 @@ UInt MpqWrapper::roundUp() const {
 }
 
 std::string MpqWrapper::get_str() const {
-  return(mpq_class::get_str());
+  if(m_pBig)
+    return(m_pBig->get_str());
+  std::ostringstream oss;
+  oss << *this;
+  return(oss.str());
 }
 
 void MpqWrapper::ceil() {
   if(integer()) return;
-  mpz_class n = mpq_class::get_num() / mpq_class::get_den();
-  ++n;
-  mpq_class::get_num() = n;
-  mpq_class::get_den() = 1;
+  if(m_pBig) {
+    mpz_class n = m_pBig->get_num() / m_pBig->get_den();
+    ++n;
+    setBig(mpq_class(n));
+  }
+  else
+    setSmall(m_nNum / m_nDen + 1, 1);
 }
 
 void MpqWrapper::floor() {
   if(integer()) return;
-  mpz_class n = mpq_class::get_num() / mpq_class::get_den();
-  mpq_class::get_num() = n;
-  mpq_class::get_den() = 1;
+  if(m_pBig) {
+    mpz_class n = m_pBig->get_num() / m_pBig->get_den();
+    setBig(mpq_class(n));
+  }
+  else
+    setSmall(m_nNum / m_nDen, 1);
 }
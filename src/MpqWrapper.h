@@ -27,7 +27,16 @@
 
 class MpqWrapper;
 
-class MpqWrapper : private mpq_class {
+/**
+ * Rational number that keeps small values inline as a reduced 64-bit
+ * numerator and positive denominator, and only falls back to a heap
+ * allocated GMP rational once an operation overflows. The two
+ * representations are never mixed up: whenever a GMP result fits
+ * back into 64 bits it is demoted again, so two equal values always
+ * have the same representation.
+ */
+
+class MpqWrapper {
  public:
   friend std::ostream& operator<<(std::ostream& os, const MpqWrapper& mpq);
 
@@ -49,33 +58,42 @@ class MpqWrapper : private mpq_class {
 
   ~MpqWrapper();
 
+  /**
+   * Enables or disables the 64-bit representation for all values
+   * computed from now on (it is enabled by default). Disabling it
+   * forces every value through GMP, which is only useful for
+   * comparing the two.
+   */
+
+  static void setFastPath(bool bFastPath);
+
   void initialize(const std::string& s);
 
   template<class T> void initialize(const T& p) {
-    std::ostringstream oss;
-    oss << p;
-    mpq_class::set_str(oss.str(), 10);
+    set(p);
   };
 
   template<class T1, class T2> void initialize(const T1& p,
 					       const T2& q) {
-    std::ostringstream oss;
-    oss << p << '/' << q;
-    mpq_class::set_str(oss.str(), 10);
-    mpq_class::canonicalize();
+    MpqWrapper d;
+    set(p);
+    d.set(q);
+    operator/=(d);
   };
   
   template<class T1, class T2> void initializeFloat(const T1& nWhole,
 						    const T2& nDecimal) {
-    initialize(nWhole);
     std::ostringstream oss;
     oss << nDecimal;
     size_t nDigits = oss.str().size();
     oss << nDecimal << "/1";
     for(size_t i = 0; i <= nDigits; ++i) oss << '0';
-    mpq_class::set_str(oss.str(), 10);
-    mpq_class::canonicalize();
-    operator+=(nWhole);
+    mpq_class q(oss.str(), 10);
+    q.canonicalize();
+    setBig(q);
+    MpqWrapper w;
+    w.set(nWhole);
+    operator+=(w);
   };
 
   void clear();
@@ -111,6 +129,49 @@ class MpqWrapper : private mpq_class {
   MpzWrapper get_num_mpz() const;
   MpzWrapper get_den_mpz() const;
   void print() const;
+
+ private:
+
+  /**
+   * Integral values are stored directly. Anything else is converted
+   * through its decimal representation, as before.
+   */
+
+  void set(int n);
+  void set(unsigned int n);
+  void set(long n);
+  void set(unsigned long n);
+  void set(long long n);
+  void set(unsigned long long n);
+  void set(const MpqWrapper& n);
+  template<class T> void set(const T& n) {
+    std::ostringstream oss;
+    oss << n;
+    setBig(mpq_class(oss.str(), 10));
+  };
+
+  /**
+   * Stores the given reduced fraction (q > 0) inline if it fits, and
+   * in GMP otherwise.
+   */
+
+  void setSmall(long long p, long long q);
+  void setWide(__int128 p, __int128 q);
+  void setBig(const mpq_class& q);
+
+  /**
+   * Returns the value as a GMP rational, regardless of how it is
+   * stored.
+   */
+
+  mpq_class big() const;
+  int compare(const MpqWrapper& n) const;
+
+  long long m_nNum;
+  long long m_nDen;
+  mpq_class* m_pBig;
+
+  static bool s_bFastPath;
 };
 
 std::ostream& operator<<(std::ostream& os, const MpqWrapper& mpq);
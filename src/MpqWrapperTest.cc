@@ -0,0 +1,97 @@
+/**
+ * Copyright (C) 2011 Eric Huang
+ *
+ * This file is part of rectpack.
+ *
+ * rectpack is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * rectpack is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with rectpack. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * Stand-alone randomized test for the 64-bit fast path of MpqWrapper.
+ * This is not part of rectpack; "make mpqtest" builds it and checks
+ * the results of the arithmetic and comparison operators against the
+ * same operations carried out in GMP, on operands that are drawn to
+ * land near the boundaries of the 64-bit representation.
+ */
+
+#include "MpqWrapper.h"
+#include <cstdlib>
+#include <iostream>
+
+static unsigned long long draw() {
+  unsigned long long n =
+    ((unsigned long long) random() << 33) ^
+    ((unsigned long long) random() << 11) ^ (unsigned long long) random();
+  switch(random() % 4) {
+  case 0: return(n % 100 + 1);
+  case 1: return(1ULL << (random() % 63));
+  case 2: return((1ULL << (random() % 63)) * (random() % 1000 + 1));
+  default: return((n >> (random() % 63)) | 1);
+  }
+}
+
+static void operand(MpqWrapper& w, mpq_class& q) {
+  long long p = (long long) (draw() >> 1);
+  long long d = (long long) (draw() >> 1);
+  if(d == 0) d = 1;
+  if(random() % 2) p = -p;
+  w = MpqWrapper(p, d);
+  q = mpq_class(mpz_class((long) p), mpz_class((long) d));
+  q.canonicalize();
+}
+
+static bool check(const char* s, const MpqWrapper& a, const MpqWrapper& b,
+		  const MpqWrapper& w, const mpq_class& q) {
+  if(w.get_str() == q.get_str()) return(true);
+  std::cout << a << " " << s << " " << b << " = " << w
+	    << " instead of " << q.get_str() << std::endl;
+  return(false);
+}
+
+int main() {
+  srandom(1);
+  size_t nFailures(0);
+
+  /**
+   * A product whose denominator no longer fits in 64 bits while the
+   * numerator does.
+   */
+
+  MpqWrapper a(3LL, 1LL << 32);
+  a *= MpqWrapper(1LL, 1LL << 32);
+  if(a.get_str() != "3/18446744073709551616") {
+    std::cout << "3/2^32 * 1/2^32 = " << a << std::endl;
+    ++nFailures;
+  }
+
+  for(size_t i = 0; i < 1000000; ++i) {
+    MpqWrapper wa, wb;
+    mpq_class qa, qb;
+    operand(wa, qa);
+    operand(wb, qb);
+    nFailures += !check("+", wa, wb, wa + wb, qa + qb);
+    nFailures += !check("-", wa, wb, wa - wb, qa - qb);
+    nFailures += !check("*", wa, wb, wa * wb, qa * qb);
+    if(qb != 0)
+      nFailures += !check("/", wa, wb, wa / wb, qa / qb);
+    if((wa < wb) != (qa < qb) || (wa == wb) != (qa == qb)) {
+      std::cout << "Comparing " << wa << " and " << wb << " failed."
+		<< std::endl;
+      ++nFailures;
+    }
+    if(nFailures >= 10) break;
+  }
+  std::cout << (nFailures ? "FAILED" : "PASSED") << std::endl;
+  return(nFailures ? 1 : 0);
+}
@@ -42,13 +42,13 @@ void NewCornerValues::initialize(const AlignedCongruencies& right,
 }
 
 void NewCornerValues::erase(Component* c) {
-  operator[](Left)[c->m_nX][c->m_Dims].erase(c);
-  operator[](Right)[c->x2() - 1][c->m_Dims].erase(c);
+  operator[](Left)[c->m_nX].erase(c);
+  operator[](Right)[c->x2() - 1].erase(c);
 }
 
 void NewCornerValues::insert(Component* c) {
-  operator[](Left)[c->m_nX][c->m_Dims].insert(c);
-  operator[](Right)[c->x2() - 1][c->m_Dims].insert(c);
+  operator[](Left)[c->m_nX].insert(c);
+  operator[](Right)[c->x2() - 1].insert(c);
 }
 
 void NewCornerValues::print() const {
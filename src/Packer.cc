@@ -28,10 +28,12 @@
 #include "Parameters.h"
 #include "IntPlacements.h"
 #include "MetaCSP.h"
+#include "PortfolioPacker.h"
 #include "PrecomputedSums.h"
 #include "Rational.h"
 #include "Rectangle.h"
 #include "SearchControl.h"
+#include "SplitPacker.h"
 #include "SquarePacker.h"
 #include <math.h>
 #include <iostream>
@@ -49,10 +51,26 @@ Packer::Packer() :
   m_nNonUnits(0),
   m_pControl(NULL),
   m_nDeepestConflict(0),
-  m_bInstanceRotated(false) {
+  m_bInstanceRotated(false),
+  m_bCancel(false) {
 }
 
 Packer* Packer::create(const Parameters* pParams) {
+  if(pParams->m_vPortfolio.size() > 1) {
+    Packer* pReturn = new PortfolioPacker(pParams);
+    pReturn->initialize(pReturn);
+    return(pReturn);
+  }
+  if(pParams->m_nSplit > 1 &&
+     (pParams->m_nWeakening == 0 || pParams->m_nWeakening == 2)) {
+    Packer* pReturn = new SplitPacker(pParams);
+    pReturn->initialize(pReturn);
+    return(pReturn);
+  }
+  return(createSerial(pParams));
+}
+
+Packer* Packer::createSerial(const Parameters* pParams) {
   Packer* pReturn(NULL);
   if(pParams->m_nWeakening == 0)
     pReturn = new Duplicate();
@@ -119,6 +137,9 @@ void Packer::initialize(const BoundingBoxes* pBoxes) {
 
 void Packer::printNodes() const {
   m_Nodes.print(m_Time, m_nCuSP);
+#ifdef PROBES
+  m_Probes.print();
+#endif // PROBES
 }
 
 void Packer::set(SearchControl* pControl) {
@@ -130,6 +151,7 @@ void Packer::set(SearchControl* pControl) {
 
 void Packer::initAccumulators() {
   m_nCuSP = 0;
+  m_Probes.clear();
   m_YTime = 0;
   m_XTime = 0;
   m_Time = 0;
@@ -138,6 +160,7 @@ void Packer::initAccumulators() {
 
 bool Packer::pack(const HeapBox& hb) {
   initAccumulators();
+  Probes::bind(&m_Probes);
   initialize(&hb);
   m_bInitialized = true;
   m_Time.tick();
@@ -149,6 +172,7 @@ bool Packer::pack(const HeapBox& hb) {
     bResult = packcra(m_pParams->m_sCra);
   if(bResult) placeUnitRectangles();
   m_Time.tock();
+  Probes::bind(NULL);
   if(m_bYSmallerThanX) {
     m_YTime = m_Time;
     m_YTime -= m_XTime;
@@ -181,6 +205,17 @@ bool Packer::packcra() {
   return(false);
 }
 
+void Packer::wastedSpace(UInt& nYTests, UInt& nYPrunes,
+			 UInt& nXTests, UInt& nXPrunes) const {
+}
+
+int Packer::weakening() const {
+  return(m_pParams->m_nWeakening);
+}
+
+void Packer::wins(std::vector<UInt>& v) const {
+}
+
 void Packer::print() const {
   std::cout << "ID Size    y yi.b yi.e yi.w" << std::endl;
   for(size_t i = 0; i < m_vRectPtrs.size(); ++i)
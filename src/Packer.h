@@ -24,12 +24,15 @@
 #include "BoxDimensions.h"
 #include "Coordinates.h"
 #include "DuplicateIndex.h"
+#include "Globals.h"
 #include "Integer.h"
 #include "LockableState.h"
 #include "NodeCount.h"
+#include "Probes.h"
 #include "RectArray.h"
 #include "RectPtrArray.h"
 #include "TimeSpec.h"
+#include <boost/atomic.hpp>
 #include <boost/thread/shared_mutex.hpp>
 #include <deque>
 #include <vector>
@@ -75,6 +78,13 @@ class Packer {
   virtual void initialize(const HeapBox* pBox);
   static Packer* create(const Parameters* pParams);
 
+  /**
+   * Creates the packer selected by the weakening parameter, ignoring
+   * any request to split boxes among several workers.
+   */
+
+  static Packer* createSerial(const Parameters* pParams);
+
   /**
    * Call that is made by the bounding box.
    */
@@ -116,6 +126,14 @@ class Packer {
 
   UInt m_nCuSP;
 
+  /**
+   * Calls to (and with PROBETIMERS, cycles spent in) the hot
+   * functions during the current attempt. Only updated when built
+   * with PROBES.
+   */
+
+  Probes m_Probes;
+
   /**
    * An array of class objects that represent what we will be packing
    * into our bounding box. The nth element in this array corresponds
@@ -172,6 +190,29 @@ class Packer {
 
   virtual TimeSpec& timeDomination() = 0;
 
+  /**
+   * Adds how many times the wasted space bound of the y and x
+   * searches was tested and how many of those tests pruned, over the
+   * lifetime of the packer.
+   */
+
+  virtual void wastedSpace(UInt& nYTests, UInt& nYPrunes,
+			   UInt& nXTests, UInt& nXPrunes) const;
+
+  /**
+   * The weakening level of the packer that decided the last box. A
+   * portfolio returns -1 if none of its packers did.
+   */
+
+  virtual int weakening() const;
+
+  /**
+   * Adds how many boxes were decided by the packer of each weakening
+   * level racing in a portfolio, over the lifetime of the packer.
+   */
+
+  virtual void wins(std::vector<UInt>& v) const;
+
   /**
    * Iterator that points to the first 1x1 in the sequence -- it is
    * assumed that at some point the remaining sequence will simply be
@@ -193,6 +234,18 @@ class Packer {
 
   UInt m_nDeepestConflict;
   bool m_bInstanceRotated;
+
+  /**
+   * Set (possibly by another thread) to abandon the packing attempt
+   * currently in progress. The search checks this flag at the same
+   * points where it checks for a user interrupt. Whoever sets it is
+   * responsible for clearing it before the next attempt.
+   */
+
+  boost::atomic<bool> m_bCancel;
+  bool cancelled() const {
+    return(bQuit || m_bCancel.load(boost::memory_order_relaxed));
+  }
 };
 
 #endif // PACKER_H
@@ -19,16 +19,82 @@
 
 #include "PackingCache.h"
 
-PackingCache::PackingCache() {
+PackingCache::PackingCache(size_t nCapacity) :
+  m_nHits(0),
+  m_nMisses(0),
+  m_vSlots(64),
+  m_nSize(0),
+  m_nCapacity(nCapacity) {
 }
 
 PackingCache::~PackingCache() {
 }
 
+bool PackingCache::find(const PackingCacheKey& k, size_t& v) {
+  const Slot& s = m_vSlots[probe(k)];
+  if(s.m_bUsed) {
+    ++m_nHits;
+    v = s.m_nValue;
+    return(true);
+  }
+  ++m_nMisses;
+  return(false);
+}
+
 void PackingCache::set(PackingCacheKey& k, bool bUnoriented, size_t v) {
-  operator[](k) = v;
+  insert(k, v);
   if(bUnoriented) {
-    k.m_Box.rotate();
-    operator[](k) = v;
+    k.rotate();
+    insert(k, v);
   }
 }
+
+size_t PackingCache::size() const {
+  return(m_nSize);
+}
+
+void PackingCache::clear() {
+  m_vSlots.assign(64, Slot());
+  m_nSize = 0;
+  m_nHits = 0;
+  m_nMisses = 0;
+}
+
+size_t PackingCache::probe(const PackingCacheKey& k) const {
+  size_t nMask = m_vSlots.size() - 1;
+  size_t i = k.hash() & nMask;
+  while(m_vSlots[i].m_bUsed && !(m_vSlots[i].m_Key == k))
+    i = (i + 1) & nMask;
+  return(i);
+}
+
+void PackingCache::insert(const PackingCacheKey& k, size_t v) {
+  size_t i = probe(k);
+  if(m_vSlots[i].m_bUsed) {
+    m_vSlots[i].m_nValue = v;
+    return;
+  }
+  if(m_nCapacity > 0 && m_nSize >= m_nCapacity)
+    return;
+  if(2 * (m_nSize + 1) > m_vSlots.size()) {
+    grow();
+    i = probe(k);
+  }
+  m_vSlots[i].m_Key = k;
+  m_vSlots[i].m_nValue = v;
+  m_vSlots[i].m_bUsed = true;
+  ++m_nSize;
+}
+
+void PackingCache::grow() {
+  std::vector<Slot> v(2 * m_vSlots.size());
+  v.swap(m_vSlots);
+  size_t nMask = m_vSlots.size() - 1;
+  for(std::vector<Slot>::const_iterator i = v.begin(); i != v.end(); ++i)
+    if(i->m_bUsed) {
+      size_t j = i->m_Key.hash() & nMask;
+      while(m_vSlots[j].m_bUsed)
+	j = (j + 1) & nMask;
+      m_vSlots[j] = *i;
+    }
+}
@@ -21,15 +21,51 @@
 #define PACKINGCACHE_H
 
 #include "PackingCacheKey.h"
-#include <map>
+#include <cstddef>
+#include <vector>
 
 class PackingCache;
 
-class PackingCache : public std::map<PackingCacheKey, size_t> {
+/**
+ * Open-addressing hash table from packing subproblems to their
+ * results. If a capacity is given, results for new subproblems are
+ * dropped once that many are stored.
+ */
+
+class PackingCache {
  public:
-  PackingCache();
+  PackingCache(size_t nCapacity = 0);
   ~PackingCache();
+
+  /**
+   * @return true if the subproblem is in the cache, in which case v
+   * receives its result.
+   */
+
+  bool find(const PackingCacheKey& k, size_t& v);
   void set(PackingCacheKey& k, bool bUnoriented, size_t v);
+  size_t size() const;
+  void clear();
+
+  size_t m_nHits;
+  size_t m_nMisses;
+
+ private:
+  class Slot {
+  public:
+    Slot() : m_bUsed(false) { };
+    PackingCacheKey m_Key;
+    size_t m_nValue;
+    bool m_bUsed;
+  };
+
+  size_t probe(const PackingCacheKey& k) const;
+  void insert(const PackingCacheKey& k, size_t v);
+  void grow();
+
+  std::vector<Slot> m_vSlots;
+  size_t m_nSize;
+  size_t m_nCapacity;
 };
 
 #endif // PACKINGCACHE_H
@@ -20,14 +20,20 @@
 #include "PackingCacheKey.h"
 #include "RectDecDeq.h"
 #include "RectDecorator.h"
+#include "Rectangle.h"
+#include <algorithm>
 
-PackingCacheKey::PackingCacheKey() {
+PackingCacheKey::PackingCacheKey() :
+  m_nHash(0) {
 }
 
 PackingCacheKey::PackingCacheKey(const BoxDimensions& b,
 				 const std::deque<const Rectangle*>& v) :
-  m_Box(b),
-  m_vRectangles(v) {
+  m_Box(b) {
+  for(std::deque<const Rectangle*>::const_iterator i = v.begin();
+      i != v.end(); ++i)
+    add(*i);
+  canonicalize();
 }
 
 PackingCacheKey::PackingCacheKey(const BoxDimensions& b,
@@ -35,20 +41,65 @@ PackingCacheKey::PackingCacheKey(const BoxDimensions& b,
   m_Box(b) {
   for(RectDecDeq::const_iterator i = v.begin();
       i != v.end(); ++i)
-    m_vRectangles.push_back((*i)->m_pRect);
+    add((*i)->m_pRect);
+  canonicalize();
 }
 
 PackingCacheKey::~PackingCacheKey() {
 }
 
-bool PackingCacheKey::operator<(const PackingCacheKey& rhs) const {
-  if(m_Box != rhs.m_Box) {
-    if(m_Box.m_nWidth != rhs.m_Box.m_nWidth)
-      return(m_Box.m_nWidth < rhs.m_Box.m_nWidth);
-    else
-      return(m_Box.m_nHeight < rhs.m_Box.m_nHeight);
+bool PackingCacheKey::operator==(const PackingCacheKey& rhs) const {
+  return(m_nHash == rhs.m_nHash && m_Box == rhs.m_Box &&
+	 m_vDims == rhs.m_vDims);
+}
+
+size_t PackingCacheKey::hash() const {
+  return(m_nHash);
+}
+
+void PackingCacheKey::rotate() {
+  m_Box.rotate();
+  canonicalize();
+}
+
+void PackingCacheKey::add(const Rectangle* r) {
+  if(r->m_bRotatable || r->m_nWidth == r->m_nHeight) {
+    m_vDims.push_back(r->m_nMinDim);
+    m_vDims.push_back(r->m_nMaxDim);
+    m_vDims.push_back(1);
   }
-  if(m_vRectangles != rhs.m_vRectangles)
-    return(m_vRectangles < rhs.m_vRectangles);
-  return(false);
+  else {
+    m_vDims.push_back(r->m_nWidth);
+    m_vDims.push_back(r->m_nHeight);
+    m_vDims.push_back(0);
+  }
+}
+
+void PackingCacheKey::canonicalize() {
+
+  /**
+   * Sort the triples. There are only a handful of rectangles in any
+   * gap, so an insertion sort over the flat array does fine.
+   */
+
+  for(size_t i = 3; i < m_vDims.size(); i += 3)
+    for(size_t j = i; j > 0 &&
+	  std::lexicographical_compare(m_vDims.begin() + j,
+				       m_vDims.begin() + j + 3,
+				       m_vDims.begin() + j - 3,
+				       m_vDims.begin() + j); j -= 3)
+      std::swap_ranges(m_vDims.begin() + j, m_vDims.begin() + j + 3,
+		       m_vDims.begin() + j - 3);
+
+  /**
+   * 64-bit FNV-1a over the box and the triples, one UInt at a time.
+   */
+
+  unsigned long long n = 14695981039346656037ULL;
+  n = (n ^ m_Box.m_nWidth) * 1099511628211ULL;
+  n = (n ^ m_Box.m_nHeight) * 1099511628211ULL;
+  for(std::vector<UInt>::const_iterator i = m_vDims.begin();
+      i != m_vDims.end(); ++i)
+    n = (n ^ *i) * 1099511628211ULL;
+  m_nHash = (size_t) (n ^ (n >> 32));
 }
@@ -20,13 +20,25 @@
 #ifndef PACKINGCACHEKEY_H
 #define PACKINGCACHEKEY_H
 
+#include <cstddef>
 #include <deque>
+#include <vector>
 #include "BoxDimensions.h"
+#include "Integer.h"
 
 class PackingCacheKey;
 class Rectangle;
 class RectDecDeq;
 
+/**
+ * Identifies a packing subproblem by its box and the multiset of
+ * rectangle dimensions, rather than by the rectangles themselves, so
+ * that subproblems over duplicate rectangles share a cache entry. The
+ * dimensions are stored as sorted (width, height, rotatable) triples,
+ * where rotatable rectangles and squares are normalized to have the
+ * smaller dimension first.
+ */
+
 class PackingCacheKey {
  public:
   PackingCacheKey();
@@ -34,10 +46,22 @@ class PackingCacheKey {
 		  const std::deque<const Rectangle*>& v);
   PackingCacheKey(const BoxDimensions& b, const RectDecDeq& v);
   ~PackingCacheKey();
-  bool operator<(const PackingCacheKey& rhs) const;
+  bool operator==(const PackingCacheKey& rhs) const;
+  size_t hash() const;
+
+  /**
+   * Rotates the box, leaving the rectangles as they are.
+   */
+
+  void rotate();
 
   BoxDimensions m_Box;
-  std::deque<const Rectangle*> m_vRectangles;
+  std::vector<UInt> m_vDims;
+
+ private:
+  void add(const Rectangle* r);
+  void canonicalize();
+  size_t m_nHash;
 };
 
 #endif // PACKINGCACHEKEY_H
@@ -18,6 +18,8 @@
  */
 
 #include "AsciiGrid.h"
+#include "BoxWorker.h"
+#include "Globals.h"
 #include "NodeCount.h"
 #include "Packer.h"
 #include "ParallelBoxes.h"
@@ -27,231 +29,347 @@
 #include <limits>
 
 ParallelBoxes::ParallelBoxes() :
-  m_pWorkers(NULL),
-  m_bSolutionFound(false) {
+  m_nBound(0),
+  m_nBatch(2),
+  m_nIthBox(1) {
 }
 
 ParallelBoxes::~ParallelBoxes() {
-  delete[] m_pWorkers;
+  deallocateWorkers();
 }
 
 void ParallelBoxes::initialize(const Parameters* pParams) {
   BoundingBoxes::initialize(pParams);
-  m_pPacker = NULL;
 }
 
-bool ParallelBoxes::run() {
+void ParallelBoxes::initialize(const std::deque<Packer*>& vPackers) {
+  BoundingBoxes::initialize(vPackers);
+  m_vPackers = vPackers;
+  deallocateWorkers();
+  for(size_t i = 0; i < m_vPackers.size(); ++i)
+    m_vWorkers.push_back(new BoxWorker(m_vPackers[i], i));
+}
+
+void ParallelBoxes::deallocateWorkers() {
+  while(!m_vWorkers.empty()) {
+    delete m_vWorkers.back();
+    m_vWorkers.pop_back();
+  }
+}
 
+bool ParallelBoxes::run() {
   m_sAttempts.clear();
+  m_nRecalled = 0;
   m_Total.clear();
-  m_bSolutionFound = false;
-  m_nMaxArea = std::min(m_pParams->m_vInstance.m_nStacked.m_nWidth.get_ui() *
-			m_pParams->m_vInstance.m_nMax.m_nHeight.get_ui(),
-			m_pParams->m_vInstance.m_nStacked.m_nHeight.get_ui() *
-			m_pParams->m_vInstance.m_nMax.m_nWidth.get_ui());
-  m_TotalTime = 0;
+  m_TotalTime.clear();
+  m_TotalXTime.clear();
+  m_TotalYTime.clear();
+  m_FirstOptimal.clear();
 
-  BoxDimensions b;
+  if(m_pParams->m_bSingleRun)
+    return(singleRun());
 
-  /**
-   * Create the threads and set them to run. As we create the threads,
-   * we'll assign the packer to that thread as well. Note that none of
-   * the threads will proceed until we finally unlock the mutex.
-   */
-
-  {
-    boost::unique_lock<boost::mutex> lock(m_Mutex);
-    delete[] m_pWorkers;
-    m_pWorkers = new boost::thread[m_vPackers.size()];
-    for(size_t i = 0; i < m_vPackers.size(); ++i) {
-      boost::thread t(boost::bind(&ParallelBoxes::runThread, this));
-      m_pWorkers[i].swap(t);
-      m_mAssignment[m_pWorkers[i].get_id()] = m_vPackers[i];
-    }
-    
-    /**
-     * Enter the polling loop.
-     */
-    
-    while(!m_bSolutionFound) m_SolutionFound.wait(lock);
-  }
+  m_nBound = m_nMaxArea;
+  m_nIthBox = 1;
+  clock_gettime(CLOCK_MONOTONIC, &m_Start);
 
   /**
-   * Someone found a solution. So what we'll do is to send a
-   * termination signal to every thread that is currently searching a
-   * box that is larger than the current bound.
-   *
-   * @todo It appears that if we have several threads working on
-   * different bounding boxes lower than the upper bound, and one of
-   * them can tighten the upper bound, we don't loop to terminate the
-   * other threads! Technically we should continue to loop, sending
-   * termination signals to anybody over the upper bound, until we're
-   * done. In fact, we can only exit this termination loop if all the
-   * running threads are working on boxes EQUAL to the upper bound,
-   * because they are essentially additional solutions to the optimal
-   * one.
+   * Create the threads and set them to run. Each thread is bound to
+   * its own worker (and therefore its own packer).
    */
 
-  for(size_t i = 0; i < m_vPackers.size(); ++i) {
-    m_vPackers[i]->m_BoxMutex.lock();
-    if(m_vPackers[i]->m_Box.m_nArea > m_nMaxArea)
-      m_pWorkers[i].interrupt();
-    m_vPackers[i]->m_BoxMutex.unlock();
+  for(size_t i = 0; i < m_vWorkers.size(); ++i) {
+    m_vWorkers[i]->clear();
+    boost::thread t(boost::bind(&ParallelBoxes::runThread, this,
+				m_vWorkers[i]));
+    m_vWorkers[i]->m_Thread.swap(t);
   }
-  
-  /**
-   * Join with all of the threads.
-   */
-
-  for(size_t i = 0; i < m_vPackers.size(); ++i)
-    if(m_pWorkers[i].joinable()) m_pWorkers[i].join();
 
   /**
-   * Find the optimal solutions.
+   * Join with all of the threads. There is nothing left for us to
+   * do until they all run out of work, since the bound tightening is
+   * done by the workers themselves.
    */
 
-  std::set<Attempt>::iterator i = m_sAttempts.begin();
-  for(; i != m_sAttempts.end(); ++i)
-    if(i->m_Box.m_nArea >= (URational) m_nMaxArea)
-      break;
+  for(size_t i = 0; i < m_vWorkers.size(); ++i)
+    if(m_vWorkers[i]->m_Thread.joinable())
+      m_vWorkers[i]->m_Thread.join();
+  m_nMaxArea = m_nBound;
 
   /**
-   * Print them out.
+   * Merge the results. Boxes that were completed before the bound
+   * was tightened past them would never have been attempted by the
+   * sequential search, so we don't include them in the totals.
    */
 
-  std::cout << "Optimal Solutions: ";
-  for(; i != m_sAttempts.end(); ++i)
-    if(i->m_Box.m_nArea > (URational) m_nMaxArea)
-      break;
-    else if(i->m_bResult)
-      std::cout << i->m_Box << "(" << i->m_Box.m_nArea << ")  ";
-  std::cout << std::endl;
-
-  /**
-   * Erase the rest.
-   */
+  bool bFound(false);
+  UInt nCancelled(0), nStolen(0);
+  for(size_t i = 0; i < m_vWorkers.size(); ++i) {
+    BoxWorker* w = m_vWorkers[i];
+    for(std::deque<Attempt>::const_iterator j = w->m_vAttempts.begin();
+	j != w->m_vAttempts.end(); ++j)
+      if(j->m_Box.m_nArea <= (URational) m_nMaxArea) {
+	m_sAttempts.insert(*j);
+	NodeCount nc(j->m_Nodes);
+	m_Total.accumulate(nc);
+	m_TotalTime += j->m_Time;
+      }
+    for(std::deque<std::pair<UInt, TimeSpec> >::const_iterator j =
+	  w->m_vFound.begin(); j != w->m_vFound.end(); ++j)
+      if(j->first == m_nMaxArea &&
+	 (!bFound || j->second < m_FirstOptimal)) {
+	m_FirstOptimal = j->second;
+	bFound = true;
+      }
+    m_TotalXTime += w->m_XTime;
+    m_TotalYTime += w->m_YTime;
+    nCancelled += w->m_nCancelled;
+    nStolen += w->m_nStolen;
+  }
 
-  for(std::set<Attempt>::iterator j = i; j != m_sAttempts.end(); ++j) {
-    NodeCount nc(j->m_Nodes);
-    m_Total.decumulate(nc);
-    m_TotalTime -= j->m_Time;
+  if(!m_pParams->m_bQuiet) {
+    if(bFound)
+      std::cout << "First optimal solution found after "
+		<< m_FirstOptimal.toDouble() << " seconds ("
+		<< m_FirstOptimal.toString() << ")." << std::endl;
+    std::cout << "Attempts cancelled: " << nCancelled
+	      << ", boxes stolen: " << nStolen << std::endl;
   }
-  m_sAttempts.erase(i, m_sAttempts.end());
-  return(true);
+  if(!bFound || bQuit)
+    printHeuristic();
+  return(bFound && !bQuit);
 }
 
-void ParallelBoxes::runThread() {
-
-  /**
-   * Box dimensions and timing structures that we need.
-   */
-
+void ParallelBoxes::runThread(BoxWorker* pWorker) {
+  Packer* pPacker = pWorker->m_pPacker;
   HeapBox hb;
-
-  /**
-   * As long as we should continue, grab the next box to solve, solve
-   * it, and report the results. Make sure we also grab the packer.
-   */
-
-  m_Mutex.lock();
-  Packer* pPacker = getPacker();
-  assert(pPacker != NULL);
-
-  while(getNext(hb) && boxValid(hb.m_Box)) {
-    m_Mutex.unlock();
+  while(!bQuit && take(pWorker, hb)) {
 
     /**
-     * Print the current attempt.
+     * The bound may have been tightened since this box was claimed.
+     * We check again after publishing the box as our current one so
+     * that a concurrent tightening either sees our box or we see its
+     * bound.
      */
 
-    m_Console.lock();
-    printStarting(hb.m_Box);
-    m_Console.unlock();
+    pWorker->start(hb);
+    if(!boxValid(hb.m_Box)) {
+      pWorker->finish();
+      continue;
+    }
+
+    if(!m_pParams->m_bQuiet) {
+      boost::unique_lock<boost::mutex> lock(m_Console);
+      printStarting(pWorker, hb.m_Box);
+    }
 
     /**
      * Try the packing attempt.
      */
 
     bool bResult = pPacker->pack(hb);
+    pWorker->finish();
 
     /**
-     * Since we just returned from our packing attempt, it's entirely
-     * possible that we've found the optimal solution and so our
-     * current results don't matter anymore. Let's check before we add
-     * our current results to the record.
+     * If this attempt was abandoned, the result is meaningless and we
+     * don't record it.
      */
 
-    m_Mutex.lock();
+    if(bQuit) break;
+    if(!bResult && pPacker->m_bCancel) {
+      ++pWorker->m_nCancelled;
+      if(m_Telemetry.enabled())
+	writeTelemetry(pWorker, hb.m_Box, "cancelled");
+      continue;
+    }
+    if(m_Telemetry.enabled())
+      writeTelemetry(pWorker, hb.m_Box, bResult ? "feasible" : "infeasible");
+    m_BoxStore.record(hb.m_Box, bResult, pPacker->m_nDeepestConflict,
+		      pPacker->m_Nodes, pPacker->m_Time);
 
     /**
-     * Update the results and accumulate the nodes.
+     * Record the results locally.
      */
 
-    m_sAttempts.insert(Attempt(hb.m_Box, bResult, pPacker->m_Nodes, pPacker->m_Time));
-    printid();
-    
-    m_Total.accumulate(pPacker->m_Nodes);
-    m_TotalTime += pPacker->m_Time;
+    pWorker->m_vAttempts.push_back(Attempt(hb.m_Box, bResult,
+					   pPacker->m_Nodes,
+					   pPacker->m_Time));
+    pWorker->m_XTime += pPacker->m_XTime;
+    pWorker->m_YTime += pPacker->m_YTime;
+    if(bResult) {
+      pWorker->m_vFound.push_back(std::make_pair(hb.m_Box.m_nArea, elapsed()));
+      tighten(hb.m_Box.m_nArea);
+    }
 
     /**
      * Print the results.
      */
 
-    m_Console.lock();
-    if(bResult) {
-      if(!m_pParams->m_bQuiet) {
+    if(!m_pParams->m_bQuiet) {
+      boost::unique_lock<boost::mutex> lock(m_Console);
+      std::cout << "[" << pWorker->m_nID << "] ";
+      if(bResult) {
+	std::cout << "Finished " << m_pParams->unscale(hb.m_Box.m_nWidth)
+		  << " X " << m_pParams->unscale(hb.m_Box.m_nHeight)
+		  << " = " << m_pParams->unscale2(hb.m_Box.m_nArea)
+		  << " (feasible)." << std::endl;
 	AsciiGrid ag;
 	Placements v;
-	m_pPacker->get(v);
+	pPacker->get(v);
+	if(pPacker->m_bInstanceRotated)
+	  v.rotate();
+	if(!v.verify())
+	  std::cout << "  Error: Constraints not satisfied." << std::endl;
 	ag.draw(m_pParams, v);
 	ag.print();
 	std::cout << "  Rectangles were placed in these (x,y) locations:"
 		  << std::endl;
 	v *= m_pParams->m_vInstance.m_nScale;
 	v.print();
+	std::cout << std::endl << std::endl;
       }
-      m_nMaxArea = std::min(m_nMaxArea, hb.m_Box.m_nArea);
-      m_bSolutionFound = true;
-      m_SolutionFound.notify_all();
-    }
-    else {
-      std::cout << "Finished " << hb.m_Box.m_nWidth << " X "
-		<< hb.m_Box.m_nHeight
-		<< " = " << hb.m_Box.m_nArea
-		<< " (infeasible)." << std::endl;
+      else
+	std::cout << "Finished " << m_pParams->unscale(hb.m_Box.m_nWidth)
+		  << " X " << m_pParams->unscale(hb.m_Box.m_nHeight)
+		  << " = " << m_pParams->unscale2(hb.m_Box.m_nArea)
+		  << " (infeasible)." << std::endl;
       pPacker->printNodes();
     }
-    m_Console.unlock();
   }
-  m_Mutex.unlock();
 }
 
-void ParallelBoxes::set(const std::deque<Packer*>& vPackers) {
-  m_vPackers = vPackers;
-  delete[] m_pWorkers;
-  m_pWorkers = new boost::thread[m_vPackers.size()];
+bool ParallelBoxes::take(BoxWorker* pWorker, HeapBox& hb) {
+  while(true) {
+    if(pWorker->pop(hb)) return(true);
+
+    /**
+     * Our own deque is empty. Find the sibling holding the pending
+     * box of smallest area.
+     */
+
+    BoxWorker* pVictim(NULL);
+    UInt nVictim(std::numeric_limits<UInt>::max());
+    for(size_t i = 0; i < m_vWorkers.size(); ++i) {
+      UInt nArea;
+      if(m_vWorkers[i] != pWorker && m_vWorkers[i]->front(nArea) &&
+	 nArea < nVictim) {
+	nVictim = nArea;
+	pVictim = m_vWorkers[i];
+      }
+    }
+
+    /**
+     * Claim more boxes from the queue unless the sibling's box comes
+     * first.
+     */
+
+    {
+      boost::unique_lock<boost::mutex> lock(m_Mutex);
+      if(!m_vBoxes.empty() &&
+	 (pVictim == NULL || m_vBoxes.top().m_Box.m_nArea < nVictim) &&
+	 refill(pWorker) > 0)
+	continue;
+    }
+
+    /**
+     * Steal from the sibling. If someone else got there first, we
+     * simply look again.
+     */
+
+    if(pVictim == NULL) return(false);
+    if(pVictim->pop(hb)) {
+      ++pWorker->m_nStolen;
+      return(true);
+    }
+  }
+  return(false);
+}
+
+size_t ParallelBoxes::refill(BoxWorker* pWorker) {
+  size_t n(0);
+  HeapBox hb;
+  while(n < m_nBatch && getNext(hb)) {
+
+    /**
+     * The queue is ordered by area, so once we exceed either the
+     * bound or the requested range of boxes, we're done with it.
+     */
+
+    if(!boxValid(hb.m_Box) || m_nIthBox > m_pParams->m_nMthBox) {
+      m_vBoxes.clear();
+      break;
+    }
+
+    /**
+     * Since the other workers can't wait for this attempt to finish
+     * before drawing further boxes, we enqueue the successors right
+     * away, using the conflict learning index of the box itself
+     * rather than the (not yet known) deepest conflict.
+     */
+
+    if(m_nIthBox++ < m_pParams->m_nNthBox) continue;
+    if(recalled(hb)) continue;
+    if(m_bAllIntegralBoxes)
+      pushNextInt(hb);
+    else
+      pushNext(hb, hb.m_nConflictLearningIndex);
+    pWorker->push(hb);
+    ++n;
+  }
+  return(n);
+}
+
+void ParallelBoxes::recall(const HeapBox& hb, const BoxStore::Entry& e) {
+  {
+    boost::unique_lock<boost::mutex> lock(m_Console);
+    printRecalled(hb.m_Box, e);
+  }
+
+  /**
+   * As in refill, the successors follow the box's own conflict
+   * learning index rather than the recorded one.
+   */
+
+  if(m_bAllIntegralBoxes)
+    pushNextInt(hb);
+  else
+    pushNext(hb, hb.m_nConflictLearningIndex);
+}
+
+void ParallelBoxes::tighten(UInt nArea) {
+  UInt nBound = m_nBound.load();
+  while(nArea < nBound &&
+	!m_nBound.compare_exchange_weak(nBound, nArea));
+  nBound = m_nBound.load();
+  for(size_t i = 0; i < m_vWorkers.size(); ++i)
+    m_vWorkers[i]->cancel(nBound);
 }
 
 bool ParallelBoxes::boxValid(const BoxDimensions& b) const {
-  return(b.m_nArea <= m_nMaxArea);
+  return(b.m_nArea <= m_nBound.load());
 }
 
-Packer* ParallelBoxes::getPacker() {
-  std::map<boost::thread::id, Packer*>::iterator i =
-    m_mAssignment.find(boost::this_thread::get_id());
-  if(i == m_mAssignment.end()) return(NULL);
-  return(i->second);
+TimeSpec ParallelBoxes::elapsed() const {
+  TimeSpec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  t -= m_Start;
+  return(t);
 }
 
-void ParallelBoxes::printStarting(const BoxDimensions& b) const {
-  printid();
-  std::cout << "Starting " << b.m_nWidth << " X " << b.m_nHeight
-	    << " = " << b.m_nArea
-	    << std::endl << std::endl;
+void ParallelBoxes::writeTelemetry(BoxWorker* pWorker,
+				   const BoxDimensions& b,
+				   const char* sResult) {
+  size_t nQueue;
+  {
+    boost::unique_lock<boost::mutex> lock(m_Mutex);
+    nQueue = m_vBoxes.size();
+  }
+  m_Telemetry.write(b, sResult, pWorker->m_pPacker, pWorker->m_nID,
+		    nQueue, pWorker->size());
 }
 
-void ParallelBoxes::printid() const {
-  std::cout << boost::this_thread::get_id()
-	    << " ------------------------------------------------------------"
-	    << std::endl;
+void ParallelBoxes::printStarting(const BoxWorker* pWorker,
+				  const BoxDimensions& b) const {
+  std::cout << "[" << pWorker->m_nID << "] ";
+  printAttempt(b);
 }
@@ -22,15 +22,25 @@
 
 #include "BoundingBoxes.h"
 #include "Integer.h"
+#include "TimeSpec.h"
+#include <boost/atomic.hpp>
 #include <boost/thread/mutex.hpp>
-#include <boost/thread.hpp>
+#include <deque>
 #include <vector>
 
+class BoxWorker;
+class Packer;
 class Parameters;
 
 /**
- * Note that this is very much broken because we did not update the
- * multi-threaded version of our rectangle packing program.
+ * Explores the bounding boxes with one packer per thread. Boxes are
+ * claimed from the shared priority queue in small batches into
+ * per-worker deques, and idle workers steal from each other whenever
+ * a sibling holds a smaller pending box than the top of the queue.
+ * The shared mutex is only held while touching the priority queue;
+ * the results are kept per worker and the best area found so far is
+ * published atomically. Every time the bound tightens, all workers
+ * packing a box larger than the bound are cancelled.
  */
 
 class ParallelBoxes : public BoundingBoxes {
@@ -38,55 +48,95 @@ class ParallelBoxes : public BoundingBoxes {
   ParallelBoxes();
   virtual ~ParallelBoxes();
   virtual void initialize(const Parameters* pParams);
+  virtual void initialize(const std::deque<Packer*>& vPackers);
   virtual bool run();
-  virtual void set(const std::deque<Packer*>& vPackers);
-  virtual void printStarting(const BoxDimensions& b) const;
+
+  /**
+   * Wall-clock time from the start of run() until the first solution
+   * of optimal area was found. Unlike the total time, this doesn't
+   * depend on how long the remaining workers take to prove that no
+   * smaller box exists.
+   */
+
+  TimeSpec m_FirstOptimal;
 
  private:
   bool boxValid(const BoxDimensions& b) const;
-  void runThread();
-  void printid() const;
-  Packer* getPacker();
+  void runThread(BoxWorker* pWorker);
+  void printStarting(const BoxWorker* pWorker,
+		     const BoxDimensions& b) const;
 
   /**
-   * Shared data (this class).
+   * Records the worker's most recent attempt along with how much work
+   * is still pending in the shared queue and in the worker's deque.
    */
 
-  boost::mutex m_Mutex;
+  void writeTelemetry(BoxWorker* pWorker, const BoxDimensions& b,
+		      const char* sResult);
 
   /**
-   * All of our worker threads.
+   * Retrieves the next box for the given worker, first from its own
+   * deque, then from either the priority queue or a sibling's deque,
+   * whichever holds the box of smallest area.
+   *
+   * @return false if there is no more work to be done.
    */
 
-  boost::thread* m_pWorkers;
+  bool take(BoxWorker* pWorker, HeapBox& hb);
 
   /**
-   * Our local copy of the packers.
+   * Moves up to m_nBatch boxes from the priority queue into the
+   * worker's deque. The caller must hold m_Mutex.
    */
 
-  std::deque<Packer*> m_vPackers;
+  size_t refill(BoxWorker* pWorker);
+
+  /**
+   * Lowers the bound to the given area and cancels every worker
+   * whose current box exceeds it.
+   */
+
+  void tighten(UInt nArea);
+  TimeSpec elapsed() const;
+  virtual void recall(const HeapBox& hb, const BoxStore::Entry& e);
+  void deallocateWorkers();
 
   /**
-   * Map from the worker to the packer to use.
+   * Guards the priority queue as well as the subset sum iterators
+   * used to enqueue new boxes.
    */
 
-  std::map<boost::thread::id, Packer*> m_mAssignment;
+  boost::mutex m_Mutex;
 
   /**
    * A mutex for printing to the console (so that we don't clobber
    * each others' results).
    */
 
-  boost::mutex m_Console;
+  mutable boost::mutex m_Console;
+
+  /**
+   * Our local copy of the packers, and the workers that use them.
+   */
+
+  std::deque<Packer*> m_vPackers;
+  std::vector<BoxWorker*> m_vWorkers;
+
+  /**
+   * The area of the smallest feasible box found so far.
+   */
+
+  boost::atomic<UInt> m_nBound;
 
   /**
-   * The condition variable that our threads will use to notify us
-   * that they've found a solution.
+   * The number of boxes to claim from the priority queue at once,
+   * and the index of the next box to be claimed (for the box range
+   * given on the command line).
    */
 
-  boost::condition_variable m_SolutionFound;
-  bool m_bSolutionFound;
-  UInt m_nMaxArea;
+  size_t m_nBatch;
+  size_t m_nIthBox;
+  TimeSpec m_Start;
 };
 
 #endif // PARALLELBOXES_H
@@ -17,7 +17,10 @@
  * along with rectpack. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include "BinsKernel.h"
+#include "MinPlus.h"
 #include "Parameters.h"
+#include <algorithm>
 #include <boost/program_options/options_description.hpp>
 #include <boost/program_options/parsers.hpp>
 #include <boost/program_options/variables_map.hpp>
@@ -47,6 +50,9 @@ Parameters::Parameters() {
   m_bScheduling = false;
   m_nWeakening = 0;
   m_nThreads = 0;
+  m_nSplit = 1;
+  m_nSplitDepth = 1;
+  m_nCheckpointPeriod = 60;
   m_nTrials = 0;
   m_nSubsetSize = 0;
   m_nRangeSize = 0;
@@ -74,7 +80,16 @@ Parameters::Parameters(const Parameters& p) :
   m_bScheduling(p.m_bScheduling),
   m_nWeakening(p.m_nWeakening),
   m_nThreads(p.m_nThreads),
+  m_nSplit(p.m_nSplit),
+  m_nSplitDepth(p.m_nSplitDepth),
+  m_sPortfolio(p.m_sPortfolio),
+  m_vPortfolio(p.m_vPortfolio),
+  m_sDomCache(p.m_sDomCache),
+  m_sBoxStore(p.m_sBoxStore),
+  m_sCheckpoint(p.m_sCheckpoint),
+  m_nCheckpointPeriod(p.m_nCheckpointPeriod),
   m_sCra(p.m_sCra),
+  m_sTelemetry(p.m_sTelemetry),
   m_sExtend(p.m_sExtend),
   m_Log(p.m_Log),
   m_sRegression(p.m_sRegression),
@@ -113,7 +128,16 @@ const Parameters& Parameters::operator=(const Parameters& p) {
   m_bScheduling = p.m_bScheduling;
   m_nWeakening = p.m_nWeakening;
   m_nThreads = p.m_nThreads;
+  m_nSplit = p.m_nSplit;
+  m_nSplitDepth = p.m_nSplitDepth;
+  m_sPortfolio = p.m_sPortfolio;
+  m_vPortfolio = p.m_vPortfolio;
+  m_sDomCache = p.m_sDomCache;
+  m_sBoxStore = p.m_sBoxStore;
+  m_sCheckpoint = p.m_sCheckpoint;
+  m_nCheckpointPeriod = p.m_nCheckpointPeriod;
   m_sCra = p.m_sCra;
+  m_sTelemetry = p.m_sTelemetry;
   m_sExtend = p.m_sExtend;
   m_Log = p.m_Log;
   m_sRegression = p.m_sRegression;
@@ -156,6 +180,8 @@ int Parameters::parseIJCAI(int argc, char** argv) {
   m_nOrdering = 8;
   m_nRandom = 1;
   m_nThreads = 1;
+  m_nSplit = 1;
+  m_nSplitDepth = 1;
   m_nWeakening = 2;
   m_bKorf = false;
   m_bScheduling = false;
@@ -171,14 +197,7 @@ int Parameters::parseIJCAI(int argc, char** argv) {
    * by height and not width.
    */
 
-  if(m_nOrdering == 8 && m_nWeakening < 3) {
-    if(m_vInstance.m_bUnoriented)
-      m_vInstance.sortDecreasingArea();
-    else
-      m_vInstance.sortDecreasingHeight();
-  }
-  else
-    m_vInstance.sort(m_nOrdering);
+  sortInstance();
   m_vInstance.inferInstanceProperties();
   m_vUnscaled = m_vInstance;
   return(0);
@@ -326,6 +345,29 @@ void Parameters::parseFix(const std::string& s) {
   }
 }
 
+void Parameters::parsePortfolio(const std::string& s) {
+  if(s.empty()) return;
+  using namespace boost::spirit::classic;
+  m_vPortfolio.clear();
+  rule<> w = int_p[push_back_a(m_vPortfolio)];
+  bool bParsed = parse(s.c_str(), w >> *(ch_p(',') >> w)).full;
+  for(size_t i = 0; bParsed && i < m_vPortfolio.size(); ++i)
+    bParsed = m_vPortfolio[i] >= 0 && m_vPortfolio[i] <= 5 &&
+      std::count(m_vPortfolio.begin(), m_vPortfolio.begin() + i,
+		 m_vPortfolio[i]) == 0;
+  if(!bParsed) {
+    std::cout << "I don't understand your portfolio specification: "
+	      << s << std::endl;
+    exit(0);
+  }
+  if(m_nWeakening == 6 || m_bKorf) {
+    std::cout << "The portfolio doesn't apply to "
+	      << (m_bKorf ? "Korf's packer." : "the anytime packer.")
+	      << std::endl;
+    exit(0);
+  }
+}
+
 void Parameters::parseRegression(const std::string& s) {
   if(s.empty()) return;
   typedef boost::tokenizer<boost::char_separator<char> > 
@@ -354,14 +396,7 @@ void Parameters::rerollRegression() {
     p.resize(m_nSubsetSize);
   }
   m_vInstance.parseInstance(p);
-  if(m_nOrdering == 8 && m_nWeakening < 3) {
-    if(m_vInstance.m_bUnoriented)
-      m_vInstance.sortDecreasingArea();
-    else
-      m_vInstance.sortDecreasingHeight();
-  }
-  else
-    m_vInstance.sort(m_nOrdering);
+  sortInstance();
   m_vInstance.inferInstanceProperties();
   m_vUnscaled = m_vInstance;
 }
@@ -380,8 +415,22 @@ void Parameters::print() const {
   std::cout << std::endl;
   if(m_nThreads > 1)
     std::cout << "Threads = " << m_nThreads << std::endl;
+  if(m_nSplit > 1)
+    std::cout << "Workers per box = " << m_nSplit << " (split at depth "
+	      << m_nSplitDepth << ")" << std::endl;
+  if(!m_vPortfolio.empty())
+    std::cout << "Portfolio = " << m_sPortfolio << std::endl;
+  if(!m_sDomCache.empty())
+    std::cout << "Domination table cache = " << m_sDomCache << std::endl;
+  if(!m_sBoxStore.empty())
+    std::cout << "Box store = " << m_sBoxStore << std::endl;
+  if(!m_sCheckpoint.empty())
+    std::cout << "Checkpoint directory = " << m_sCheckpoint
+	      << " (every " << m_nCheckpointPeriod << "s)" << std::endl;
   if(!m_sCra.empty())
     std::cout << "Contiguous resource solution file = " << m_sCra << std::endl;
+  if(!m_sTelemetry.empty())
+    std::cout << "Telemetry file = " << m_sTelemetry << std::endl;
   if(!m_sExtend.empty())
     std::cout << "Extension file = " << m_sExtend << std::endl;
   if(!m_sRegression.empty()) {
@@ -444,6 +493,67 @@ void Parameters::rescaleInstance() {
   moveUnitRectangles();
 }
 
+void Parameters::sortInstance() {
+  if(m_nOrdering == 8 && m_nWeakening < 3) {
+    if(m_vInstance.m_bUnoriented)
+      m_vInstance.sortDecreasingArea();
+    else
+      m_vInstance.sortDecreasingHeight();
+  }
+  else
+    m_vInstance.sort(m_nOrdering);
+}
+
+bool Parameters::coarsen(const URational& nResolution) {
+
+  /**
+   * Shrink the rectangles, rounding down, and drop those that vanish
+   * altogether. Fixed rectangles would have to be coarsened along
+   * with their locations, so we don't support them.
+   */
+
+  if(!m_vFixed.empty()) return(false);
+  m_vInstance /= nResolution;
+  m_vInstance.roundDown();
+  Instance v(m_vInstance);
+  m_vInstance.clear();
+  for(Instance::const_iterator i = v.begin(); i != v.end(); ++i)
+    if(i->m_nWidth > (URational) 0 && i->m_nHeight > (URational) 0)
+      m_vInstance.push_back(*i);
+  if(m_vInstance.empty()) return(false);
+
+  /**
+   * The coarsened instance is solved on its own, quietly, without
+   * any box filters or auxiliary output, and without coarsening it
+   * any further.
+   */
+
+  sortInstance();
+  m_vInstance.m_nScale = (URational) 1;
+  m_vInstance.inferInstanceProperties();
+  m_vUnscaled = m_vInstance;
+  initBox();
+  m_sBox.clear();
+  m_sExtend.clear();
+  m_Log = LogState();
+  m_sRegression.clear();
+  m_sTelemetry.clear();
+  m_sCheckpoint.clear();
+  m_sBoxStore.clear();
+  m_sPortfolio.clear();
+  m_vPortfolio.clear();
+  m_sCra.clear();
+  m_bQuiet = true;
+  m_bVerbose = false;
+  m_nThreads = 1;
+  std::string::size_type n;
+  while((n = m_s0.find_first_of('l')) < m_s0.size())
+    m_s0.erase(n, 1);
+  if(m_s0.find_first_of('n') >= m_s0.size())
+    rescaleInstance();
+  return(true);
+}
+
 void Parameters::moveUnitRectangles() {
 
   /**
@@ -513,8 +623,10 @@ void Parameters::getDescription(boost::program_options::options_description& des
     "for a bounding box by a string that includes any of the "
     "following case-sensitive symbols:\n\n"
     "  c: \tdisables conflict learning for subset sums\n"
+    "  g: \tdisables the 64-bit fast path for rational numbers, computing everything with GMP\n"
+    "  h: \tdisables the heuristic packers that bound the area from above before the search\n"
     "  i: \texplore all integer boxes\n"
-    "  l: \tenables the computation of a low-resolution lower bound solution (experimental)\n"
+    "  l: \traises the area lower bound by solving the instance coarsened to lower resolutions\n"
     "  m: \tdisable mutual exclusion checking between rectangle widths and heights\n"
     "  n: \tdisables normalization of the instance to remove denominators and reduce factors\n"
     "  r: \tdisables reduction scaling of the instance -- scaling up is still allowed\n"
@@ -535,6 +647,7 @@ void Parameters::getDescription(boost::program_options::options_description& des
     "  r: \tdisables range consideration of domination entries\n"
     "  s: \tdisables the confining the first rectangle to one quadrant of the bounding box\n"
     "  v: \tdisables dynamic variable ordering\n"
+    "  V: \tdisables the SIMD kernels for the bin capacity checks and shortest paths\n"
     "  w: \tdisables the wasted space heuristic\n";
 
   const char p2[] =
@@ -573,6 +686,32 @@ void Parameters::getDescription(boost::program_options::options_description& des
     "previous descriptions (except for the cardinal specifications) "
     "are used to specify the initial bounds.\n";
 
+  const char pDomCache[] =
+    "Directory in which to cache the domination tables between runs. "
+    "The tables depend only on the instance and the packer options, "
+    "so subsequent runs on the same instance load them from this "
+    "directory instead of building them. The directory must already "
+    "exist. By default nothing is cached.\n";
+
+  const char pBoxStore[] =
+    "Directory in which to keep the outcome of every packing attempt "
+    "between runs. Boxes that an earlier run (or a concurrent one) "
+    "proved infeasible for the same instance and packer options are "
+    "skipped instead of being packed again. The directory must "
+    "already exist. By default nothing is kept.\n";
+
+  const char pCheckpoint[] =
+    "Directory in which the integer packers (-w 0 to 2) periodically "
+    "snapshot their search of the bounding box they are working on, "
+    "and once more when interrupted. If a snapshot of the same box of "
+    "the same instance and packer options is found there, the search "
+    "resumes from it instead of starting the box over. Use it along "
+    "with --boxstore to also skip the boxes that were completed. The "
+    "directory must already exist. By default nothing is saved.\n";
+
+  const char pCheckpointPeriod[] =
+    "Number of seconds between the snapshots of --checkpoint.\n";
+
   const char pCra[] =
     "Work on the contiguous resource allocation problems in the given "
     "file. The file is expected to have been generated by the "
@@ -631,6 +770,17 @@ void Parameters::getDescription(boost::program_options::options_description& des
     "  7: \tSort by increasing H/W\n"
     "  8: \t(Default) Sort by decreasing branching factor (width for oriented cases and area for unoriented)\n";
   
+  const char pPortfolio[] =
+    "Races the packers with the given comma-delimited, distinct "
+    "weakening levels (0 to 5, see --weakening) on every bounding box, "
+    "each on its own thread. The first one to decide the box wins and "
+    "the others are cancelled. The winner of each attempt is recorded "
+    "in the telemetry, and the number of boxes each packer won is "
+    "printed at the end, which tells which packer to use by default "
+    "for similar instances. The rectangles are still ordered for the "
+    "packer selected by --weakening, and --split and --checkpoint are "
+    "ignored. By default a single packer is used.\n";
+
   const char pQuiet[] =
     "Be quiet.\n";
 
@@ -653,6 +803,27 @@ void Parameters::getDescription(boost::program_options::options_description& des
     "Solves just the cumulative scheduling problem and returns after "
     "the first solution is found.\n";
 
+  const char pSplit[] =
+    "Number of worker threads that cooperate on each individual "
+    "bounding box. The subtrees of the first-dimension search at the "
+    "depth given by --splitdepth are divided among the workers, and "
+    "the remaining workers are cancelled as soon as any one of them "
+    "finds a packing. Only applies to the integer packers 0 and 2. "
+    "The default is 1 (no splitting).\n";
+
+  const char pSplitDepth[] =
+    "The depth (number of rectangles already placed) of the "
+    "first-dimension search tree at which the subtrees are divided "
+    "among the workers requested by --split. The default is 1.\n";
+
+  const char pTelemetry[] =
+    "Appends one line to the given file for every packing attempt, "
+    "holding a JSON object with the bounding box, the result, the "
+    "weakening level of the packer that decided it (see --portfolio), "
+    "the nodes of each type, the X, Y and domination table CPU times, the "
+    "number of CuSP solutions, the worker thread and the number of "
+    "boxes still queued.\n";
+
   const char pThreads[] =
     "Number of worker threads to use. The default is 1 (the program "
     "will be single-threaded.\n";
@@ -696,7 +867,11 @@ void Parameters::getDescription(boost::program_options::options_description& des
     ("2,2", po::value<std::string>(&m_s2)->default_value(""), p2)
     ("benchmark,b", po::value<int>(&m_vInstance.m_nBenchmark)->default_value(3), pBenchmark)
     ("box,B", po::value<std::string>(&m_sBox)->default_value(""), pBox)
+    ("boxstore,S", po::value<std::string>(&m_sBoxStore)->default_value(""), pBoxStore)
+    ("checkpoint,K", po::value<std::string>(&m_sCheckpoint)->default_value(""), pCheckpoint)
+    ("checkpointperiod,P", po::value<int>(&m_nCheckpointPeriod)->default_value(60), pCheckpointPeriod)
     ("cra,c", po::value<std::string>(&m_sCra)->default_value(""), pCra)
+    ("domcache,D", po::value<std::string>(&m_sDomCache)->default_value(""), pDomCache)
     ("extend,e", po::value<std::string>(&m_sExtend)->default_value(""), pExtend)
     ("fit,F", pFit)
     ("fix,f", po::value<std::string>(&m_sFix)->default_value(""), pFix)
@@ -707,10 +882,14 @@ void Parameters::getDescription(boost::program_options::options_description& des
     ("jvalue,j", po::value<float>(&m_nJValue)->default_value(-2.0), pJValue)
     ("korf,k", pKorf)
     ("ordering,o", po::value<int>(&m_nOrdering)->default_value(8), pOrdering)
+    ("portfolio,W", po::value<std::string>(&m_sPortfolio)->default_value(""), pPortfolio)
     ("quiet,q", pQuiet)
     ("random,r", po::value<int>(&m_nRandom)->default_value(1), pRandom)
     ("regression,R", po::value<std::string>(&m_sRegression)->default_value(""), pRegression)
     ("scheduling,s", pScheduling)
+    ("split,p", po::value<int>(&m_nSplit)->default_value(1), pSplit)
+    ("splitdepth,d", po::value<int>(&m_nSplitDepth)->default_value(1), pSplitDepth)
+    ("telemetry,T", po::value<std::string>(&m_sTelemetry)->default_value(""), pTelemetry)
     ("threads,t", po::value<int>(&m_nThreads)->default_value(1), pThreads)
     ("unoriented,u", pUnoriented)
     ("verbose,v", pVerbose)
@@ -738,6 +917,15 @@ void Parameters::parseAux(boost::program_options::options_description& desc,
   m_bVerbose = (vm.count("verbose") > 0);
   m_vInstance.m_bUnoriented = (vm.count("unoriented") > 0);
   if(m_nWeakening < 0) m_nWeakening = 2;
+  MpqWrapper::setFastPath(m_s0.find_first_of('g') >= m_s0.size());
+
+  /**
+   * The kernels are shared by every packer, so they are picked here
+   * once, before any of them (or their threads) run.
+   */
+
+  BinsKernel::select(m_s1.find_first_of('V') >= m_s1.size());
+  MinPlus::select(m_s1.find_first_of('V') >= m_s1.size());
   if(m_s1.find_first_of('i') < m_s1.size())
     m_sYScale = "0.0";
   m_nYScale.initialize(m_sYScale);
@@ -749,17 +937,11 @@ void Parameters::parseAux(boost::program_options::options_description& desc,
 
   parseBox(m_sBox);
   parseFix(m_sFix);
+  parsePortfolio(m_sPortfolio);
   parseGeometry(m_sGeometry);
   m_vInstance.parseInstance(m_vInstance.m_sInstance);
   if(m_nJValue > -1.0) m_vInstance.rewriteJValue(m_nJValue);
-  if(m_nOrdering == 8 && m_nWeakening < 3) {
-    if(m_vInstance.m_bUnoriented)
-      m_vInstance.sortDecreasingArea();
-    else
-      m_vInstance.sortDecreasingHeight();
-  }
-  else
-    m_vInstance.sort(m_nOrdering);
+  sortInstance();
   m_vInstance.inferInstanceProperties();
   m_vUnscaled = m_vInstance;
   parseRegression(m_sRegression);
@@ -50,6 +50,18 @@ class Parameters {
   int parseIJCAI(int argc, char** argv);
   void saveCommandLine(int argc, char** argv);
   void rescaleInstance();
+
+  /**
+   * Turns these parameters into those of a relaxed problem, in which
+   * the dimensions of every rectangle are divided by the given
+   * resolution and rounded down. The instance is then rescaled just
+   * as if it had been given on the command line.
+   *
+   * @return false if the instance can't be coarsened (it has fixed
+   * rectangles, or no rectangle survives the rounding).
+   */
+
+  bool coarsen(const URational& nResolution);
   UInt scale(const URational& ur) const;
   UInt scale2(const URational& ur) const;
   URational unscale(const UInt& ui) const;
@@ -93,8 +105,56 @@ class Parameters {
   bool m_bScheduling;
   int m_nWeakening;
   int m_nThreads;
+
+  /**
+   * Number of workers that cooperate on a single bounding box, and
+   * the depth of the first-dimension search tree at which the
+   * workers divide the subtrees among themselves.
+   */
+
+  int m_nSplit;
+  int m_nSplitDepth;
+
+  /**
+   * Weakening levels of the packers that race on every bounding
+   * box. Empty if a single packer was requested.
+   */
+
+  void parsePortfolio(const std::string& s);
+  std::string m_sPortfolio;
+  std::vector<int> m_vPortfolio;
+
+  /**
+   * Directory in which the domination tables are cached between
+   * runs. Empty if the cache is disabled.
+   */
+
+  std::string m_sDomCache;
+
+  /**
+   * Directory in which the outcomes of the packing attempts are kept
+   * between runs. Empty if the store is disabled.
+   */
+
+  std::string m_sBoxStore;
+
+  /**
+   * Directory in which the integer packers snapshot their search of
+   * the current bounding box, and the number of seconds between the
+   * snapshots. Empty if no snapshots were requested.
+   */
+
+  std::string m_sCheckpoint;
+  int m_nCheckpointPeriod;
   std::string m_sCra;
 
+  /**
+   * File to which a JSON record of every packing attempt is
+   * appended. Empty if no telemetry was requested.
+   */
+
+  std::string m_sTelemetry;
+
   /**
    * Attempts to resume a previous run.
    */
@@ -191,6 +251,12 @@ class Parameters {
    */
 
   void moveUnitRectangles();
+
+  /**
+   * Sorts the instance according to the requested ordering.
+   */
+
+  void sortInstance();
 }; // class Parameters
 
 #endif // PARAMETERS_H
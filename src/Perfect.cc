@@ -32,6 +32,7 @@ Perfect::Perfect() :
   m_pTime(NULL),
   m_pGrid(NULL),
   m_pNodes(NULL),
+  m_pCancel(NULL),
   m_nDepth(0),
   m_nAdjacency(0),
   m_nCorners(0),
@@ -60,12 +61,14 @@ void Perfect::initialize(const std::string& sParams) {
 
 void Perfect::initialize(UInt* pCuSP, BoxDimensions* pBox,
 			 TimeSpec* pTime, Grid* pGrid,
-			 NodeCount* pNodes) {
+			 NodeCount* pNodes,
+			 const boost::atomic<bool>* pCancel) {
   m_pCuSP = pCuSP;
   m_pBox = pBox;
   m_pTime = pTime;
   m_pGrid = pGrid;
   m_pNodes = pNodes;
+  m_pCancel = pCancel;
   m_Inferences.clear();
 }
 
@@ -130,10 +133,11 @@ bool Perfect::packX(Bins* pBins, RectPtrArray::iterator iBegin,
 		       m_Inferences.m_BottomSymmetries);
 
   /**
-   * Allocate more wasted spaces arrays if necessary.
+   * Start the wasted space histogram from the empty box.
    */
 
-  m_vWastedX.resize(m_Inferences.m_vComponents.size());
+  m_vWastedX = m_vWastedXF;
+  m_vWastedX.clearTrail();
   m_vPlaced.clear();
   m_vPlaced.resize(m_Inferences.m_vComponents.size(), false);
 
@@ -141,7 +145,6 @@ bool Perfect::packX(Bins* pBins, RectPtrArray::iterator iBegin,
    * Enforce any top-level domination conditions.
    */
 
-  WastedBins* pFirstWasted(&m_vWastedXF);
   if(m_bTopLevelDomination = !m_Inferences.m_lDomination.empty()) {
     UInt nBestArea(0);
     std::pair<UInt, UInt> best;
@@ -165,21 +168,17 @@ bool Perfect::packX(Bins* pBins, RectPtrArray::iterator iBegin,
       }
     }
     
-    if(best.first == best.second) {
-      forceDominationLeft(best.first, m_vWastedXF);
-      pFirstWasted = &m_vWastedX[best.first];
-    }
-    else {
-      forceDominationLeft(best.first, best.second, m_vWastedXF);
-      pFirstWasted = &m_vWastedX[best.second];
-    }
+    if(best.first == best.second)
+      forceDominationLeft(best.first);
+    else
+      forceDominationLeft(best.first, best.second);
   }
 
   /**
    * Run the search.
    */
 
-  bool bResult(packXAux(0, *pFirstWasted));
+  bool bResult(packXAux(0));
   t.tock();
   (*m_pTime) += t;
   if(bResult) return(true);
@@ -190,9 +189,9 @@ bool Perfect::packX(Bins* pBins, RectPtrArray::iterator iBegin,
   }
 }
 
-bool Perfect::packXAux(Int nDepth, const WastedBins& v) {
+bool Perfect::packXAux(Int nDepth) {
 
-  if(bQuit) return(false);
+  if(bQuit || m_pCancel->load(boost::memory_order_relaxed)) return(false);
 
   /**
    * Base case is when we've got
@@ -225,18 +224,18 @@ bool Perfect::packXAux(Int nDepth, const WastedBins& v) {
     adjacencySize(nSize2, l, pForced);
     if(nSize2 == 0) return(false);
     if(nSize1 <= nSize2)
-      return(packXCorner(ec, nDepth, v));
+      return(packXCorner(ec, nDepth));
     else
-      return(packXAdjacency(pForced, l, nDepth, v));
+      return(packXAdjacency(pForced, l, nDepth));
   }
   else
-    return(packXCorner(ec, nDepth, v));
+    return(packXCorner(ec, nDepth));
   return(false); // Control reaches non-void function warning?
 }
 
 bool Perfect::packXAdjacency(Component* c,
 			     const std::list<ICoords>& l,
-			     Int nDepth, const WastedBins& v) {
+			     Int nDepth) {
   for(std::list<ICoords>::const_iterator i = l.begin();
       i != l.end(); ++i) {
     c->m_nX = i->x;
@@ -245,9 +244,9 @@ bool Perfect::packXAdjacency(Component* c,
     m_pNodes->tick(XF);
     ++m_nAdjacency;
     push();
-    pushAux(c, v);
-    if(m_vWastedX[c->m_nID].canFit(m_Inferences.m_vComponents, m_vPlaced))
-      if(packXAux(nDepth + 1, m_vWastedX[c->m_nID]))
+    pushAux(c);
+    if(m_vWastedX.canFit(m_Inferences.m_vComponents, m_vPlaced))
+      if(packXAux(nDepth + 1))
 	return(true);
     pop();
   }
@@ -388,17 +387,17 @@ SymmetryMap* Perfect::getValues(const EmptyCorner& ec) {
   }
 }
 
-void Perfect::pushAux(Component* c, const WastedBins& v) {
+void Perfect::pushAux(Component* c) {
   
   /**
    * Remove all empty corners that have been filled by this component
    * (carefully putting them into our undo stack).
    */
 
-  m_vWastedX[c->m_nID] = v;
-  m_pGrid->add(c, m_vWastedX[c->m_nID]);
+  m_vWastedX.mark();
+  m_pGrid->add(c, m_vWastedX);
   m_vPlaced[c->m_nID] = true;
-  m_vStack.push_back(Assignment(c));
+  m_vStack.push_back(c);
   m_vVariables.erase(c, m_vStack.back().m_vErased);
 
   /**
@@ -444,6 +443,7 @@ void Perfect::popAux() {
 
   m_vValues.insert(m_vStack.back().m_pComponent);
   m_pGrid->del(m_vStack.back().m_pComponent);
+  m_vWastedX.undo();
   m_vPlaced[m_vStack.back().m_pComponent->m_nID] = false;
   m_vStack.pop_back();
 }
@@ -684,53 +684,53 @@ void Perfect::adjacencySize(UInt& nSize,
 			    std::list<ICoords>& l,
 			    Component*& c) {
   nSize = std::numeric_limits<UInt>::max();
-  Inferences::AdjacencyTraits::edge_iterator ei, ei_end;
-  for(boost::tie(ei, ei_end) = boost::edges(m_Inferences.m_X);
-      ei != ei_end; ++ei) {
-    Component* c1(m_Inferences.m_vComponents[boost::source(*ei, m_Inferences.m_X)]);
-    Component* c2(m_Inferences.m_vComponents[boost::target(*ei, m_Inferences.m_X)]);
-    bool bPlaced1(placed(c1));
-    bool bPlaced2(placed(c2));
-
-    /**
-     * If they're both unplaced, we should simply continue.
-     */
-
-    if(!bPlaced1 && !bPlaced2) continue;
+  const Inferences::Adjacency& g(m_Inferences.m_X);
+  for(UInt n1 = 0; n1 < g.size(); ++n1)
+    for(UInt n2 = g.next(n1, n1); n2 < g.size(); n2 = g.next(n1, n2)) {
+      Component* c1(m_Inferences.m_vComponents[n1]);
+      Component* c2(m_Inferences.m_vComponents[n2]);
+      bool bPlaced1(placed(c1));
+      bool bPlaced2(placed(c2));
+
+      /**
+       * If they're both unplaced, we should simply continue.
+       */
+
+      if(!bPlaced1 && !bPlaced2) continue;
+
+      /**
+       * If they're both placed, and they're not adjacent, then we
+       * should prune so we return a size 0 domain.
+       */
+
+      if(bPlaced1 && bPlaced2) {
+	if(((Int) (c1->m_nX + c1->m_Dims.m_nWidth) == c2->m_nX) ||
+	   ((Int) (c2->m_nX + c2->m_Dims.m_nWidth) == c1->m_nX))
+	  continue;
+	else {
+	  nSize = 0;
+	  return;
+	}
+      }
 
-    /**
-     * If they're both placed, and they're not adjacent, then we
-     * should prune so we return a size 0 domain.
-     */
+      /**
+       * One is placed and the other is unplaced.
+       */
 
-    if(bPlaced1 && bPlaced2) {
-      if(((Int) (c1->m_nX + c1->m_Dims.m_nWidth) == c2->m_nX) ||
-	 ((Int) (c2->m_nX + c2->m_Dims.m_nWidth) == c1->m_nX))
-	continue;
-      else {
+      std::list<ICoords> l2;
+      if(bPlaced1) adjacencySize(l2, c1, c2);
+      else adjacencySize(l2, c2, c1);
+      if(l2.empty()) {
+	l.clear();
 	nSize = 0;
 	return;
       }
+      if(l2.size() < nSize) {
+	nSize = l2.size();
+	l = l2;
+	c = bPlaced1 ? c2 : c1;
+      }
     }
-
-    /**
-     * One is placed and the other is unplaced.
-     */
-
-    std::list<ICoords> l2;
-    if(bPlaced1) adjacencySize(l2, c1, c2);
-    else adjacencySize(l2, c2, c1);
-    if(l2.empty()) {
-      l.clear();
-      nSize = 0;
-      return;
-    }
-    if(l2.size() < nSize) {
-      nSize = l2.size();
-      l = l2;
-      c = bPlaced1 ? c2 : c1;
-    }
-  }
 }
 
 void Perfect::adjacencySize(std::list<ICoords>& ls,
@@ -750,14 +750,13 @@ void Perfect::adjacencySize(std::list<ICoords>& ls,
 }
 
 bool Perfect::placed(Component* c) const {
-  for(std::vector<Assignment>::const_iterator i = m_vStack.begin();
+  for(AssignmentStack::const_iterator i = m_vStack.begin();
       i != m_vStack.end(); ++i)
     if(i->m_pComponent == c) return(true);
   return(false);
 }
 
-bool Perfect::packXCorner(EmptyCorner& ec, Int nDepth,
-			  const WastedBins& v) {
+bool Perfect::packXCorner(EmptyCorner& ec, Int nDepth) {
   SymmetryMap* pValues = getValues(ec);
 
   /**
@@ -765,7 +764,7 @@ bool Perfect::packXCorner(EmptyCorner& ec, Int nDepth,
    * for a value to assign the corner.
    */
 
-  for(SymmetryMap::reverse_iterator k = pValues->rbegin();
+  for(SymmetryMap::const_reverse_iterator k = pValues->rbegin();
       k != pValues->rend(); ++k) {
     if(k->second.empty()) continue;
     Component* c = *(k->second.begin());
@@ -786,14 +785,14 @@ bool Perfect::packXCorner(EmptyCorner& ec, Int nDepth,
      */
 
     push();
-    pushAux(c, v);
+    pushAux(c);
 
     /**
      * Make the recursive call.
      */
 
-    if(m_vWastedX[c->m_nID].canFit(m_Inferences.m_vComponents, m_vPlaced))
-      if(packXAux(nDepth + 1, m_vWastedX[c->m_nID]))
+    if(m_vWastedX.canFit(m_Inferences.m_vComponents, m_vPlaced))
+      if(packXAux(nDepth + 1))
 	return(true);
 
     /**
@@ -805,35 +804,32 @@ bool Perfect::packXCorner(EmptyCorner& ec, Int nDepth,
   return(false);
 }
 
-void Perfect::forceDominationLeft(UInt c1, UInt c2,
-				  const WastedBins& v) {
+void Perfect::forceDominationLeft(UInt c1, UInt c2) {
   push();
   m_Inferences.m_vComponents[c1]->m_nX = 0;
   m_Inferences.m_vComponents[c2]->m_nX = 0;
-  pushAux(m_Inferences.m_vComponents[c1], v);
-  pushAux(m_Inferences.m_vComponents[c2], m_vWastedX[c1]);
+  pushAux(m_Inferences.m_vComponents[c1]);
+  pushAux(m_Inferences.m_vComponents[c2]);
   m_pNodes->tick(XF, 2);
   m_nDepth -= 2;
 }
 
-void Perfect::forceDominationLeft(UInt c,
-				  const WastedBins& v) {
+void Perfect::forceDominationLeft(UInt c) {
   push();
   m_Inferences.m_vComponents[c]->m_nX = 0;
   m_pNodes->tick(XF);
-  pushAux(m_Inferences.m_vComponents[c], v);
+  pushAux(m_Inferences.m_vComponents[c]);
   --m_nDepth;
 }
 
-void Perfect::forceDominationRight(UInt c1, UInt c2,
-				   const WastedBins& v) {
+void Perfect::forceDominationRight(UInt c1, UInt c2) {
   push();
   m_Inferences.m_vComponents[c1]->m_nX =
     m_pBox->m_nWidth - m_Inferences.m_vComponents[c1]->m_Dims.m_nWidth;
   m_Inferences.m_vComponents[c2]->m_nX =
     m_pBox->m_nWidth - m_Inferences.m_vComponents[c2]->m_Dims.m_nWidth;
-  pushAux(m_Inferences.m_vComponents[c1], v);
-  pushAux(m_Inferences.m_vComponents[c2], m_vWastedX[c1]);
+  pushAux(m_Inferences.m_vComponents[c1]);
+  pushAux(m_Inferences.m_vComponents[c2]);
   m_pNodes->tick(XF, 2);
   m_nDepth -= 2;
 }
@@ -846,7 +842,7 @@ void Perfect::print() const {
 
   std::cout << "Assignment Stack:" << std::endl;
   UInt nMax(0), nStart(0);
-  for(std::vector<Assignment>::const_iterator i = m_vStack.begin();
+  for(AssignmentStack::const_iterator i = m_vStack.begin();
       i != m_vStack.end(); ++i) {
     std::ostringstream oss;
     Printer::print(i->m_vErased, oss);
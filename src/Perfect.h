@@ -20,7 +20,7 @@
 #ifndef PERFECT_H
 #define PERFECT_H
 
-#include "Assignment.h"
+#include "AssignmentStack.h"
 #include "BinomialCache.h"
 #include "Bins.h"
 #include "CornerValues.h"
@@ -31,6 +31,7 @@
 #include "NodeCount.h"
 #include "SymmetryMap.h"
 #include "WastedBins.h"
+#include <boost/atomic.hpp>
 #include <string>
 #include <vector>
 
@@ -56,15 +57,16 @@ class Perfect {
   Perfect();
   ~Perfect();
   void initialize(UInt* pCuSP, BoxDimensions* pBox,
-		  TimeSpec* pTime, Grid* pGrid, NodeCount* pNodes);
+		  TimeSpec* pTime, Grid* pGrid, NodeCount* pNodes,
+		  const boost::atomic<bool>* pCancel);
   void initialize(const std::string& sParams);
 
   bool packX(Bins* pBins, RectPtrArray::iterator iBegin,
 	     const RectPtrArray::const_iterator& iEnd);
-  bool packXAux(Int nDepth, const WastedBins& v);
-  bool packXCorner(EmptyCorner& ec, Int nDepth, const WastedBins& v);
+  bool packXAux(Int nDepth);
+  bool packXCorner(EmptyCorner& ec, Int nDepth);
   bool packXAdjacency(Component* c, const std::list<ICoords>& l,
-		      Int nDepth, const WastedBins& v);
+		      Int nDepth);
   void initWastedSpace();
 
   void smallestDomain2(UInt& nSmallest, EmptyCorner& c);
@@ -94,13 +96,13 @@ class Perfect {
   SymmetryMap* getValues(const EmptyCorner& ec);
   void push();
   void pop();
-  void pushAux(Component* c, const WastedBins& v);
+  void pushAux(Component* c);
   void popAux();
   bool insideBox(const Dimensions& d, const EmptyCorner& c) const;
   bool insideBox(const Dimensions& d, const ICoords& c) const;
-  void forceDominationLeft(UInt c1, UInt c2, const WastedBins& v);
-  void forceDominationLeft(UInt c, const WastedBins& v);
-  void forceDominationRight(UInt c1, UInt c2, const WastedBins& v);
+  void forceDominationLeft(UInt c1, UInt c2);
+  void forceDominationLeft(UInt c);
+  void forceDominationRight(UInt c1, UInt c2);
   bool placed(Component* c) const;
 
   /**
@@ -119,20 +121,25 @@ class Perfect {
   TimeSpec* m_pTime;
   Grid* m_pGrid;
   NodeCount* m_pNodes;
+  const boost::atomic<bool>* m_pCancel;
 
   /**
-   * 2D wasted space data structures.
+   * 2D wasted space data structures. The first is the histogram of
+   * the empty box, and the second is the working copy which every
+   * placement updates in place. Each placement first calls mark() to
+   * push a snapshot of the copy, and backtracking calls undo() to pop
+   * it back.
    */
 
   WastedBins m_vWastedXF;
-  std::vector<WastedBins> m_vWastedX;
+  WastedBins m_vWastedX;
 
   /**
    * Variables internal for our search.
    */
 
   std::vector<UInt> m_vStackSize;
-  std::vector<Assignment> m_vStack;
+  AssignmentStack m_vStack;
   int m_nDepth;
   Inferences m_Inferences;
   CornerValues m_vValues;
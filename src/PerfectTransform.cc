@@ -48,7 +48,7 @@ void PerfectTransform::initialize(const Cumulative& c) {
   for(std::vector<CompulsoryAssign>::const_iterator i =
 	c.values().begin(); i != c.values().end(); ++i) {
     const Rectangle* r = i->m_nValue.m_pRect;
-    Component* pc = new Component();
+    Component* pc = m_vComponents.allocate();
     pc->m_nID = r->m_nID;
     pc->m_Dims.initialize(r->m_nWidth, r->m_nHeight);
     pc->m_nX = i->m_nValue.left();
@@ -93,7 +93,7 @@ void PerfectTransform::initialize(const Cumulative& c) {
       if(lUnits.back().second.m_nWidth && lUnits.back().second.m_nHeight)
 	for(UInt w = 0; w < lUnits.back().second.m_nWidth; ++w)
 	  for(UInt h = 0; h < lUnits.back().second.m_nHeight; ++h) {
-	    Component* pc = new Component();
+	    Component* pc = m_vComponents.allocate();
 	    pc->m_nID = m_vComponents.size();
 	    pc->m_Dims = m_nUnit;
 	    pc->m_bEmpty = true;
@@ -126,7 +126,7 @@ void PerfectTransform::initialize(const Cumulative& c,
   for(std::vector<CompulsoryAssign>::const_iterator i =
 	c.values().begin(); i != c.values().end(); ++i) {
     const Rectangle* r = i->m_nValue.m_pRect;
-    Component* pc = new Component();
+    Component* pc = m_vComponents.allocate();
     pc->m_nID = r->m_nID;
     pc->m_Dims.initialize(r->m_nWidth, r->m_nHeight);
     pc->m_nX = i->m_nValue.left();
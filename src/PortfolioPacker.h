@@ -0,0 +1,108 @@
+/**
+ * Copyright (C) 2011 Eric Huang
+ *
+ * This file is part of rectpack.
+ *
+ * rectpack is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * rectpack is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with rectpack. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PORTFOLIOPACKER_H
+#define PORTFOLIOPACKER_H
+
+#include "Integer.h"
+#include "Packer.h"
+#include <boost/atomic.hpp>
+#include <boost/thread.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <vector>
+
+class BoundingBoxes;
+class HeapBox;
+class Parameters;
+class Placements;
+
+/**
+ * Races several packers of different types on the same bounding
+ * box. Each worker is a complete serial packer selected by one entry
+ * of the portfolio (see Parameters::m_vPortfolio), with its own copy
+ * of the parameters, and they all run on a pool of threads that
+ * persists across bounding boxes. The first worker to decide the box,
+ * either by finding a packing or by exhausting its search, wins and
+ * the others are cancelled.
+ *
+ * Node counts and CPU times are the sums over all workers, since all
+ * of that effort went into the attempt. The number of boxes each
+ * worker has won is kept over the lifetime of the packer.
+ */
+
+class PortfolioPacker : public Packer {
+ public:
+  PortfolioPacker(const Parameters* pParams);
+  virtual ~PortfolioPacker();
+  virtual void initialize(const Parameters* pParams);
+  virtual void initialize(const BoundingBoxes* pBoxes);
+  virtual void initialize(const HeapBox* pBox);
+  virtual bool pack(const HeapBox& hb);
+  virtual void get(Placements& v) const;
+  virtual void placeUnitRectangles();
+  virtual TimeSpec& timeDomination();
+  virtual void wastedSpace(UInt& nYTests, UInt& nYPrunes,
+			   UInt& nXTests, UInt& nXPrunes) const;
+  virtual int weakening() const;
+  virtual void wins(std::vector<UInt>& v) const;
+
+ protected:
+  virtual bool pack();
+
+ private:
+
+  /**
+   * Copies the parameters for the ith worker, which runs the packer
+   * of the given type on its own. Snapshots are left out, since a
+   * worker that is cancelled because another one won would save its
+   * search of a box that has already been decided.
+   */
+
+  void assign(size_t i, const Parameters* pParams, int nWeakening);
+
+  /**
+   * Main loop of a pool thread, which packs the current box with the
+   * given worker every time a new generation is started.
+   */
+
+  void work(size_t i);
+  void cancelWorkers();
+
+  std::vector<Parameters*> m_vParams;
+  std::vector<Packer*> m_vWorkers;
+  std::vector<UInt> m_vWins;
+  boost::thread_group m_Threads;
+  boost::mutex m_Mutex;
+  boost::condition_variable m_Start;
+  boost::condition_variable m_Done;
+  const HeapBox* m_pHeapBox;
+  UInt m_nGeneration;
+  UInt m_nRunning;
+  bool m_bShutdown;
+
+  /**
+   * Index of the worker that decided the box, or -1, and its result.
+   */
+
+  boost::atomic<int> m_nWinner;
+  bool m_bResult;
+};
+
+#endif // PORTFOLIOPACKER_H
@@ -22,6 +22,7 @@
 #include "HeapBox.h"
 #include "Parameters.h"
 #include "PrecomputedSums.h"
+#include "Probes.h"
 #include "SpaceFill.h"
 
 PrecomputedSums::PrecomputedSums() :
@@ -90,9 +91,13 @@ bool PrecomputedSums::packInterval(RectPtrArray::iterator i) {
 
 bool PrecomputedSums::packSingle(const Compulsory* c,
 				 RectPtrArray::iterator i) {
-  SubsetSums::const_iterator j(m_pWidths->lower_bound(c->m_nStart.m_nLeft));
-  SubsetSums::const_iterator k(m_pWidths->lower_bound(c->m_nStart.m_nRight));
-  if(k != m_pWidths->end() && k->first == c->m_nStart.m_nRight) ++k;
+  SubsetSums::const_iterator j, k;
+  {
+    PROBE(PROBE_SUBSETSUMS);
+    j = m_pWidths->lower_bound(c->m_nStart.m_nLeft);
+    k = m_pWidths->lower_bound(c->m_nStart.m_nRight);
+    if(k != m_pWidths->end() && k->first == c->m_nStart.m_nRight) ++k;
+  }
   for(; j != k; ++j) {
     
     /**
@@ -127,7 +132,7 @@ bool PrecomputedSums::orientation(RectPtrArray::iterator i) {
 }
 
 bool PrecomputedSums::nextVariable(RectPtrArray::iterator i) {
-  if(bQuit) return(false);
+  if(cancelled()) return(false);
 
   /**
    * In the base case we're at the end of our packing sequence.
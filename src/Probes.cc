@@ -0,0 +1,76 @@
+/**
+ * Copyright (C) 2011 Eric Huang
+ *
+ * This file is part of rectpack.
+ *
+ * rectpack is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * rectpack is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with rectpack. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Probes.h"
+#include <iomanip>
+#include <iostream>
+#include <string.h>
+
+__thread Probes* Probes::s_pCurrent = NULL;
+
+Probes::Probes() {
+  clear();
+}
+
+Probes::~Probes() {
+}
+
+void Probes::clear() {
+  memset(m_vCounters, 0, sizeof(m_vCounters));
+}
+
+void Probes::accumulate(const Probes& src) {
+  for(int i = 0; i < PROBETYPES; ++i) {
+    m_vCounters[i].m_nCalls += src.m_vCounters[i].m_nCalls;
+    m_vCounters[i].m_nCycles += src.m_vCounters[i].m_nCycles;
+  }
+}
+
+void Probes::bind(Probes* pProbes) {
+  s_pCurrent = pProbes;
+}
+
+void Probes::print() const {
+  static const char* pNames[PROBETYPES] = {
+    "compress",
+    "inferences",
+    "propagate",
+    "domination",
+    "wasted space",
+    "subset sums"
+  };
+  std::cout << "  " << std::left << std::setw(14) << "Probe"
+	    << std::right << std::setw(14) << "Calls";
+#ifdef PROBETIMERS
+  std::cout << std::setw(16) << "Cycles" << std::setw(12) << "Cycles/Call";
+#endif // PROBETIMERS
+  std::cout << std::endl;
+  for(int i = 0; i < PROBETYPES; ++i) {
+    const Counter& c = m_vCounters[i];
+    if(c.m_nCalls == 0) continue;
+    std::cout << "  " << std::left << std::setw(14) << pNames[i]
+	      << std::right << std::setw(14) << c.m_nCalls;
+#ifdef PROBETIMERS
+    std::cout << std::setw(16) << c.m_nCycles
+	      << std::setw(12) << c.m_nCycles / c.m_nCalls;
+#endif // PROBETIMERS
+    std::cout << std::endl;
+  }
+  std::cout << std::endl;
+}
@@ -0,0 +1,144 @@
+/**
+ * Copyright (C) 2011 Eric Huang
+ *
+ * This file is part of rectpack.
+ *
+ * rectpack is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * rectpack is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with rectpack. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PROBES_H
+#define PROBES_H
+
+#include "Integer.h"
+
+/**
+ * Hot-path instrumentation. Building with DEFINES=-DPROBES counts the
+ * calls made to a handful of key functions during each packing
+ * attempt, and adding -DPROBETIMERS also accumulates the time stamp
+ * counter cycles spent inside them. Without PROBES, the PROBE macro
+ * expands to nothing and none of this costs anything.
+ *
+ * Each packer owns a table of counters, and Packer::pack binds it to
+ * the calling thread for the duration of the attempt. The probes find
+ * the table through a thread-local pointer, so they need neither
+ * atomics nor locks, and calls made outside of a packing attempt (for
+ * instance while building the domination tables) aren't counted.
+ */
+
+enum ProbeType {
+  PROBE_COMPRESS,
+  PROBE_INFERENCES,
+  PROBE_PROPAGATE,
+  PROBE_DOMINATION,
+  PROBE_WASTEDSPACE,
+  PROBE_SUBSETSUMS,
+  PROBETYPES
+};
+
+class Probes {
+ public:
+  Probes();
+  ~Probes();
+  void clear();
+  void accumulate(const Probes& src);
+
+  /**
+   * Prints one row per probe that was hit.
+   */
+
+  void print() const;
+
+  /**
+   * Sets the table that the probes of the calling thread update, or
+   * NULL to stop counting.
+   */
+
+  static void bind(Probes* pProbes);
+  static Probes* current() { return(s_pCurrent); }
+
+  /**
+   * Each counter occupies its own cache line so that the tables of
+   * packers running on different threads never share one.
+   */
+
+  struct Counter {
+    UInt m_nCalls;
+    UInt m_nCycles;
+    char m_pPad[64 - 2 * sizeof(UInt)];
+  };
+
+ private:
+  char m_pPad[64];
+
+ public:
+  Counter m_vCounters[PROBETYPES];
+
+ private:
+  static __thread Probes* s_pCurrent;
+};
+
+#ifdef PROBES
+
+#ifdef PROBETIMERS
+#include <x86intrin.h>
+#endif // PROBETIMERS
+
+/**
+ * Counts one call to the enclosing scope and, with PROBETIMERS, the
+ * cycles until the scope is left.
+ */
+
+class Probe {
+ public:
+  Probe(ProbeType n) :
+    m_pCounter(NULL)
+#ifdef PROBETIMERS
+    , m_nStart(0)
+#endif // PROBETIMERS
+  {
+    Probes* p = Probes::current();
+    if(p) {
+      m_pCounter = &p->m_vCounters[n];
+      ++m_pCounter->m_nCalls;
+#ifdef PROBETIMERS
+      m_nStart = __rdtsc();
+#endif // PROBETIMERS
+    }
+  }
+
+  ~Probe() {
+#ifdef PROBETIMERS
+    if(m_pCounter)
+      m_pCounter->m_nCycles += __rdtsc() - m_nStart;
+#endif // PROBETIMERS
+  }
+
+ private:
+  Probes::Counter* m_pCounter;
+#ifdef PROBETIMERS
+  UInt m_nStart;
+#endif // PROBETIMERS
+};
+
+#define PROBENAME2(n) probe##n
+#define PROBENAME(n) PROBENAME2(n)
+#define PROBE(t) Probe PROBENAME(__LINE__)(t)
+
+#else // PROBES
+
+#define PROBE(t)
+
+#endif // PROBES
+
+#endif // PROBES_H
@@ -68,7 +68,24 @@ void RatPack::initialize(const BoundingBoxes* pBoxes) {
 }
 
 bool RatPack::pack() {
-  return(packX());
+
+  /**
+   * The profile and its undo trail only allocate while the search
+   * reaches deeper than it did before, so in verbose mode we report
+   * how much they grew per node of this box.
+   */
+
+  size_t nCapacity(m_vX.capacity());
+  bool bResult(packX());
+  if(m_pParams->m_bVerbose) {
+    size_t nBytes(m_vX.capacity() - nCapacity);
+    UInt nNodes(m_Nodes.get(XI) + m_Nodes.get(XF));
+    std::cout << "  Cumulative allocated " << nBytes << " bytes over "
+	      << nNodes << " nodes ("
+	      << (nNodes ? (double) nBytes / nNodes : 0.0)
+	      << " bytes/node)." << std::endl;
+  }
+  return(bResult);
 }
 
 bool RatPack::packX() {
@@ -17,23 +17,31 @@
  * along with rectpack. If not, see <http://www.gnu.org/licenses/>.
  */
 
-#ifndef SINGLESTACK_H
-#define SINGLESTACK_H
+#include "RectColumns.h"
+#include "RectPtrArray.h"
 
-#include <deque>
-#include <cstddef>
+RectColumns::RectColumns() {
+}
 
-class CompulsoryAssign;
+RectColumns::~RectColumns() {
+}
 
-class SingleStack : public std::deque<CompulsoryAssign*> {
- public:
-  SingleStack();
-  ~SingleStack();
-  void push();
-  void push(CompulsoryAssign* p);
-  void pop();
+void RectColumns::initialize(const RectPtrArray& v) {
+  m_vWidth.resize(v.size());
+  m_vHeight.resize(v.size());
+  m_vMinDim.resize(v.size());
+  m_vArea.resize(v.size());
+  m_vRotatable.resize(v.size());
+  m_vRects.resize(v.size());
+  for(RectPtrArray::const_iterator i = v.begin(); i != v.end(); ++i)
+    update(*i);
+}
 
-  std::deque<size_t> m_vSize;
-};
-
-#endif // SINGLESTACK_H
+void RectColumns::clear() {
+  m_vWidth.clear();
+  m_vHeight.clear();
+  m_vMinDim.clear();
+  m_vArea.clear();
+  m_vRotatable.clear();
+  m_vRects.clear();
+}
@@ -0,0 +1,67 @@
+/**
+ * Copyright (C) 2011 Eric Huang
+ *
+ * This file is part of rectpack.
+ *
+ * rectpack is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * rectpack is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with rectpack. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RECTCOLUMNS_H
+#define RECTCOLUMNS_H
+
+#include "Integer.h"
+#include "Rectangle.h"
+#include <vector>
+
+class RectPtrArray;
+
+/**
+ * A structure-of-arrays copy of the Rectangle fields that the inner
+ * loops of the y-dimension search read, indexed by rectangle ID. The
+ * Rectangle objects stay canonical. The bins refresh a row with
+ * update() whenever they place a rectangle, and a placed rectangle
+ * keeps its orientation until it is removed again, so the loops over
+ * placed rectangles can stream these arrays instead of dereferencing
+ * each Rectangle.
+ */
+
+class RectColumns {
+ public:
+  RectColumns();
+  ~RectColumns();
+  void initialize(const RectPtrArray& v);
+  void clear();
+
+  void update(const Rectangle* r) {
+    m_vWidth[r->m_nID] = r->m_nWidth;
+    m_vHeight[r->m_nID] = r->m_nHeight;
+    m_vMinDim[r->m_nID] = r->m_nMinDim;
+    m_vArea[r->m_nID] = r->m_nArea;
+    m_vRotatable[r->m_nID] = r->m_bRotatable;
+    m_vRects[r->m_nID] = r;
+  }
+
+  size_t size() const {
+    return(m_vRects.size());
+  }
+
+  std::vector<UInt> m_vWidth;
+  std::vector<UInt> m_vHeight;
+  std::vector<UInt> m_vMinDim;
+  std::vector<UInt> m_vArea;
+  std::vector<char> m_vRotatable;
+  std::vector<const Rectangle*> m_vRects;
+};
+
+#endif // RECTCOLUMNS_H
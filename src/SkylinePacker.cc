@@ -0,0 +1,96 @@
+/**
+ * Copyright (C) 2011 Eric Huang
+ *
+ * This file is part of rectpack.
+ *
+ * rectpack is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * rectpack is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with rectpack. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SkylinePacker.h"
+#include <algorithm>
+
+SkylinePacker::SkylinePacker() {
+}
+
+SkylinePacker::~SkylinePacker() {
+}
+
+const char* SkylinePacker::name() const {
+  return("skyline");
+}
+
+void SkylinePacker::pack(UInt nWidth, std::vector<StripItem>& v) {
+  m_vSkyline.assign(1, std::pair<UInt, UInt>(0, 0));
+  for(std::vector<StripItem>::iterator i = v.begin(); i != v.end(); ++i) {
+    bool bFound(false), bRotated(false);
+    UInt nX(0), nY(0), nTop(0);
+    for(int r = 0; r < (i->m_bRotatable ? 2 : 1); ++r) {
+      i->m_bRotated = (r == 1);
+      UInt w = i->width(), h = i->height();
+      if(w > nWidth) continue;
+      for(size_t s = 0; s < m_vSkyline.size(); ++s) {
+	UInt x = m_vSkyline[s].first;
+	if(x + w > nWidth) break;
+	UInt y(0);
+	for(size_t t = s; t < m_vSkyline.size() &&
+	      m_vSkyline[t].first < x + w; ++t)
+	  y = std::max(y, m_vSkyline[t].second);
+	if(!bFound || y + h < nTop || (y + h == nTop && x < nX)) {
+	  bFound = true;
+	  bRotated = i->m_bRotated;
+	  nX = x;
+	  nY = y;
+	  nTop = y + h;
+	}
+      }
+    }
+    i->m_bRotated = bRotated;
+    i->m_nX = nX;
+    i->m_nY = nY;
+    add(nWidth, nX, i->width(), nTop);
+  }
+}
+
+void SkylinePacker::add(UInt nWidth, UInt x, UInt w, UInt nTop) {
+
+  /**
+   * Segments starting left of the item survive, then comes the item's
+   * top edge, then whatever part of the contour sticks out to its
+   * right.
+   */
+
+  m_vScratch.clear();
+  UInt nEnd = x + w, nBelow(0);
+  for(size_t s = 0; s < m_vSkyline.size(); ++s) {
+    if(m_vSkyline[s].first < x)
+      m_vScratch.push_back(m_vSkyline[s]);
+    if(m_vSkyline[s].first <= nEnd)
+      nBelow = m_vSkyline[s].second;
+  }
+  m_vScratch.push_back(std::pair<UInt, UInt>(x, nTop));
+  if(nEnd < nWidth)
+    m_vScratch.push_back(std::pair<UInt, UInt>(nEnd, nBelow));
+  for(size_t s = 0; s < m_vSkyline.size(); ++s)
+    if(m_vSkyline[s].first > nEnd)
+      m_vScratch.push_back(m_vSkyline[s]);
+
+  /**
+   * Merge neighbouring segments of the same height.
+   */
+
+  m_vSkyline.clear();
+  for(size_t s = 0; s < m_vScratch.size(); ++s)
+    if(m_vSkyline.empty() || m_vSkyline.back().second != m_vScratch[s].second)
+      m_vSkyline.push_back(m_vScratch[s]);
+}
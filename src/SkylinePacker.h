@@ -0,0 +1,53 @@
+/**
+ * Copyright (C) 2011 Eric Huang
+ *
+ * This file is part of rectpack.
+ *
+ * rectpack is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * rectpack is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with rectpack. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SKYLINEPACKER_H
+#define SKYLINEPACKER_H
+
+#include "StripPacker.h"
+#include <utility>
+
+/**
+ * Keeps only the upper contour of the packing, as a sequence of
+ * horizontal segments, and rests each item on the contour where its
+ * top edge ends up lowest, preferring the leftmost such position.
+ * The space under an overhang is never reused, in exchange for a
+ * placement cost linear in the number of segments.
+ */
+
+class SkylinePacker : public StripPacker {
+ public:
+  SkylinePacker();
+  virtual ~SkylinePacker();
+  virtual const char* name() const;
+  virtual void pack(UInt nWidth, std::vector<StripItem>& v);
+
+ private:
+  void add(UInt nWidth, UInt x, UInt w, UInt nTop);
+
+  /**
+   * The (x, y) starting point of each segment. A segment extends to
+   * the start of the next one, or to the edge of the strip.
+   */
+
+  std::vector<std::pair<UInt, UInt> > m_vSkyline;
+  std::vector<std::pair<UInt, UInt> > m_vScratch;
+};
+
+#endif // SKYLINEPACKER_H
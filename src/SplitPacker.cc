@@ -0,0 +1,198 @@
+/**
+ * Copyright (C) 2011 Eric Huang
+ *
+ * This file is part of rectpack.
+ *
+ * rectpack is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * rectpack is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with rectpack. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BoundingBoxes.h"
+#include "HeapBox.h"
+#include "IntPack.h"
+#include "Parameters.h"
+#include "Placements.h"
+#include "SplitPacker.h"
+#include <boost/bind.hpp>
+
+SplitPacker::SplitPacker(const Parameters* pParams) :
+  m_pHeapBox(NULL),
+  m_nGeneration(0),
+  m_nRunning(0),
+  m_bShutdown(false),
+  m_nWinner(-1) {
+  for(int i = 0; i < pParams->m_nSplit; ++i) {
+    IntPack* p = static_cast<IntPack*>(Packer::createSerial(pParams));
+    p->m_nSplit = pParams->m_nSplit;
+    p->m_nSplitIndex = i;
+    p->m_nSplitDepth = pParams->m_nSplitDepth;
+    m_vWorkers.push_back(p);
+  }
+  m_bYSmallerThanX = m_vWorkers.front()->m_bYSmallerThanX;
+  m_bCanBuildDomination = m_vWorkers.front()->m_bCanBuildDomination;
+}
+
+SplitPacker::~SplitPacker() {
+  {
+    boost::unique_lock<boost::mutex> lock(m_Mutex);
+    m_bShutdown = true;
+  }
+  m_Start.notify_all();
+  m_Threads.join_all();
+  for(std::vector<IntPack*>::iterator i = m_vWorkers.begin();
+      i != m_vWorkers.end(); ++i)
+    delete *i;
+}
+
+void SplitPacker::initialize(const Parameters* pParams) {
+  Packer::initialize(pParams);
+  for(std::vector<IntPack*>::iterator i = m_vWorkers.begin();
+      i != m_vWorkers.end(); ++i)
+    (*i)->initialize(pParams);
+}
+
+void SplitPacker::initialize(const BoundingBoxes* pBoxes) {
+  Packer::initialize(pBoxes);
+  for(std::vector<IntPack*>::iterator i = m_vWorkers.begin();
+      i != m_vWorkers.end(); ++i)
+    (*i)->initialize(pBoxes);
+}
+
+void SplitPacker::initialize(const HeapBox* pBox) {
+
+  /**
+   * The workers initialize themselves for the box in their own
+   * threads. We only keep track of the box dimensions here.
+   */
+
+  Packer::initialize(pBox);
+}
+
+bool SplitPacker::pack(const HeapBox& hb) {
+  initAccumulators();
+  initialize(&hb);
+  m_bInitialized = true;
+
+  /**
+   * Start the pool lazily, so that packers which are created but
+   * never used don't cost us any threads.
+   */
+
+  if(m_Threads.size() == 0)
+    for(size_t i = 0; i < m_vWorkers.size(); ++i)
+      m_Threads.create_thread(boost::bind(&SplitPacker::work, this, i));
+
+  /**
+   * Hand the box to all of the workers and wait for them to
+   * finish. We wake up periodically to forward any cancellation of
+   * this attempt to the workers.
+   */
+
+  m_nWinner = -1;
+  for(std::vector<IntPack*>::iterator i = m_vWorkers.begin();
+      i != m_vWorkers.end(); ++i)
+    (*i)->m_bCancel = false;
+  {
+    boost::unique_lock<boost::mutex> lock(m_Mutex);
+    m_pHeapBox = &hb;
+    m_nRunning = m_vWorkers.size();
+    ++m_nGeneration;
+  }
+  m_Start.notify_all();
+  {
+    boost::unique_lock<boost::mutex> lock(m_Mutex);
+    while(m_nRunning > 0) {
+      m_Done.timed_wait(lock, boost::posix_time::milliseconds(1));
+      if(cancelled())
+	cancelWorkers();
+    }
+  }
+
+  /**
+   * Merge the statistics of all of the workers.
+   */
+
+  for(std::vector<IntPack*>::iterator i = m_vWorkers.begin();
+      i != m_vWorkers.end(); ++i) {
+    m_Nodes.accumulate((*i)->m_Nodes);
+    m_Time += (*i)->m_Time;
+    m_XTime += (*i)->m_XTime;
+    m_YTime += (*i)->m_YTime;
+    m_nCuSP += (*i)->m_nCuSP;
+    m_Probes.accumulate((*i)->m_Probes);
+  }
+  int nWinner = m_nWinner;
+  const IntPack* p = m_vWorkers[nWinner < 0 ? 0 : nWinner];
+  m_Box = p->m_Box;
+  m_bInstanceRotated = p->m_bInstanceRotated;
+  m_nDeepestConflict = p->m_nDeepestConflict;
+  return(nWinner >= 0);
+}
+
+bool SplitPacker::pack() {
+  return(false);
+}
+
+void SplitPacker::work(size_t i) {
+  UInt nGeneration(0);
+  while(true) {
+    const HeapBox* pBox(NULL);
+    {
+      boost::unique_lock<boost::mutex> lock(m_Mutex);
+      while(nGeneration == m_nGeneration && !m_bShutdown)
+	m_Start.wait(lock);
+      if(m_bShutdown) return;
+      nGeneration = m_nGeneration;
+      pBox = m_pHeapBox;
+    }
+    if(m_vWorkers[i]->pack(*pBox)) {
+      int nNone(-1);
+      if(m_nWinner.compare_exchange_strong(nNone, (int) i))
+	cancelWorkers();
+    }
+    {
+      boost::unique_lock<boost::mutex> lock(m_Mutex);
+      if(--m_nRunning == 0)
+	m_Done.notify_all();
+    }
+  }
+}
+
+void SplitPacker::cancelWorkers() {
+  for(std::vector<IntPack*>::iterator i = m_vWorkers.begin();
+      i != m_vWorkers.end(); ++i)
+    (*i)->m_bCancel = true;
+}
+
+void SplitPacker::get(Placements& v) const {
+  int nWinner = m_nWinner;
+  m_vWorkers[nWinner < 0 ? 0 : nWinner]->get(v);
+}
+
+void SplitPacker::placeUnitRectangles() {
+
+  /**
+   * The winning worker has already placed its unit rectangles.
+   */
+}
+
+TimeSpec& SplitPacker::timeDomination() {
+  return(m_vWorkers.front()->timeDomination());
+}
+
+void SplitPacker::wastedSpace(UInt& nYTests, UInt& nYPrunes,
+			      UInt& nXTests, UInt& nXPrunes) const {
+  for(std::vector<IntPack*>::const_iterator i = m_vWorkers.begin();
+      i != m_vWorkers.end(); ++i)
+    (*i)->wastedSpace(nYTests, nYPrunes, nXTests, nXPrunes);
+}
@@ -0,0 +1,94 @@
+/**
+ * Copyright (C) 2011 Eric Huang
+ *
+ * This file is part of rectpack.
+ *
+ * rectpack is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * rectpack is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with rectpack. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SPLITPACKER_H
+#define SPLITPACKER_H
+
+#include "Integer.h"
+#include "Packer.h"
+#include <boost/atomic.hpp>
+#include <boost/thread.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <vector>
+
+class BoundingBoxes;
+class HeapBox;
+class IntPack;
+class Parameters;
+class Placements;
+
+/**
+ * Divides a single bounding box among several integer packers. Each
+ * worker is a complete packer of the requested type with its own
+ * bins, wasted space tables and domination tables, and each one
+ * explores only its share of the subtrees at a fixed depth of the
+ * first-dimension search (see IntPack::claim). The workers run on a
+ * pool of threads that persists across bounding boxes. As soon as
+ * one worker finds a packing the others are cancelled.
+ *
+ * Node counts and CPU times are the sums over all workers, so the
+ * nodes above the split depth are counted once per worker.
+ */
+
+class SplitPacker : public Packer {
+ public:
+  SplitPacker(const Parameters* pParams);
+  virtual ~SplitPacker();
+  virtual void initialize(const Parameters* pParams);
+  virtual void initialize(const BoundingBoxes* pBoxes);
+  virtual void initialize(const HeapBox* pBox);
+  virtual bool pack(const HeapBox& hb);
+  virtual void get(Placements& v) const;
+  virtual void placeUnitRectangles();
+  virtual TimeSpec& timeDomination();
+  virtual void wastedSpace(UInt& nYTests, UInt& nYPrunes,
+			   UInt& nXTests, UInt& nXPrunes) const;
+
+ protected:
+  virtual bool pack();
+
+ private:
+
+  /**
+   * Main loop of a pool thread, which packs the current box with the
+   * given worker every time a new generation is started.
+   */
+
+  void work(size_t i);
+  void cancelWorkers();
+
+  std::vector<IntPack*> m_vWorkers;
+  boost::thread_group m_Threads;
+  boost::mutex m_Mutex;
+  boost::condition_variable m_Start;
+  boost::condition_variable m_Done;
+  const HeapBox* m_pHeapBox;
+  UInt m_nGeneration;
+  UInt m_nRunning;
+  bool m_bShutdown;
+
+  /**
+   * Index of the worker that found a packing, or -1.
+   */
+
+  boost::atomic<int> m_nWinner;
+};
+
+#endif // SPLITPACKER_H
@@ -17,6 +17,7 @@
  * along with rectpack. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include "Probes.h"
 #include "SquareDom.h"
 #include "Rectangle.h"
 
@@ -149,6 +150,7 @@ SquareDom::~SquareDom() {
 }
 
 bool SquareDom::_dominated(const Rectangle* r, UInt nGap) const {
+  PROBE(PROBE_DOMINATION);
   if(nGap < MAXGAP && r->m_nWidth < MAXSIZE)
     return(m_pSquare[r->m_nWidth][nGap] == 1);
   return(false);
@@ -45,49 +45,47 @@ SquarePacker::~SquarePacker() {
 
 void SquarePacker::initialize(const Parameters* pParams) {
   IntPack::initialize(pParams);
-  m_vWastedXF.resize(m_vRects.size());
-  for(std::vector<WastedBins>::iterator i = m_vWastedXF.begin();
-      i != m_vWastedXF.end(); ++i)
-    i->initialize(pParams);
+  m_vWastedXF.initialize(pParams);
   if(pParams->m_s1.find_first_of('d') < pParams->m_s1.size())
     m_bTooCloseEnable = false;
 }
 
 bool SquarePacker::pack() {
   Rectangle* r(m_vRectPtrs.front());
-  WastedBins v(std::min(m_Box.m_nWidth, m_Box.m_nHeight) + 1, 0);
-  v[std::min(m_Box.m_nWidth, m_Box.m_nHeight)] = m_Box.m_nArea;
+  m_vWastedXF.assign(std::min(m_Box.m_nWidth, m_Box.m_nHeight) + 1, 0);
+  m_vWastedXF.back() = m_Box.m_nArea;
+  m_vWastedXF.clearTrail();
   if(!m_pParams->m_vInstance.m_bSortedDecreasingMinDim) {
     initRMinDims();
     m_sRMinDims.erase(r);
   }
 
   if(m_Box.canFit(r) &&
-     packFirst(m_vRectPtrs.begin(), m_vRectPtrs.end(), v))
+     packFirst(m_vRectPtrs.begin(), m_vRectPtrs.end()))
     return(true);
   if(r->rotatable()) {
     r->rotate();
     if(m_Box.canFit(r) &&
-       packFirst(m_vRectPtrs.begin(), m_vRectPtrs.end(), v))
+       packFirst(m_vRectPtrs.begin(), m_vRectPtrs.end()))
       return(true);
   }
   return(false);
 }
 
 bool SquarePacker::packFirst(RectPtrArray::iterator iCurrent,
-			     RectPtrArray::const_iterator iEnd,
-			     const WastedBins& v) {
+			     RectPtrArray::const_iterator iEnd) {
   Rectangle* r(*iCurrent);
   if(r->fixed()) {
     r->x = r->m_nFixX;
     r->y = r->m_nFixY;
-    m_vWastedXF[r->m_nID] = v;
-    m_pGrid->add(r, m_vWastedXF[r->m_nID]);
+    m_vWastedXF.mark();
+    m_pGrid->add(r, m_vWastedXF);
     m_Nodes.tick(XF);
     if(m_vRectPtrs.size() == 1 ||
-       packAux(iCurrent + 1, iEnd, m_vWastedXF[r->m_nID]))
+       packAux(iCurrent + 1, iEnd))
       return(true);
     m_pGrid->del(r);
+    m_vWastedXF.undo();
   }
   else {
     UInt xdist = (m_Box.m_nWidth - r->m_nWidth) / 2;   /* x distance is floor(x/2-n/2) */
@@ -96,17 +94,18 @@ bool SquarePacker::packFirst(RectPtrArray::iterator iCurrent,
       if(m_pDomination->dominatedh(r, r->x)) continue;        /* too close to left edge */
       for(r->y = 0; r->y <= ydist; r->y++) {           /* each row of upper-left quadrant */
 	if(m_pDomination->dominatedw(r, r->y)) continue;   /* not too close to top edge */
-	m_vWastedXF[r->m_nID] = v;
-	m_pGrid->add(r, m_vWastedXF[r->m_nID]);
+	m_vWastedXF.mark();
+	m_pGrid->add(r, m_vWastedXF);
 	m_Nodes.tick(XF);
 	if((m_pParams->m_vInstance.m_bSortedDecreasingMinDim &&
-	    m_vWastedXF[r->m_nID].canFitm(iCurrent + 1, iEnd)) ||
+	    m_vWastedXF.canFitm(iCurrent + 1, iEnd)) ||
 	   (!m_pParams->m_vInstance.m_bSortedDecreasingMinDim && 
-	    m_vWastedXF[r->m_nID].canFit(m_sRMinDims)))
+	    m_vWastedXF.canFit(m_sRMinDims)))
 	  if(m_vRectPtrs.size() == 1 ||
-	     packAux(iCurrent + 1, iEnd, m_vWastedXF[r->m_nID]))
+	     packAux(iCurrent + 1, iEnd))
 	    return(true);
 	m_pGrid->del(r);
+	m_vWastedXF.undo();
       }
     }
   }
@@ -114,43 +113,42 @@ bool SquarePacker::packFirst(RectPtrArray::iterator iCurrent,
 }
 
 bool SquarePacker::packAux(RectPtrArray::iterator iCurrent,
-			   RectPtrArray::const_iterator iEnd,
-			   const WastedBins& v) {
+			   RectPtrArray::const_iterator iEnd) {
   if(iCurrent == iEnd)
     return(true);
   if(m_Box.canFit(*iCurrent) &&
-     packRest(iCurrent, iEnd, v))
+     packRest(iCurrent, iEnd))
     return(true);
   if((*iCurrent)->rotatable()) {
     (*iCurrent)->rotate();
     if(m_Box.canFit(*iCurrent) &&
-       packRest(iCurrent, iEnd, v))
+       packRest(iCurrent, iEnd))
       return(true);
   }
   return(false);
 }
 
 bool SquarePacker::packRest(RectPtrArray::iterator iCurrent,
-			    RectPtrArray::const_iterator iEnd,
-			    const WastedBins& v) {
+			    RectPtrArray::const_iterator iEnd) {
   Rectangle* r(*iCurrent);
   if(r->fixed()) {
     r->x = r->m_nFixX;
     r->y = r->m_nFixY;
-    m_vWastedXF[r->m_nID] = v;
-    m_pGrid->add(r, m_vWastedXF[r->m_nID]);
+    m_vWastedXF.mark();
+    m_pGrid->add(r, m_vWastedXF);
     m_Nodes.tick(XF);
     if(m_pParams->m_vInstance.m_bSortedDecreasingMinDim) {
-      if(packAux(iCurrent + 1, iEnd, m_vWastedXF[r->m_nID]))
+      if(packAux(iCurrent + 1, iEnd))
 	return(true);
     }
     else {
       m_sRMinDims.erase(r);
-      if(packAux(iCurrent + 1, iEnd, m_vWastedXF[r->m_nID]))
+      if(packAux(iCurrent + 1, iEnd))
 	return(true);
       m_sRMinDims.insert(r);
     }
     m_pGrid->del(r);
+    m_vWastedXF.undo();
   }
   else {
     for(r->x = 0; r->x <= (m_Box.m_nWidth - r->m_nWidth); r->x++)     /* each column of grid where square could fit */
@@ -167,25 +165,26 @@ bool SquarePacker::packRest(RectPtrArray::iterator iCurrent,
 		 !m_pGrid->areaOccupied(r))) {
 	  m_Nodes.tick(XF);
 	  if(!tooClose(r)) {
-	    m_vWastedXF[r->m_nID] = v;
-	    m_pGrid->add(r, m_vWastedXF[r->m_nID]);
+	    m_vWastedXF.mark();
+	    m_pGrid->add(r, m_vWastedXF);
 	    if(m_pParams->m_vInstance.m_bSortedDecreasingMinDim) {
-	      if(m_vWastedXF[r->m_nID].canFitm(iCurrent + 1, iEnd) &&
+	      if(m_vWastedXF.canFitm(iCurrent + 1, iEnd) &&
 		 (!CREATERECT || !createRect(r))) {
-		if(packAux(iCurrent + 1, iEnd, m_vWastedXF[r->m_nID]))
+		if(packAux(iCurrent + 1, iEnd))
 		  return(true);
 	      }
 	    }
 	    else {
 	      m_sRMinDims.erase(r);
-	      if(m_vWastedXF[r->m_nID].canFit(m_sRMinDims) &&
+	      if(m_vWastedXF.canFit(m_sRMinDims) &&
 		 (!CREATERECT || !createRect(r))) {
-		if(packAux(iCurrent + 1, iEnd, m_vWastedXF[r->m_nID]))
+		if(packAux(iCurrent + 1, iEnd))
 		  return(true);
 	      }
 	      m_sRMinDims.insert(r);
 	    }
 	    m_pGrid->del(r);
+	    m_vWastedXF.undo();
 	  }
 	}
   }
@@ -464,6 +463,13 @@ void SquarePacker::initialize(const BoundingBoxes* pBoxes) {
   IntPack::initialize(pBoxes);
 }
 
+void SquarePacker::wastedSpace(UInt& nYTests, UInt& nYPrunes,
+			       UInt& nXTests, UInt& nXPrunes) const {
+  IntPack::wastedSpace(nYTests, nYPrunes, nXTests, nXPrunes);
+  nXTests += m_vWastedXF.m_nTests;
+  nXPrunes += m_vWastedXF.m_nPrunes;
+}
+
 void SquarePacker::placeUnitRectangles() {
   for(RectPtrArray::iterator i = m_iFirstUnit;
       i != m_vRectPtrs.end(); ++i) {
@@ -36,21 +36,21 @@ class SquarePacker : public IntPack {
  protected:
   virtual bool pack();
   virtual bool packFirst(RectPtrArray::iterator iCurrent,
-			 RectPtrArray::const_iterator iEnd,
-			 const WastedBins& v);
+			 RectPtrArray::const_iterator iEnd);
   virtual bool packAux(RectPtrArray::iterator iCurrent,
-		       RectPtrArray::const_iterator iEnd,
-		       const WastedBins& v);
+		       RectPtrArray::const_iterator iEnd);
   virtual bool packRest(RectPtrArray::iterator iCurrent,
-			RectPtrArray::const_iterator iEnd,
-			const WastedBins& v);
+			RectPtrArray::const_iterator iEnd);
   virtual void placeUnitRectangles();
+  virtual void wastedSpace(UInt& nYTests, UInt& nYPrunes,
+			   UInt& nXTests, UInt& nXPrunes) const;
 
   /**
-   * Represents the wasted space histogram.
+   * Represents the wasted space histogram. Each placement updates it
+   * in place and each backtrack undoes the update.
    */
 
-  std::vector<WastedBins> m_vWastedXF;
+  WastedBins m_vWastedXF;
 
  private:
 
@@ -0,0 +1,72 @@
+/**
+ * Copyright (C) 2011 Eric Huang
+ *
+ * This file is part of rectpack.
+ *
+ * rectpack is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * rectpack is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with rectpack. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Rectangle.h"
+#include "StripItem.h"
+#include <algorithm>
+
+StripItem::StripItem() :
+  m_nID(0),
+  m_nWidth(0),
+  m_nHeight(0),
+  m_bRotatable(false),
+  m_bRotated(false),
+  m_nX(0),
+  m_nY(0) {
+}
+
+StripItem::StripItem(const Rectangle& r) :
+  m_nID(r.m_nID),
+  m_nWidth(r.m_nWidth),
+  m_nHeight(r.m_nHeight),
+  m_bRotatable(r.rotatable()),
+  m_bRotated(false),
+  m_nX(0),
+  m_nY(0) {
+}
+
+StripItem::~StripItem() {
+}
+
+const char* StripItem::name(Ordering o) {
+  switch(o) {
+  case AREA: return("decreasing area");
+  case HEIGHT: return("decreasing height");
+  case WIDTH: return("decreasing width");
+  case MAXDIM: return("decreasing maximum dimension");
+  case PERIMETER: return("decreasing perimeter");
+  default: return("");
+  }
+}
+
+UInt StripItem::key(Ordering o) const {
+  switch(o) {
+  case AREA: return(m_nWidth * m_nHeight);
+  case HEIGHT: return(m_bRotatable ? std::max(m_nWidth, m_nHeight) : m_nHeight);
+  case WIDTH: return(m_bRotatable ? std::min(m_nWidth, m_nHeight) : m_nWidth);
+  case MAXDIM: return(std::max(m_nWidth, m_nHeight));
+  case PERIMETER: return(m_nWidth + m_nHeight);
+  default: return(0);
+  }
+}
+
+bool StripItem::overlaps(UInt x, UInt y, UInt w, UInt h) const {
+  return(m_nX < x + w && x < m_nX + width() &&
+	 m_nY < y + h && y < m_nY + height());
+}
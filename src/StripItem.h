@@ -0,0 +1,66 @@
+/**
+ * Copyright (C) 2011 Eric Huang
+ *
+ * This file is part of rectpack.
+ *
+ * rectpack is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * rectpack is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with rectpack. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef STRIPITEM_H
+#define STRIPITEM_H
+
+#include "Integer.h"
+
+class Rectangle;
+
+/**
+ * A rectangle as seen by the heuristic strip packers. It carries only
+ * the integral dimensions of the rectangle, whether it may be turned
+ * on its side, and where the last packing put it.
+ */
+
+class StripItem {
+ public:
+  StripItem();
+  StripItem(const Rectangle& r);
+  ~StripItem();
+
+  /**
+   * The keys by which the items may be sorted before packing. Each
+   * ordering places the items with the largest key first.
+   */
+
+  enum Ordering { AREA, HEIGHT, WIDTH, MAXDIM, PERIMETER, ORDERINGS };
+  static const char* name(Ordering o);
+  UInt key(Ordering o) const;
+
+  /**
+   * The dimensions in the current orientation.
+   */
+
+  UInt width() const { return(m_bRotated ? m_nHeight : m_nWidth); }
+  UInt height() const { return(m_bRotated ? m_nWidth : m_nHeight); }
+
+  bool overlaps(UInt x, UInt y, UInt w, UInt h) const;
+
+  UInt m_nID;
+  UInt m_nWidth;
+  UInt m_nHeight;
+  bool m_bRotatable;
+  bool m_bRotated;
+  UInt m_nX;
+  UInt m_nY;
+};
+
+#endif // STRIPITEM_H
@@ -0,0 +1,49 @@
+/**
+ * Copyright (C) 2011 Eric Huang
+ *
+ * This file is part of rectpack.
+ *
+ * rectpack is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * rectpack is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with rectpack. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BottomLeftFill.h"
+#include "MaxRectsPacker.h"
+#include "SkylinePacker.h"
+#include "StripPacker.h"
+#include <algorithm>
+
+StripPacker::StripPacker() {
+}
+
+StripPacker::~StripPacker() {
+}
+
+StripPacker* StripPacker::create(Type t) {
+  switch(t) {
+  case BOTTOMLEFT: return(new BottomLeftFill());
+  case SKYLINE: return(new SkylinePacker());
+  case MAXRECTS: return(new MaxRectsPacker());
+  default: return(NULL);
+  }
+}
+
+void StripPacker::extent(const std::vector<StripItem>& v, UInt& nWidth,
+			 UInt& nHeight) {
+  nWidth = nHeight = 0;
+  for(std::vector<StripItem>::const_iterator i = v.begin();
+      i != v.end(); ++i) {
+    nWidth = std::max(nWidth, i->m_nX + i->width());
+    nHeight = std::max(nHeight, i->m_nY + i->height());
+  }
+}
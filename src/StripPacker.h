@@ -0,0 +1,63 @@
+/**
+ * Copyright (C) 2011 Eric Huang
+ *
+ * This file is part of rectpack.
+ *
+ * rectpack is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * rectpack is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with rectpack. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef STRIPPACKER_H
+#define STRIPPACKER_H
+
+#include "Integer.h"
+#include "StripItem.h"
+#include <stddef.h>
+#include <vector>
+
+/**
+ * A greedy packer that places a sequence of rectangles, in the given
+ * order, into a strip of fixed width and unbounded height. None of
+ * them search, so they are fast enough to be run over many strip
+ * widths and item orderings to derive an upper bound on the area of
+ * the optimal bounding box.
+ */
+
+class StripPacker {
+ public:
+  StripPacker();
+  virtual ~StripPacker();
+
+  enum Type { BOTTOMLEFT, SKYLINE, MAXRECTS, TYPES };
+  static StripPacker* create(Type t);
+  virtual const char* name() const = 0;
+
+  /**
+   * Assigns each item a location (and an orientation, if it is
+   * rotatable) inside the strip.
+   *
+   * @param nWidth the width of the strip, which must be at least as
+   * wide as the narrowest orientation of every item.
+   */
+
+  virtual void pack(UInt nWidth, std::vector<StripItem>& v) = 0;
+
+  /**
+   * Computes the smallest box enclosing a packing.
+   */
+
+  static void extent(const std::vector<StripItem>& v, UInt& nWidth,
+		     UInt& nHeight);
+};
+
+#endif // STRIPPACKER_H
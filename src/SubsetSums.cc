@@ -21,8 +21,9 @@
 #include "Rectangle.h"
 #include "SubsetSums.h"
 #include "WidthHeight.h"
+#include <algorithm>
 #include <iostream>
-#include <list>
+#include <iterator>
 
 SubsetSums::SubsetSums() {
 }
@@ -30,125 +31,199 @@ SubsetSums::SubsetSums() {
 SubsetSums::~SubsetSums() {
 }
 
-void SubsetSums::intersect(SubsetSums::data_type& a,
-			   const SubsetSums::data_type& b) {
+void SubsetSums::initializeInts(UInt nMin, UInt nMax) {
+  clear();
+  while(nMin <= nMax) {
+    insert(value_type(nMin, data_type()));
+    ++nMin;
+  }
+}
+
+void SubsetSums::initialize(RectArray::const_iterator iBegin,
+			    RectArray::const_iterator iEnd,
+			    const DimsFunctor* pDims) {
+  clear();
+  std::vector<const Rectangle*> vRects;
+  for(RectArray::const_iterator i = iBegin; i != iEnd; ++i)
+    vRects.push_back(&(*i));
 
   /**
-   * Since we can't delete our iterators while we're iterating, we
-   * keep a delete list and process this after we're done scanning.
+   * Compute the final set of reachable sums. Since the set of sums
+   * only grows as we add rectangles, every intermediate sum is a
+   * member of this set, so the mutex table below is indexed by the
+   * rank of the sum in vSums.
    */
 
-  std::list<SubsetSums::data_type::iterator> lDelete;
+  std::vector<UInt> vSums;
+  reachable(vRects, pDims, vSums);
 
   /**
-   * Loop over each rectangle in the destination subset sum map. Since
-   * we're performing intersection we can limit our purview to this
-   * set (or the other one).
+   * The mutex table holds three bit rows per sum: the rectangles
+   * found in every subset achieving the sum, and whether each of
+   * them was seen in its original and in its rotated orientation.
    */
 
-  for(SubsetSums::data_type::iterator i = a.begin();
-      i != a.end(); ++i) {
+  const size_t nWords((vRects.size() + nBits - 1) / nBits);
+  std::vector<Word> vTable(vSums.size() * 3 * nWords, 0);
+  std::vector<Word> vRow(3 * nWords);
+  std::vector<bool> vReached(vSums.size(), false);
+  vReached[0] = true;
 
-    /**
-     * For each rectangle, find the corresponding rectangle in the
-     * read-only set.
-     */
+  /**
+   * Add one rectangle at a time. Visiting the sums in decreasing
+   * order means that the rows and flags of the smaller sums that we
+   * read from still describe the previous set of rectangles, so
+   * everything can be updated in place.
+   */
 
-    SubsetSums::data_type::const_iterator j =
-      b.find(i->first);
+  for(size_t k = 0; k < vRects.size(); ++k) {
+    const Rectangle* pRect = vRects[k];
+    const UInt d1(pDims->d1(pRect));
+    const UInt d2(pRect->rotatable() ? pDims->d2(pRect) : 0);
+    size_t j1(vSums.size()), j2(vSums.size());
+    for(size_t j = vSums.size(); j-- > 0; ) {
+      const UInt t(vSums[j]);
+      bool b1(false), b2(false);
+      if(t >= d1) {
+	while(j1 > 0 && vSums[j1 - 1] > t - d1) --j1;
+	b1 = (j1 > 0 && vSums[j1 - 1] == t - d1 && vReached[j1 - 1]);
+      }
+      if(d2 > 0 && t >= d2) {
+	while(j2 > 0 && vSums[j2 - 1] > t - d2) --j2;
+	b2 = (j2 > 0 && vSums[j2 - 1] == t - d2 && vReached[j2 - 1]);
+      }
+      if(!b1 && !b2) continue;
 
-    /**
-     * If the rectangle doesn't exist in both maps, and the rectangle
-     * also doesn't exist in the current rectangle (the one that is
-     * supposed to implicitly augment the new subset sum), then we
-     * will be deleting this rectangle.
-     */
+      /**
+       * Intersect the rows of up to three ways to reach this sum:
+       * without the rectangle, or by adding it in either
+       * orientation.
+       */
 
-    if(j == b.end())
-      lDelete.push_back(i);
-    else if(i->second != j->second)
-	i->second = 2;
-  }
-  while(!lDelete.empty()) {
-    a.erase(lDelete.back());
-    lDelete.pop_back();
+      size_t nWays(0);
+      if(vReached[j])
+	merge(vRow, &vTable[j * 3 * nWords], nWords, nWays++);
+      if(b1)
+	merge(vRow, &vTable[(j1 - 1) * 3 * nWords], nWords, nWays++);
+      if(b2)
+	merge(vRow, &vTable[(j2 - 1) * 3 * nWords], nWords, nWays++);
+
+      /**
+       * The new rectangle is only mandatory if adding it was the one
+       * and only way to reach the sum.
+       */
+
+      if(nWays == 1) {
+	vRow[k / nBits] |= ((Word) 1) << (k % nBits);
+	vRow[(b2 ? 2 : 1) * nWords + k / nBits] |= ((Word) 1) << (k % nBits);
+      }
+      std::copy(vRow.begin(), vRow.end(), vTable.begin() + j * 3 * nWords);
+      vReached[j] = true;
+    }
   }
-}
 
-void SubsetSums::initializeInts(UInt nMin, UInt nMax) {
-  clear();
-  while(nMin <= nMax) {
-    insert(value_type(nMin, data_type()));
-    ++nMin;
+  /**
+   * Expand the table into the map.
+   */
+
+  for(size_t j = 0; j < vSums.size(); ++j) {
+    if(!vReached[j]) continue;
+    iterator i = insert(end(), value_type(vSums[j], data_type()));
+    const Word* pRow = &vTable[j * 3 * nWords];
+    for(size_t k = 0; k < vRects.size(); ++k) {
+      Word nMask = ((Word) 1) << (k % nBits);
+      if(pRow[k / nBits] & nMask) {
+	bool b0 = (pRow[nWords + k / nBits] & nMask) != 0;
+	bool b1 = (pRow[2 * nWords + k / nBits] & nMask) != 0;
+	i->second[vRects[k]] = (b0 && b1) ? 2 : (b1 ? 1 : 0);
+      }
+    }
   }
 }
 
-void SubsetSums::initialize(RectArray::const_iterator iBegin,
-			    RectArray::const_iterator iEnd,
-			    const DimsFunctor* pDims) {
-
-  clear();
-  insert(value_type(0, data_type()));
-  for(RectArray::const_iterator i = iBegin; i != iEnd; ++i) {
+void SubsetSums::reachable(const std::vector<const Rectangle*>& vRects,
+			   const DimsFunctor* pDims,
+			   std::vector<UInt>& vSums) {
+  size_t nMax(0);
+  for(std::vector<const Rectangle*>::const_iterator i = vRects.begin();
+      i != vRects.end(); ++i)
+    if((*i)->rotatable())
+      nMax += std::max(pDims->d1(*i), pDims->d2(*i));
+    else
+      nMax += pDims->d1(*i);
 
-    const Rectangle* pRect = &(*i);
+  vSums.clear();
+  if(nMax <= nMaxDense) {
 
     /**
-     * Process the first dimension. Iterator j points to the current
-     * subset sum, while pMap points to the new value being created by
-     * the addition of rectangle i.
+     * Dense case: a bitset over all of the possible sums that is
+     * advanced by word-parallel shift-or operations.
      */
 
-    SubsetSums mNew(*this);
-    for(iterator j = begin(); j != end(); ++j) {
-      UInt nNewKey = j->first + pDims->d1(pRect);
-      iterator iMap = mNew.find(nNewKey);
-      if(iMap == mNew.end()) {
-	data_type* pMap = &mNew[nNewKey];
-	pMap->insert(j->second.begin(), j->second.end());
-	data_type::iterator k = pMap->find(pRect);
-	if(k == pMap->end())
-	  (*pMap)[pRect] = 0;
-	else if(k->second == 1)
-	  k->second = 2;
-      }
-      else {
-	(iMap->second)[pRect] = 0;
-	intersect(iMap->second, j->second);
-      }
+    boost::dynamic_bitset<> v(nMax + 1);
+    v.set(0);
+    for(std::vector<const Rectangle*>::const_iterator i = vRects.begin();
+	i != vRects.end(); ++i) {
+      boost::dynamic_bitset<> vShifted(v << pDims->d1(*i));
+      if((*i)->rotatable())
+	vShifted |= (v << pDims->d2(*i));
+      v |= vShifted;
     }
+    vSums.reserve(v.count());
+    for(size_t t = v.find_first(); t != v.npos; t = v.find_next(t))
+      vSums.push_back(t);
+  }
+  else {
 
     /**
-     * Process its rotation if applicable.
+     * Sparse case for instances with very large dimensions: sorted
+     * merges of the shifted sum lists.
      */
 
-    if(pRect->rotatable())
-      for(iterator j = begin(); j != end(); ++j) {
-	UInt nNewKey = j->first + pDims->d2(*i);
-	iterator iMap = mNew.find(nNewKey);
-	if(iMap == mNew.end()) {
-	  data_type* pMap = &mNew[nNewKey];
-	  pMap->insert(j->second.begin(), j->second.end());
-	  data_type::iterator k = pMap->find(pRect);
-	  if(k == pMap->end())
-	    (*pMap)[pRect] = 1;
-	  else if(k->second == 0)
-	    k->second = 2;
-	}
-	else {
-	  (iMap->second)[pRect] = 1;
-	  intersect(iMap->second, j->second);
-	}
+    vSums.push_back(0);
+    std::vector<UInt> vShifted1, vShifted2, vMerged;
+    for(std::vector<const Rectangle*>::const_iterator i = vRects.begin();
+	i != vRects.end(); ++i) {
+
+      /**
+       * Both orientations are added to the sums from before this
+       * rectangle, never to each other.
+       */
+
+      const UInt d1(pDims->d1(*i));
+      vShifted1.clear();
+      for(std::vector<UInt>::const_iterator j = vSums.begin();
+	  j != vSums.end(); ++j)
+	vShifted1.push_back(*j + d1);
+      vMerged.clear();
+      std::set_union(vSums.begin(), vSums.end(), vShifted1.begin(),
+		     vShifted1.end(), std::back_inserter(vMerged));
+      if((*i)->rotatable()) {
+	const UInt d2(pDims->d2(*i));
+	vShifted2.clear();
+	for(std::vector<UInt>::const_iterator j = vSums.begin();
+	    j != vSums.end(); ++j)
+	  vShifted2.push_back(*j + d2);
+	vSums.clear();
+	std::set_union(vMerged.begin(), vMerged.end(), vShifted2.begin(),
+		       vShifted2.end(), std::back_inserter(vSums));
       }
-    
-    /**
-     * Now insert all of our new entries into the current set. We
-     * can't call the regular insertion operator because it does not
-     * insert if the key already exists.
-     */
+      else
+	vSums.swap(vMerged);
+    }
+  }
+}
 
-    for(const_iterator j = mNew.begin(); j != mNew.end(); ++j)
-      (*this)[j->first] = j->second;
+void SubsetSums::merge(std::vector<Word>& vRow, const Word* pRow,
+		       size_t nWords, size_t nWays) {
+  if(nWays == 0) {
+    std::copy(pRow, pRow + 3 * nWords, vRow.begin());
+    return;
+  }
+  for(size_t i = 0; i < nWords; ++i) {
+    vRow[i] &= pRow[i];
+    vRow[nWords + i] = (vRow[nWords + i] | pRow[nWords + i]) & vRow[i];
+    vRow[2 * nWords + i] = (vRow[2 * nWords + i] | pRow[2 * nWords + i]) & vRow[i];
   }
 }
 
@@ -23,7 +23,9 @@
 #include "Integer.h"
 #include "MutexMap.h"
 #include "RectArray.h"
+#include <boost/dynamic_bitset.hpp>
 #include <map>
+#include <vector>
 
 class DimsFunctor;
 class Rectangle;
@@ -51,12 +53,29 @@ class SubsetSums : public std::map<UInt, MutexMap> {
   void computeEpsilon();
 
   /**
-   * Computes the set intersection between a and b, and store the
-   * results in a. Also, if there are common rectangle entries in both
-   * sets, we will take the union of their orientation specifications.
+   * Helpers for initialize(). The reachable sums are computed up
+   * front (with word-parallel shift-or on a dense bitset, unless the
+   * sums are too large), after which the mutex information is kept
+   * in a flat table of bit rows indexed by the rank of the sum.
    */
 
-  void intersect(data_type& a, const data_type& b);
+  typedef unsigned long Word;
+  static const size_t nBits = sizeof(Word) * 8;
+  static const size_t nMaxDense = 1 << 26;
+  static void reachable(const std::vector<const Rectangle*>& vRects,
+			const DimsFunctor* pDims,
+			std::vector<UInt>& vSums);
+
+  /**
+   * Intersects the mutex row pRow into vRow. A rectangle remains in
+   * the row only if it is present in both, and its orientation bits
+   * are the union of both (so differing orientations become
+   * unoriented). The first way to reach a sum (nWays = 0) is simply
+   * copied.
+   */
+
+  static void merge(std::vector<Word>& vRow, const Word* pRow,
+		    size_t nWords, size_t nWays);
   void print() const;
   void print(UInt n) const;
   void print(const const_iterator& i) const;
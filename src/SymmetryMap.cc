@@ -23,13 +23,30 @@
 #include "Printer.h"
 #include "SymmetryMap.h"
 
-SymmetryMap::SymmetryMap() {
+SymmetryMap::SymmetryMap() :
+  m_bPermutations(false),
+  m_nPermutations(0) {
 }
 
 SymmetryMap::~SymmetryMap() {
 }
 
-UInt SymmetryMap::symPermutations(BinomialCache& c) const {
+void SymmetryMap::insert(Component* c) {
+  operator[](c->m_Dims).insert(c);
+  m_bPermutations = false;
+}
+
+void SymmetryMap::erase(Component* c) {
+  operator[](c->m_Dims).erase(c);
+  m_bPermutations = false;
+}
+
+void SymmetryMap::clear() {
+  Parent::clear();
+  m_bPermutations = false;
+}
+
+UInt SymmetryMap::symPermutationsAux(BinomialCache& c) const {
   UInt nProduct(1), nElements(0);
   for(const_iterator i = begin(); i != end(); ++i) {
     if(i->second.empty()) continue;
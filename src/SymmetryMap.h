@@ -29,11 +29,30 @@
 class BinomialCache;
 class Component;
 
-class SymmetryMap : public std::map<Dimensions, std::set<Component*> > {
+class SymmetryMap : private std::map<Dimensions, std::set<Component*> > {
+  typedef std::map<Dimensions, std::set<Component*> > Parent;
+
  public:
   SymmetryMap();
   ~SymmetryMap();
 
+  /**
+   * The map can only be read through its iterators. Components are
+   * moved in and out through insert, erase and clear, which invalidate
+   * the cached value of symPermutations.
+   */
+
+  typedef Parent::const_iterator const_iterator;
+  typedef Parent::const_reverse_iterator const_reverse_iterator;
+  const_iterator begin() const { return(Parent::begin()); };
+  const_iterator end() const { return(Parent::end()); };
+  const_reverse_iterator rbegin() const { return(Parent::rbegin()); };
+  const_reverse_iterator rend() const { return(Parent::rend()); };
+  bool empty() const { return(Parent::empty()); };
+  void insert(Component* c);
+  void erase(Component* c);
+  void clear();
+
   /**
    * Returns the number of search nodes to try all possible
    * combinations and permutations of assignment, subject to our
@@ -48,7 +67,13 @@ class SymmetryMap : public std::map<Dimensions, std::set<Component*> > {
    * values.
    */
 
-  UInt symPermutations(BinomialCache& c) const;
+  UInt symPermutations(BinomialCache& c) const {
+    if(!m_bPermutations) {
+      m_nPermutations = symPermutationsAux(c);
+      m_bPermutations = true;
+    }
+    return(m_nPermutations);
+  }
 
   /**
    * This function is similar to the one previously defined, with the
@@ -82,6 +107,18 @@ class SymmetryMap : public std::map<Dimensions, std::set<Component*> > {
   void hasHeight(UInt h, std::list<Int>& l) const;
   void print() const;
   void print(std::ostream& os) const;
+
+ private:
+  UInt symPermutationsAux(BinomialCache& c) const;
+
+  /**
+   * The result of symPermutations(BinomialCache&), which only depends
+   * on the set sizes and is therefore valid until the next insert,
+   * erase or clear.
+   */
+
+  mutable bool m_bPermutations;
+  mutable UInt m_nPermutations;
 };
 
 #endif // SYMMETRYMAP
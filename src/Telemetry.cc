@@ -0,0 +1,87 @@
+/**
+ * Copyright (C) 2011 Eric Huang
+ *
+ * This file is part of rectpack.
+ *
+ * rectpack is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * rectpack is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with rectpack. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BoxDimensions.h"
+#include "Packer.h"
+#include "Telemetry.h"
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <time.h>
+
+Telemetry::Telemetry() :
+  m_bEnabled(false) {
+}
+
+Telemetry::~Telemetry() {
+  close();
+}
+
+bool Telemetry::open(const std::string& sFile) {
+  close();
+  m_File.open(sFile.c_str(), std::ios::out | std::ios::app);
+  if(!m_File) {
+    std::cout << "Unable to open the telemetry file " << sFile
+	      << "." << std::endl;
+    return(false);
+  }
+  clock_gettime(CLOCK_MONOTONIC, &m_Start);
+  m_bEnabled = true;
+  return(true);
+}
+
+void Telemetry::close() {
+  if(m_File.is_open())
+    m_File.close();
+  m_bEnabled = false;
+}
+
+void Telemetry::write(const BoxDimensions& b, const char* sResult,
+		      Packer* pPacker, size_t nThread, size_t nQueue,
+		      size_t nLocal) {
+  if(!m_bEnabled) return;
+  TimeSpec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  t -= m_Start;
+
+  std::ostringstream oss;
+  oss << std::fixed << std::setprecision(6)
+      << "{\"elapsed\":" << t.toDouble()
+      << ",\"thread\":" << nThread
+      << ",\"queue\":" << nQueue
+      << ",\"local\":" << nLocal
+      << ",\"width\":" << b.m_nWidth
+      << ",\"height\":" << b.m_nHeight
+      << ",\"area\":" << b.m_nArea
+      << ",\"result\":\"" << sResult << '"'
+      << ",\"packer\":" << pPacker->weakening()
+      << ",\"nodes\":{\"YI\":" << pPacker->m_Nodes.get(YI)
+      << ",\"YF\":" << pPacker->m_Nodes.get(YF)
+      << ",\"XI\":" << pPacker->m_Nodes.get(XI)
+      << ",\"XF\":" << pPacker->m_Nodes.get(XF)
+      << "},\"time\":{\"total\":" << pPacker->m_Time.toDouble()
+      << ",\"x\":" << pPacker->m_XTime.toDouble()
+      << ",\"y\":" << pPacker->m_YTime.toDouble()
+      << ",\"domination\":" << pPacker->timeDomination().toDouble()
+      << "},\"cusp\":" << pPacker->m_nCuSP
+      << "}\n";
+
+  boost::unique_lock<boost::mutex> lock(m_Mutex);
+  m_File << oss.str() << std::flush;
+}
@@ -0,0 +1,87 @@
+/**
+ * Copyright (C) 2011 Eric Huang
+ *
+ * This file is part of rectpack.
+ *
+ * rectpack is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * rectpack is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with rectpack. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include "TimeSpec.h"
+#include <boost/thread/mutex.hpp>
+#include <fstream>
+#include <string>
+
+class BoxDimensions;
+class Packer;
+
+/**
+ * A machine-readable record of the bounding box search. Every
+ * packing attempt is appended to the file as a single line holding a
+ * JSON object with the box, the result, the nodes by type, the
+ * timings, the CuSP solutions, the thread that packed it and how many
+ * boxes were still queued. Records are formatted before the lock is
+ * taken and flushed line by line, so a record is never split and the
+ * file can be tailed during a run. Writing is safe from any thread.
+ */
+
+class Telemetry {
+ public:
+  Telemetry();
+  ~Telemetry();
+
+  /**
+   * Opens the file for appending.
+   *
+   * @return false if the file couldn't be opened, in which case no
+   * records will be written.
+   */
+
+  bool open(const std::string& sFile);
+  void close();
+  bool enabled() const { return(m_bEnabled); }
+
+  /**
+   * Appends the record of the packer's most recent attempt.
+   *
+   * @param sResult one of "feasible", "infeasible" or "cancelled".
+   *
+   * @param nThread the ID of the worker that ran the attempt.
+   *
+   * @param nQueue the number of boxes still waiting in the shared
+   * queue.
+   *
+   * @param nLocal the number of boxes claimed by the worker but not
+   * yet attempted.
+   */
+
+  void write(const BoxDimensions& b, const char* sResult, Packer* pPacker,
+	     size_t nThread, size_t nQueue, size_t nLocal);
+
+ private:
+  bool m_bEnabled;
+  boost::mutex m_Mutex;
+  std::ofstream m_File;
+
+  /**
+   * When the file was opened, so that each record can carry the
+   * elapsed wall-clock time.
+   */
+
+  TimeSpec m_Start;
+};
+
+#endif // TELEMETRY_H
@@ -17,6 +17,7 @@
  * along with rectpack. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include "Probes.h"
 #include "URectDom.h"
 #include "Rectangle.h"
 
@@ -215,6 +216,7 @@ URectDom::~URectDom() {
 }
 
 bool URectDom::dominatedw(const Rectangle* r, UInt nGap) const {
+  PROBE(PROBE_DOMINATION);
   if(nGap < MAXGAP) {
     if(r->m_nWidth < r->m_nHeight)
       return(m_pRectShort[r->m_nWidth][nGap] == 1);
@@ -225,6 +227,7 @@ bool URectDom::dominatedw(const Rectangle* r, UInt nGap) const {
 }
 
 bool URectDom::dominatedh(const Rectangle* r, UInt nGap) const {
+  PROBE(PROBE_DOMINATION);
   if(nGap < MAXGAP) {
     if(r->m_nHeight < r->m_nWidth)
       return(m_pRectShort[r->m_nHeight][nGap] == 1);
@@ -28,6 +28,7 @@
 #include "Printer.h"
 #include "Packer.h"
 #include "Placements.h"
+#include "Probes.h"
 #include "SubsetSums.h"
 #include "TimeSpec.h"
 #include "UnitEmpty.h"
@@ -38,6 +39,7 @@ UnitEmpty::UnitEmpty() :
   m_pBox(NULL),
   m_pTime(NULL),
   m_pNodes(NULL),
+  m_pCancel(NULL),
   m_nDepth(0),
   m_nCorners(0),
   m_pValidY(NULL),
@@ -54,6 +56,7 @@ void UnitEmpty::initialize(Packer* pPacker) {
   m_pCuSP = &pPacker->m_nCuSP;
   m_pTime = &pPacker->m_YTime;
   m_pNodes = &pPacker->m_Nodes;
+  m_pCancel = &pPacker->m_bCancel;
 }
 
 void UnitEmpty::initialize(const Parameters* pParams) {
@@ -128,7 +131,7 @@ bool UnitEmpty::packY(Cumulative& c, const SubsetSums* pValidY) {
 }
 
 bool UnitEmpty::packYAux(Int nDepth) {
-  if(bQuit) return(false);
+  if(bQuit || m_pCancel->load(boost::memory_order_relaxed)) return(false);
 
   /**
    * Base case is when we've got
@@ -224,7 +227,7 @@ void UnitEmpty::pushAux(Component* c) {
    * (carefully putting them into our undo stack).
    */
 
-  m_vStack.push_back(Assignment(c));
+  m_vStack.push_back(c);
   m_vVariables.erase(c, m_vStack.back().m_vErased);
 
   /**
@@ -251,7 +254,7 @@ void UnitEmpty::pushAux(Component* c, Component* pNew) {
    * (carefully putting them into our undo stack).
    */
 
-  m_vStack.push_back(Assignment(pNew));
+  m_vStack.push_back(pNew);
   m_vVariables.erase(pNew, m_vStack.back().m_vErased);
 
   /**
@@ -333,11 +336,11 @@ void UnitEmpty::popAux(Component* c) {
 void UnitEmpty::newCorners(const Component* c,
 			   std::vector<EmptyCorner>& v) const {
   v.clear();
-  std::vector<Assignment>::const_iterator iEnd(m_vStack.end());
+  AssignmentStack::const_iterator iEnd(m_vStack.end());
   --iEnd;
   UInt x2(c->x2());
   UInt y2(c->y2());
-  for(std::vector<Assignment>::const_iterator i = m_vStack.begin();
+  for(AssignmentStack::const_iterator i = m_vStack.begin();
       i != iEnd; ++i) {
     
     const Component* c2(i->m_pComponent);
@@ -452,7 +455,7 @@ void UnitEmpty::newCorners(const Component* c,
        * other rectangle has already filled in the empty corner.
        */
 
-      for(std::vector<Assignment>::const_iterator i = m_vStack.begin();
+      for(AssignmentStack::const_iterator i = m_vStack.begin();
 	  i != iEnd; ++i)
 	if(i->m_pComponent->fills(v[j])) {
 	  v[j] = v.back();
@@ -495,7 +498,7 @@ void UnitEmpty::pop(Component* c) {
 }
 
 bool UnitEmpty::placed(Component* c) const {
-  for(std::vector<Assignment>::const_iterator i = m_vStack.begin();
+  for(AssignmentStack::const_iterator i = m_vStack.begin();
       i != m_vStack.end(); ++i)
     if(i->m_pComponent == c) return(true);
   return(false);
@@ -512,7 +515,7 @@ bool UnitEmpty::packYCorner(EmptyCorner& ec, Int nDepth) {
    * representation.
    */
 
-  for(SymmetryMap::reverse_iterator k = pValues->rbegin();
+  for(SymmetryMap::const_reverse_iterator k = pValues->rbegin();
       k != pValues->rend(); ++k) {
 
     /**
@@ -566,14 +569,17 @@ bool UnitEmpty::packYCorner(EmptyCorner& ec, Int nDepth) {
        */
 
       SubsetSums::const_iterator yBegin, yEnd;
-      if(ec.m_nType == EmptyCorner::LowerLeft ||
-	 ec.m_nType == EmptyCorner::LowerRight) {
-	yBegin = m_pValidY->upper_bound(ec.m_Location.y);
-	yEnd = m_pValidY->upper_bound(ec.m_Location.y + nHeight);
-      }
-      else {
-	yBegin = m_pValidY->lower_bound(ec.m_Location.y + 1 - nHeight);
-	yEnd = m_pValidY->lower_bound(ec.m_Location.y + 1);
+      {
+	PROBE(PROBE_SUBSETSUMS);
+	if(ec.m_nType == EmptyCorner::LowerLeft ||
+	   ec.m_nType == EmptyCorner::LowerRight) {
+	  yBegin = m_pValidY->upper_bound(ec.m_Location.y);
+	  yEnd = m_pValidY->upper_bound(ec.m_Location.y + nHeight);
+	}
+	else {
+	  yBegin = m_pValidY->lower_bound(ec.m_Location.y + 1 - nHeight);
+	  yEnd = m_pValidY->lower_bound(ec.m_Location.y + 1);
+	}
       }
 
       /**
@@ -701,7 +707,7 @@ bool UnitEmpty::packYCorner(EmptyCorner& ec, Int nDepth) {
 void UnitEmpty::printStack() const {
   std::cout << "Assignment Stack:" << std::endl;
   UInt nMax(0), nStart(0);
-  for(std::vector<Assignment>::const_iterator i = m_vStack.begin();
+  for(AssignmentStack::const_iterator i = m_vStack.begin();
       i != m_vStack.end(); ++i) {
     std::ostringstream oss;
     Printer::print(i->m_vErased, oss);
@@ -747,7 +753,7 @@ void UnitEmpty::print() const {
 }
 
 bool UnitEmpty::canPlace(const Component* c) const {
-  for(std::vector<Assignment>::const_iterator i = m_vStack.begin();
+  for(AssignmentStack::const_iterator i = m_vStack.begin();
       i != m_vStack.end(); ++i)
     if(i->m_pComponent->yOverlaps(*c) &&
        i->m_pComponent->xOverlaps(*c)) return(false);
@@ -779,7 +785,7 @@ UInt UnitEmpty::maxHeight(const EmptyCorner& ec,
    * Iterate over every iteme in our stack, constraining the height.
    */
 
-  for(std::vector<Assignment>::const_iterator i = m_vStack.begin();
+  for(AssignmentStack::const_iterator i = m_vStack.begin();
       i != m_vStack.end(); ++i)
     ec.constrainHeight(nWidth, nHeight, i->m_pComponent);
   return(nHeight);
@@ -789,11 +795,11 @@ void UnitEmpty::placeDominated(Int& nStartDepth) {
   EmptyCorner ec(0, 0, EmptyCorner::LowerLeft);
   SymmetryMap* pValues = getValues(ec);
   m_vDominated.clear();
-  for(SymmetryMap::reverse_iterator k = pValues->rbegin();
+  for(SymmetryMap::const_reverse_iterator k = pValues->rbegin();
       k != pValues->rend(); ++k) {
     if(k->second.empty() ||
        k->first.m_nWidth != m_pBox->m_nWidth) continue;
-    for(std::set<Component*>::iterator i = k->second.begin();
+    for(std::set<Component*>::const_iterator i = k->second.begin();
 	i != k->second.end(); ++i) {
       if((*i)->m_pEmpty)
 	continue;
@@ -831,7 +837,7 @@ void UnitEmpty::findTopSymmetry() {
    * and it's not empty.
      */
   
-  SymmetryMap::reverse_iterator i = pValues->rbegin();
+  SymmetryMap::const_reverse_iterator i = pValues->rbegin();
   while(i->second.empty() && i != pValues->rend())
     ++i;
   if(i == pValues->rend() || i->second.size() != 1)
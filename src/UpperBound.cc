@@ -0,0 +1,174 @@
+/**
+ * Copyright (C) 2011 Eric Huang
+ *
+ * This file is part of rectpack.
+ *
+ * rectpack is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * rectpack is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with rectpack. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Placement.h"
+#include "Placements.h"
+#include "RectArray.h"
+#include "UpperBound.h"
+#include <algorithm>
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
+#include <math.h>
+
+/**
+ * Sorts the items by decreasing key, breaking ties by ID so that each
+ * ordering is deterministic.
+ */
+
+class GreaterKey {
+public:
+  GreaterKey(StripItem::Ordering o) : m_Ordering(o) {}
+  bool operator()(const StripItem& a, const StripItem& b) const {
+    UInt ka = a.key(m_Ordering), kb = b.key(m_Ordering);
+    return(ka > kb || (ka == kb && a.m_nID < b.m_nID));
+  }
+  StripItem::Ordering m_Ordering;
+};
+
+UpperBound::UpperBound() :
+  m_nArea(0),
+  m_nWidth(0),
+  m_nHeight(0) {
+}
+
+UpperBound::~UpperBound() {
+}
+
+void UpperBound::initialize(const RectArray& v) {
+  m_vItems.clear();
+  for(RectArray::const_iterator i = v.begin(); i != v.end(); ++i)
+    m_vItems.push_back(StripItem(*i));
+  widths();
+}
+
+void UpperBound::widths() {
+
+  /**
+   * The strip must admit the widest item in its narrowest orientation,
+   * and there's no point in a strip wider than all of the items side
+   * by side. Half of the widths are spread evenly over that range,
+   * and the other half more densely around the square root of the
+   * total area, where the optimal boxes usually are.
+   */
+
+  m_vWidths.clear();
+  if(m_vItems.empty()) return;
+  UInt nMin(0), nMax(0), nArea(0);
+  for(std::vector<StripItem>::const_iterator i = m_vItems.begin();
+      i != m_vItems.end(); ++i) {
+    UInt w = i->m_bRotatable ? std::min(i->m_nWidth, i->m_nHeight) :
+      i->m_nWidth;
+    nMin = std::max(nMin, w);
+    nMax += w;
+    nArea += i->m_nWidth * i->m_nHeight;
+  }
+  const UInt nSteps(32);
+  UInt nSquare = (UInt) (2.0 * sqrt((double) nArea));
+  for(UInt j = 0; j < nSteps; ++j) {
+    m_vWidths.push_back(nMin + (nMax - nMin) * j / (nSteps - 1));
+    if(nSquare > nMin)
+      m_vWidths.push_back(nMin + (std::min(nSquare, nMax) - nMin) * j /
+			  (nSteps - 1));
+  }
+  std::sort(m_vWidths.begin(), m_vWidths.end());
+  m_vWidths.erase(std::unique(m_vWidths.begin(), m_vWidths.end()),
+		  m_vWidths.end());
+}
+
+bool UpperBound::run(size_t nThreads) {
+  m_nArea = m_nWidth = m_nHeight = 0;
+  m_sPacker.clear();
+  m_sOrdering.clear();
+  m_vBest.clear();
+  if(m_vItems.empty()) return(false);
+
+  size_t nTasks = StripPacker::TYPES * StripItem::ORDERINGS;
+  m_vPackings.assign(nTasks, std::vector<StripItem>());
+  m_vAreas.assign(nTasks, 0);
+  nThreads = std::max((size_t) 1, std::min(nThreads, nTasks));
+  if(nThreads == 1)
+    runTasks(0, 1);
+  else {
+    boost::thread_group vThreads;
+    for(size_t i = 0; i < nThreads; ++i)
+      vThreads.create_thread(boost::bind(&UpperBound::runTasks, this, i,
+					 nThreads));
+    vThreads.join_all();
+  }
+
+  /**
+   * Ties go to the pair tried first in sequence.
+   */
+
+  size_t nBest(nTasks);
+  for(size_t i = 0; i < nTasks; ++i)
+    if(m_vAreas[i] > 0 && (nBest == nTasks || m_vAreas[i] < m_vAreas[nBest]))
+      nBest = i;
+  if(nBest == nTasks) return(false);
+  m_vBest = m_vPackings[nBest];
+  m_nArea = m_vAreas[nBest];
+  StripPacker::extent(m_vBest, m_nWidth, m_nHeight);
+  StripPacker* p =
+    StripPacker::create((StripPacker::Type) (nBest / StripItem::ORDERINGS));
+  m_sPacker = p->name();
+  delete p;
+  m_sOrdering =
+    StripItem::name((StripItem::Ordering) (nBest % StripItem::ORDERINGS));
+  return(true);
+}
+
+void UpperBound::runTasks(size_t nFirst, size_t nStride) {
+  for(size_t i = nFirst; i < m_vAreas.size(); i += nStride)
+    runTask(i);
+}
+
+void UpperBound::runTask(size_t nTask) {
+  StripPacker::Type t = (StripPacker::Type) (nTask / StripItem::ORDERINGS);
+  StripItem::Ordering o =
+    (StripItem::Ordering) (nTask % StripItem::ORDERINGS);
+  if(t == StripPacker::BOTTOMLEFT && m_vItems.size() > BOTTOMLEFTLIMIT)
+    return;
+
+  std::vector<StripItem> v(m_vItems);
+  std::sort(v.begin(), v.end(), GreaterKey(o));
+  StripPacker* p = StripPacker::create(t);
+  for(std::vector<UInt>::const_iterator i = m_vWidths.begin();
+      i != m_vWidths.end(); ++i) {
+    p->pack(*i, v);
+    UInt nWidth, nHeight;
+    StripPacker::extent(v, nWidth, nHeight);
+    if(m_vAreas[nTask] == 0 || nWidth * nHeight < m_vAreas[nTask]) {
+      m_vAreas[nTask] = nWidth * nHeight;
+      m_vPackings[nTask] = v;
+    }
+  }
+  delete p;
+}
+
+void UpperBound::get(Placements& v) const {
+  v.clear();
+  v.resize(m_vBest.size());
+  for(std::vector<StripItem>::const_iterator i = m_vBest.begin();
+      i != m_vBest.end(); ++i) {
+    Placement& p = v[i->m_nID];
+    p.m_Dims = RatDims(URational(i->width()), URational(i->height()));
+    p.m_nLocation = Coordinates(i->m_nX, i->m_nY);
+  }
+  v.m_Box = RatDims(URational(m_nWidth), URational(m_nHeight));
+}
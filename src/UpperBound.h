@@ -0,0 +1,98 @@
+/**
+ * Copyright (C) 2011 Eric Huang
+ *
+ * This file is part of rectpack.
+ *
+ * rectpack is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * rectpack is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with rectpack. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UPPERBOUND_H
+#define UPPERBOUND_H
+
+#include "Integer.h"
+#include "StripItem.h"
+#include "StripPacker.h"
+#include <string>
+#include <vector>
+
+class Placements;
+class RectArray;
+
+/**
+ * Derives an upper bound on the area of the optimal bounding box
+ * before any exact search is done, by running a portfolio of greedy
+ * strip packers. Every packer is tried with every item ordering over
+ * a sweep of strip widths, and the packing with the smallest
+ * enclosing box wins. The packer and ordering pairs are independent
+ * of each other and may be spread over several threads; the outcome
+ * doesn't depend on how many are used.
+ */
+
+class UpperBound {
+ public:
+  UpperBound();
+  ~UpperBound();
+  void initialize(const RectArray& v);
+
+  /**
+   * @return false if there was nothing to pack.
+   */
+
+  bool run(size_t nThreads);
+
+  /**
+   * Converts the best packing into placements (on the same integral
+   * scale as the rectangles we were initialized with).
+   */
+
+  void get(Placements& v) const;
+
+  UInt m_nArea;
+  UInt m_nWidth;
+  UInt m_nHeight;
+  std::string m_sPacker;
+  std::string m_sOrdering;
+
+  /**
+   * Bottom-left-fill is only included in the portfolio for instances
+   * up to this many rectangles.
+   */
+
+  static const size_t BOTTOMLEFTLIMIT = 40;
+
+ private:
+
+  /**
+   * Runs the packer and ordering pairs numbered nFirst, nFirst +
+   * nStride, and so on.
+   */
+
+  void runTasks(size_t nFirst, size_t nStride);
+  void runTask(size_t nTask);
+  void widths();
+
+  std::vector<StripItem> m_vItems;
+  std::vector<UInt> m_vWidths;
+
+  /**
+   * The best packing found by each packer and ordering pair, and its
+   * area (0 if the pair was skipped).
+   */
+
+  std::vector<std::vector<StripItem> > m_vPackings;
+  std::vector<UInt> m_vAreas;
+  std::vector<StripItem> m_vBest;
+};
+
+#endif // UPPERBOUND_H
@@ -24,6 +24,8 @@
 #include "UpperDistance.h"
 #include <iomanip>
 #include <limits>
+#include <list>
+#include <map>
 
 UpperDistance::UpperDistance() {
 }
@@ -52,9 +54,7 @@ void UpperDistance::initialize(const ComponentPtrs& v,
    * Initialize our upper bound matrix using the box dimensions.
    */
 
-  clear();
-  resize(m_vComponents.size(),
-	 std::vector<UInt>(m_vComponents.size(), 0));
+  DistanceMatrix<UInt>::initialize(m_vComponents.size(), 0);
   for(UInt i = 0; i < size(); ++i)
     for(UInt j = i + 1; j < size(); ++j) {
       operator[](i)[j] = b.m_nWidth - m_vComponents[j]->m_Dims.m_nWidth;
@@ -98,17 +98,7 @@ void UpperDistance::compute(const AlignedComponents& vTops,
 }
 
 bool UpperDistance::asps() {
-  bool bWorkDone(false);
-  for(UInt k = 0; k < size(); ++k)
-    for(UInt i = 0; i < size(); ++i)
-      for(UInt j = 0; j < size(); ++j) {
-	UInt nNew(get(i, k) + get(k, j));
-	if(nNew < get(i, j)) {
-	  get(i, j) = nNew;
-	  bWorkDone = true;
-	}
-      }
-  return(bWorkDone);
+  return(floydWarshall());
 }
 
 UInt& UpperDistance::get(UInt i, UInt j) {
@@ -224,8 +214,8 @@ bool UpperDistance::tightenY(const AlignedComponents& vTops,
   for(UInt i = 0; i < m_vComponents.size(); ++i)
     for(UInt j = i + 1; j < m_vComponents.size(); ++j)
       if(yAdjacent(i, j) &&
-	 !boost::edge(m_vComponents[i]->m_nID, m_vComponents[j]->m_nID, y).second) 
-	boost::add_edge(m_vComponents[i]->m_nID, m_vComponents[j]->m_nID, y);
+	 !y.edge(m_vComponents[i]->m_nID, m_vComponents[j]->m_nID))
+	y.addEdge(m_vComponents[i]->m_nID, m_vComponents[j]->m_nID);
   
   for(AlignedComponents::const_iterator i = vBottoms.begin();
       i != vBottoms.end(); ++i) {
@@ -249,20 +239,19 @@ bool UpperDistance::tightenY(const AlignedComponents& vTops,
 
     typedef std::map<UInt, std::list<UInt> > MyMap;
     MyMap mBottom, mTop;
-    AdjacencyTraits::edge_iterator ei, ei_end;
-    for(boost::tie(ei, ei_end) = boost::edges(y); ei != ei_end; ++ei) {
-      UInt n1(boost::source(*ei, y)), n2(boost::target(*ei, y));
-      if(i->second.find(n1) != i->second.end() &&
-	 h->second.find(n2) != h->second.end()) {
-	mBottom[n1].push_back(n2);
-	mTop[n2].push_back(n1);
-      }
-      else if(i->second.find(n2) != i->second.end() &&
-	      h->second.find(n1) != h->second.end()) {
-	mBottom[n2].push_back(n1);
-	mTop[n1].push_back(n2);
+    for(UInt n1 = 0; n1 < y.size(); ++n1)
+      for(UInt n2 = y.next(n1, n1); n2 < y.size(); n2 = y.next(n1, n2)) {
+	if(i->second.find(n1) != i->second.end() &&
+	   h->second.find(n2) != h->second.end()) {
+	  mBottom[n1].push_back(n2);
+	  mTop[n2].push_back(n1);
+	}
+	else if(i->second.find(n2) != i->second.end() &&
+		h->second.find(n1) != h->second.end()) {
+	  mBottom[n2].push_back(n1);
+	  mTop[n1].push_back(n2);
+	}
       }
-    }
     
     /**
      * Look for cases where we have one item that has two Y-adjacent
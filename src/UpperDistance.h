@@ -20,7 +20,12 @@
 #ifndef UPPERDISTANCE_H
 #define UPPERDISTANCE_H
 
-#include <boost/graph/adjacency_list.hpp>
+#ifdef ADJACENCYLIST
+#include "AdjacencyList.h"
+#else
+#include "AdjacencyMatrix.h"
+#endif // ADJACENCYLIST
+#include "DistanceMatrix.h"
 #include <set>
 #include <vector>
 
@@ -29,10 +34,13 @@ class BoxDimensions;
 class Component;
 class ComponentPtrs;
 
-class UpperDistance : public std::vector<std::vector<UInt> > {
+class UpperDistance : public DistanceMatrix<UInt> {
  public:
-  typedef boost::adjacency_list<boost::listS, boost::vecS, boost::undirectedS> Adjacency;
-  typedef boost::graph_traits<Adjacency> AdjacencyTraits;
+#ifdef ADJACENCYLIST
+  typedef AdjacencyList Adjacency;
+#else
+  typedef AdjacencyMatrix Adjacency;
+#endif // ADJACENCYLIST
   UpperDistance();
   ~UpperDistance();
 
@@ -536,7 +536,7 @@ void VizDrawing::drawXF(GridViz* pGrid) {
 		     c->m_Dims.m_nWidth, c->m_Dims.m_nHeight,
 		     nXScale, nYScale, cr, pGrid->box());
 	  cr->stroke();
-	  for(std::set<Component*>::const_iterator i = c->m_Members.begin();
+	  for(ComponentSet::const_iterator i = c->m_Members.begin();
 	      i != c->m_Members.end(); ++i)
 	    d.push(*i);
 	}
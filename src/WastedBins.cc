@@ -22,23 +22,31 @@
 #include "Component.h"
 #include "ComponentPtrs.h"
 #include "Parameters.h"
+#include "Probes.h"
 #include "RectSetMinDim.h"
 #include "WastedBins.h"
+#include <algorithm>
 #include <assert.h>
 #include <iostream>
 #include <iomanip>
 
 WastedBins::WastedBins() :
+  m_nTests(0),
+  m_nPrunes(0),
   m_bEnabled(true) {
 }
 
 WastedBins::WastedBins(UInt i, Int j) :
   std::vector<Int>(i, j),
+  m_nTests(0),
+  m_nPrunes(0),
   m_bEnabled(true) {
 }
 
 WastedBins::WastedBins(const BoxDimensions& b) :
   std::vector<Int>(b.m_nWidth + 1, 0),
+  m_nTests(0),
+  m_nPrunes(0),
   m_bEnabled(true) {
   back() = b.m_nArea;
 }
@@ -51,6 +59,7 @@ void WastedBins::initialize(const BoxDimensions& b) {
   clear();
   resize(b.m_nWidth + 1, 0);
   back() = b.m_nArea;
+  clearTrail();
 }
 
 WastedBins::~WastedBins() {
@@ -62,16 +71,28 @@ const WastedBins& WastedBins::operator=(const WastedBins& src) {
   return(*this);
 }
 
+void WastedBins::undo() {
+  std::vector<Int>::iterator i = m_vTrail.end() - size();
+  std::copy(i, m_vTrail.end(), begin());
+  m_vTrail.erase(i, m_vTrail.end());
+}
+
+void WastedBins::clearTrail() {
+  m_vTrail.clear();
+}
+
 bool WastedBins::canFitw(RectPtrArray::const_iterator iStart,
 			 const RectPtrArray::const_iterator& iEnd) const {
+  PROBE(PROBE_WASTEDSPACE);
   if(m_bEnabled) {
+    ++m_nTests;
     Int nArea(0), nSpace(0);
     for(int j = size() - 1; j >= 0; --j) {
       nSpace += operator[](j);
       for(; iStart != iEnd && (Int) (*iStart)->m_nWidth >= j; ++iStart)
 	nArea += (*iStart)->m_nArea;
       if(nSpace < nArea)
-	return(false);
+	return(prune());
     }
   }
   return(true);
@@ -79,7 +100,9 @@ bool WastedBins::canFitw(RectPtrArray::const_iterator iStart,
 
 bool WastedBins::canFitw(RectPtrArray::const_reverse_iterator iStart,
 			 const RectPtrArray::const_reverse_iterator& iEnd) const {
+  PROBE(PROBE_WASTEDSPACE);
   if(m_bEnabled) {
+    ++m_nTests;
     Int nArea(0), nSpace(0);
     Int j = size() - 1;
     for(; iStart != iEnd; ++iStart) {
@@ -87,7 +110,7 @@ bool WastedBins::canFitw(RectPtrArray::const_reverse_iterator iStart,
       for(; j >= (Int) (*iStart)->m_nWidth; --j)
 	nSpace += operator[](j);
       if(nSpace < nArea)
-	return(false);
+	return(prune());
     }
   }
   return(true);
@@ -96,7 +119,9 @@ bool WastedBins::canFitw(RectPtrArray::const_reverse_iterator iStart,
 bool WastedBins::canFitw(RectPtrArray::const_reverse_iterator iStart,
 			 const RectPtrArray::const_reverse_iterator& iEnd,
 			 UInt& r) const {
+  PROBE(PROBE_WASTEDSPACE);
   if(m_bEnabled) {
+    ++m_nTests;
     Int nArea(0), nSpace(0);
     Int j = size() - 1;
     for(; iStart != iEnd; ++iStart) {
@@ -105,7 +130,7 @@ bool WastedBins::canFitw(RectPtrArray::const_reverse_iterator iStart,
 	nSpace += operator[](j);
       if(nSpace < nArea) {
 	r = (*iStart)->m_nID;
-	return(false);
+	return(prune());
       }
     }
   }
@@ -115,7 +140,9 @@ bool WastedBins::canFitw(RectPtrArray::const_reverse_iterator iStart,
 bool WastedBins::canFitw(RectPtrArray::const_iterator iStart,
 			 const RectPtrArray::const_iterator& iEnd,
 			 UInt& r, UInt& s) const {
+  PROBE(PROBE_WASTEDSPACE);
   if(m_bEnabled) {
+    ++m_nTests;
     Int nArea(0), nSpace(0);
     Int j = size() - 1;
     for(; iStart != iEnd; ++iStart) {
@@ -137,7 +164,7 @@ bool WastedBins::canFitw(RectPtrArray::const_iterator iStart,
 	    nSpace += operator[](j);
 	  if(nSpace >= nArea) {
 	    s = (*iStart)->m_nID;
-	    return(false);
+	    return(prune());
 	  }
 	}
 
@@ -148,7 +175,7 @@ bool WastedBins::canFitw(RectPtrArray::const_iterator iStart,
 	 */
 
 	s = 0;
-	return(false);
+	return(prune());
       }
     }
   }
@@ -156,7 +183,9 @@ bool WastedBins::canFitw(RectPtrArray::const_iterator iStart,
 }
 
 bool WastedBins::canFit(const RectSetMinDim& s) const {
+  PROBE(PROBE_WASTEDSPACE);
   if(m_bEnabled) {
+    ++m_nTests;
     Int nArea(0), nSpace(0);
     RectSetMinDim::const_iterator i = s.begin();
     for(int j = size() - 1; j >= 0; --j) {
@@ -164,7 +193,7 @@ bool WastedBins::canFit(const RectSetMinDim& s) const {
       for(; i != s.end() && (Int) (*i)->m_nMinDim >= j; ++i)
 	nArea += (*i)->m_nArea;
       if(nSpace < nArea)
-	return(false);
+	return(prune());
     }
   }
   return(true);
@@ -172,14 +201,16 @@ bool WastedBins::canFit(const RectSetMinDim& s) const {
 
 bool WastedBins::canFith(RectPtrArray::const_iterator iStart,
 			 const RectPtrArray::const_iterator& iEnd) const {
+  PROBE(PROBE_WASTEDSPACE);
   if(m_bEnabled) {
+    ++m_nTests;
     Int nArea(0), nSpace(0);
     for(int j = size() - 1; j >= 0; --j) {
       nSpace += operator[](j);
       for(; iStart != iEnd && (Int) (*iStart)->m_nHeight >= j; ++iStart)
 	nArea += (*iStart)->m_nArea;
       if(nSpace < nArea)
-	return(false);
+	return(prune());
     }
   }
   return(true);
@@ -187,14 +218,16 @@ bool WastedBins::canFith(RectPtrArray::const_iterator iStart,
 
 bool WastedBins::canFitm(RectPtrArray::const_iterator iStart,
 			 const RectPtrArray::const_iterator& iEnd) const {
+  PROBE(PROBE_WASTEDSPACE);
   if(m_bEnabled) {
+    ++m_nTests;
     Int nArea(0), nSpace(0);
     for(int j = size() - 1; j >= 0; --j) {
       nSpace += operator[](j);
       for(; iStart != iEnd && (Int) (*iStart)->m_nMinDim >= j; ++iStart)
 	nArea += (*iStart)->m_nArea;
       if(nSpace < nArea)
-	return(false);
+	return(prune());
     }
   }
   return(true);
@@ -202,7 +235,9 @@ bool WastedBins::canFitm(RectPtrArray::const_iterator iStart,
 
 bool WastedBins::canFit(const ComponentPtrs& vComponents,
 			const std::vector<bool>& vPlaced) const {
+  PROBE(PROBE_WASTEDSPACE);
   if(m_bEnabled) {
+    ++m_nTests;
     Int nArea(0), nSpace(0), j(size() - 1);
     for(ComponentPtrs::const_iterator i = vComponents.begin();
 	i != vComponents.end(); ++i) {
@@ -211,7 +246,7 @@ bool WastedBins::canFit(const ComponentPtrs& vComponents,
       for(; j >= (Int) (*i)->m_Dims.m_nMinDim; --j)
 	nSpace += operator[](j);
       if(nSpace < nArea)
-	return(false);
+	return(prune());
     }
   }
   return(true);
@@ -220,12 +255,14 @@ bool WastedBins::canFit(const ComponentPtrs& vComponents,
 bool WastedBins::canFitKorf(RectPtrArray::const_iterator iStart,
 			    const RectPtrArray::const_iterator& iEnd,
 			    Int nMaxWaste) const {
+  PROBE(PROBE_WASTEDSPACE);
   if(!m_bEnabled) return(true);
+  ++m_nTests;
   Int carryover(0);
   Int waste(0);
   Int diff(0);
 
-  if(iStart == iEnd) return(false);
+  if(iStart == iEnd) return(prune());
   RectPtrArray::const_iterator i = iEnd - 1;
 
   /**
@@ -272,11 +309,13 @@ bool WastedBins::canFitKorf(RectPtrArray::const_iterator iStart,
       carryover = 0;
     }
   };
-  return(waste <= nMaxWaste);
+  return(waste <= nMaxWaste || prune());
 }
 
 bool WastedBins::canFitKorf(Int n, Int nMaxWaste) const {
+  PROBE(PROBE_WASTEDSPACE);
   if(!m_bEnabled) return(true);
+  ++m_nTests;
   Int square;                           /* size of next square to try to place */
   Int carryover;            /* total area of smaller strips available to place */
   Int waste;                                    /* total amount of wasted area */
@@ -297,7 +336,7 @@ bool WastedBins::canFitKorf(Int n, Int nMaxWaste) const {
 	carryover += area - operator[](square);}  /* excess can offset further waste */
 
   if(waste > nMaxWaste) {
-    return(false);               /* too much wasted space */
+    return(prune());               /* too much wasted space */
   }
   else {
     return(true);  
@@ -311,12 +350,14 @@ void WastedBins::print() const {
 }
 
 bool WastedBins::canFit() const {
+  PROBE(PROBE_WASTEDSPACE);
   if(m_bEnabled) {
+    ++m_nTests;
     Int nSum(0);
     for(const_reverse_iterator i = rbegin(); i != rend(); ++i)
       if((nSum += *i) < 0) {
 	//std::cout << "pruned at " << rend() - i - 1 << std::endl;
-	return(false);
+	return(prune());
       }
   }
   return(true);
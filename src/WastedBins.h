@@ -110,6 +110,39 @@ class WastedBins : public std::vector<Int> {
   bool canFit() const;
   void print() const;
 
+  /**
+   * In-place updates with snapshots. mark() pushes a copy of the
+   * histogram onto a stack, and undo() pops the most recent copy back
+   * once the placements made since then have been taken back, instead
+   * of the caller keeping a separate histogram per placement. The
+   * histograms are short (one bin per strip length) while a placement
+   * updates one bin per cell it covers, so copying the whole histogram
+   * is cheaper than recording each update.
+   */
+
+  void increment(UInt n) {
+    ++operator[](n);
+  }
+
+  void decrement(UInt n) {
+    --operator[](n);
+  }
+
+  void mark() {
+    m_vTrail.insert(m_vTrail.end(), begin(), end());
+  }
+
+  void undo();
+  void clearTrail();
+
+  /**
+   * The number of times one of the canFit functions ran with the
+   * heuristic enabled, and how many of those runs pruned.
+   */
+
+  mutable UInt m_nTests;
+  mutable UInt m_nPrunes;
+
   /**
    * This flag can be made false to disable the entire class.
    */
@@ -117,6 +150,18 @@ class WastedBins : public std::vector<Int> {
   bool m_bEnabled;
   void enable() { m_bEnabled = true; };
   void disable() { m_bEnabled = false; };
+
+ private:
+  bool prune() const {
+    ++m_nPrunes;
+    return(false);
+  }
+
+  /**
+   * The histograms saved by mark(), one after another.
+   */
+
+  std::vector<Int> m_vTrail;
 };
 
 #endif // WASTEDBINS_H
@@ -144,6 +144,7 @@ int main(int argc, char** argv) {
     m.m_pBoxes->m_Total.accumulate(pLog->m_vNodes);
     m.m_pBoxes->m_pPacker->m_nCuSP += (size_t) pLog->m_nCuSP;
     nAttempts += (size_t) pLog->m_nBoxes;
+    m.m_pBoxes->m_nRecalled += (UInt) pLog->m_nRecalled;
     sSolutions = pLog->m_sSolutions + " " + sSolutions;
     boost::trim(sSolutions);
   }
@@ -174,7 +175,29 @@ int main(int argc, char** argv) {
 #ifndef IJCAI
     std::cout << "       Nodes/Second : " << (unsigned long long) (m.m_pBoxes->m_Total.total() / m.m_pBoxes->m_TotalTime.toDouble()) << std::endl;
     std::cout << "     CuSP Solutions : " << m.m_pBoxes->m_pPacker->m_nCuSP << std::endl;
+    UInt nYTests(0), nYPrunes(0), nXTests(0), nXPrunes(0);
+    for(std::deque<Packer*>::const_iterator i = m.m_vPackers.begin();
+	i != m.m_vPackers.end(); ++i)
+      (*i)->wastedSpace(nYTests, nYPrunes, nXTests, nXPrunes);
+    std::cout << " Wasted Space Y / X : "
+	      << nYPrunes << '/' << nYTests << " / "
+	      << nXPrunes << '/' << nXTests << " pruned" << std::endl;
     std::cout << "       Boxes Tested : " << nAttempts << std::endl;
+    if(!m.m_Params.m_vPortfolio.empty()) {
+      std::vector<UInt> vWins;
+      for(std::deque<Packer*>::const_iterator i = m.m_vPackers.begin();
+	  i != m.m_vPackers.end(); ++i)
+	(*i)->wins(vWins);
+      vWins.resize(6, 0);
+      std::cout << "     Portfolio Wins :";
+      for(std::vector<int>::const_iterator i = m.m_Params.m_vPortfolio.begin();
+	  i != m.m_Params.m_vPortfolio.end(); ++i)
+	std::cout << " w" << *i << "=" << vWins[*i];
+      std::cout << std::endl;
+    }
+    if(!m.m_Params.m_sBoxStore.empty())
+      std::cout << "     Boxes Recalled : " << m.m_pBoxes->m_nRecalled
+		<< std::endl;
     std::cout << "  Optimal Solutions : " << sSolutions << std::endl;
 #endif // IJCAI
   }